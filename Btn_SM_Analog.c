@@ -0,0 +1,180 @@
+/******************************************************************************
+* File       : Btn_SM_Analog.c
+* Function   : Analog (Hall-effect) key channels with actuation point and rapid
+*              trigger.
+* description: Please refer to Btn_SM_Analog.h for details.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#include "common.h"
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Analog.h"
+
+#ifdef __BTN_SM_ANALOG
+
+/* Select A if the bit is 1, else B, without branch */
+#define BTN_ANA_SEL(u16Bit, u16A, u16B)  ((uint16)(((u16A) & (uint16)(0 - (u16Bit))) | ((u16B) & (uint16)((u16Bit) - 1))))
+
+/* All per-key arrays are uint16, so one SIMD lane is one key in every array */
+static uint16 sg_au16AnaAct[MAX_BTN_ANA_KEY];     /* Travel to actuate                   */
+static uint16 sg_au16AnaRel[MAX_BTN_ANA_KEY];     /* Travel to release                   */
+static uint16 sg_au16AnaRt[MAX_BTN_ANA_KEY];      /* Distance of rapid trigger           */
+static uint16 sg_au16AnaExt[MAX_BTN_ANA_KEY];     /* Deepest (actuated) or highest travel */
+static uint16 sg_au16AnaDown[MAX_BTN_ANA_KEY];    /* 1: Key is actuated                  */
+static uint16 sg_au16AnaZone[MAX_BTN_ANA_KEY];    /* 1: Rapid trigger is active          */
+static uint16 sg_au16AnaChg[MAX_BTN_ANA_KEY];     /* 1: Key changed in the last frame    */
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Key_Set(uint8 u8Key, uint16 u16ActPt, uint16 u16RelPt,
+*                                    uint16 u16RtDist)
+* Function   : Set the points of one analog key
+* Input      : uint8  u8Key       1~MAX_BTN_ANA_KEY   The number of key
+*              uint16 u16ActPt    1~65535             Travel to actuate
+*              uint16 u16RelPt    0~65534             Travel to release
+*              uint16 u16RtDist   0~65535             Distance of rapid trigger
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The points are set
+* description: The key is released.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Key_Set(uint8 u8Key, uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist)
+{
+    /* Check if the input parameter is invalid */
+    if((0 == u8Key) || (u8Key > MAX_BTN_ANA_KEY) || (u16RelPt >= u16ActPt))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    sg_au16AnaAct[u8Key - 1]  = u16ActPt;
+    sg_au16AnaRel[u8Key - 1]  = u16RelPt;
+    sg_au16AnaRt[u8Key - 1]   = u16RtDist;
+    sg_au16AnaExt[u8Key - 1]  = 0;
+    sg_au16AnaDown[u8Key - 1] = 0;
+    sg_au16AnaZone[u8Key - 1] = 0;
+    sg_au16AnaChg[u8Key - 1]  = 0;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Init(uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist)
+* Function   : Init all analog keys with the same points
+* Input      : uint16 u16ActPt    1~65535   Travel to actuate
+*              uint16 u16RelPt    0~65534   Travel to release, less than u16ActPt
+*              uint16 u16RtDist   0~65535   Distance of rapid trigger, 0: disabled
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All keys are released.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Init(uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist)
+{
+    uint16 u16Key;
+
+    for(u16Key = 1; u16Key <= MAX_BTN_ANA_KEY; u16Key++)
+    {
+        if(SUCCESS != Btn_Ana_Key_Set((uint8)u16Key, u16ActPt, u16RelPt, u16RtDist))
+        {   /* Return error */
+            return BTN_ERROR;
+        }
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Process(const uint16 *pu16Travel, T_BTN_RESULT *ptBtnRes)
+* Function   : Process one frame of travel samples of all analog keys
+* Input      : const uint16 *pu16Travel   MAX_BTN_ANA_KEY travel samples, item N-1
+*                                         is key N
+* Output:    : T_BTN_RESULT *ptBtnRes     MAX_BTN_ANA_KEY results, please refer to
+*                                         Btn_Channel_Process()
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The frame is processed
+* description: The first loop has no branch and no function call, please keep it
+*              so, or the compiler can NOT vectorize it.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Process(const uint16 *pu16Travel, T_BTN_RESULT *ptBtnRes)
+{
+    uint16 u16Idx;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == pu16Travel) || (NULL == ptBtnRes))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    /* Thresholds of all keys */
+    for(u16Idx = 0; u16Idx < MAX_BTN_ANA_KEY; u16Idx++)
+    {
+        uint16 u16Tv   = pu16Travel[u16Idx];
+        uint16 u16Ext  = sg_au16AnaExt[u16Idx];
+        uint16 u16Down = sg_au16AnaDown[u16Idx];
+        uint16 u16Zone = sg_au16AnaZone[u16Idx];
+        uint16 u16Rt   = sg_au16AnaRt[u16Idx];
+        uint16 u16Max  = (u16Tv > u16Ext) ? u16Tv : u16Ext;
+        uint16 u16Min  = (u16Tv < u16Ext) ? u16Tv : u16Ext;
+        uint16 u16Act  = (uint16)((u16Tv >= sg_au16AnaAct[u16Idx]) | (u16Zone & ((uint16)(u16Max - u16Ext) >= u16Rt)));
+        uint16 u16Rel  = (uint16)((u16Tv <= sg_au16AnaRel[u16Idx]) | (u16Zone & ((uint16)(u16Ext - u16Min) >= u16Rt)));
+        uint16 u16New  = (uint16)((u16Down & (u16Rel ^ 1)) | ((u16Down ^ 1) & u16Act));
+        uint16 u16Chg  = (uint16)(u16New ^ u16Down);
+
+        /* Restart the extreme on change, or follow the travel */
+        sg_au16AnaExt[u16Idx]  = BTN_ANA_SEL(u16Chg, u16Tv, BTN_ANA_SEL(u16New, u16Max, u16Min));
+        /* Rapid trigger starts on actuation and ends at the release point */
+        sg_au16AnaZone[u16Idx] = (uint16)((u16Chg & u16New & (0 != u16Rt))
+                                        | ((u16Chg ^ 1) & u16New & u16Zone)
+                                        | ((u16New ^ 1) & u16Zone & (u16Tv > sg_au16AnaRel[u16Idx])));
+        sg_au16AnaDown[u16Idx] = u16New;
+        sg_au16AnaChg[u16Idx]  = u16Chg;
+    }
+
+    /* Results in the way of digital channels */
+    for(u16Idx = 0; u16Idx < MAX_BTN_ANA_KEY; u16Idx++)
+    {
+        ptBtnRes[u16Idx].u8State = (uint8)BTN_ANA_SEL(sg_au16AnaDown[u16Idx], BTN_PRESS_AFT_ST, BTN_IDLE_ST);
+        ptBtnRes[u16Idx].u8Evt   = (uint8)BTN_ANA_SEL(sg_au16AnaChg[u16Idx],
+                                          BTN_ANA_SEL(sg_au16AnaDown[u16Idx], BTN_PRESSED_EVT, BTN_S_RELEASED_EVT),
+                                          BTN_NONE_EVT);
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the actuation of one analog key (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_ANA_KEY   The number of key
+* Output:    : None
+* Return     : BTN_STATE_0      Key is released
+*              BTN_STATE_1      Key is actuated
+*              BTN_ERROR        Key number is invalid
+* description: The state after the last Btn_Ana_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Btn_St_Get(uint8 u8Ch)
+{
+    /* Check if the key number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_ANA_KEY))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    return sg_au16AnaDown[u8Ch - 1] ? BTN_STATE_1 : BTN_STATE_0;
+}
+
+#endif
+
+/* end-of-file */
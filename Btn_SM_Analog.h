@@ -0,0 +1,118 @@
+/******************************************************************************
+* File       : Btn_SM_Analog.h
+* Function   : Analog (Hall-effect) key channels with actuation point and rapid
+*              trigger.
+* description: Each key reports its travel (0 = rest, larger = deeper) instead of
+*              0/1. A frame of travel samples of all keys is processed at once:
+*                  * The key is actuated when the travel reaches u16ActPt and
+*                    released when it is back to u16RelPt (u16RelPt < u16ActPt,
+*                    the hysteresis between them filters the noise).
+*                  * Rapid trigger (u16RtDist != 0): after the first actuation, the
+*                    key is released as soon as it moves up u16RtDist from its
+*                    deepest travel, and actuated again as soon as it moves down
+*                    u16RtDist from its highest travel, at any depth. Rapid trigger
+*                    ends when the key is back to u16RelPt.
+*              The results are the same as Btn_Scan_Process() of digital channels:
+*              BTN_PRESSED_EVT on actuation and BTN_S_RELEASED_EVT on release, with
+*              state BTN_PRESS_AFT_ST or BTN_IDLE_ST.
+*              For long-press, use Btn_Ana_Btn_St_Get() as PF_GET_BTN of the
+*              button state machine (normal state BTN_STATE_0).
+*
+*              The thresholds of all keys are compared in one branch-free loop over
+*              arrays of the same width, so the compiler can use SIMD instructions
+*              (e.g. -O3 on GCC); the results are filled in a second loop.
+*
+*              HOW TO USE:
+*              Step 1: Call "Btn_Ana_Init()" with the points of all keys, and
+*                      "Btn_Ana_Key_Set()" for keys with other points.
+*              Step 2: For each frame of travel samples, call "Btn_Ana_Process()".
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#ifndef _BTN_SM_ANALOG_
+#define _BTN_SM_ANALOG_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __BTN_SM_ANALOG
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Init(uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist)
+* Function   : Init all analog keys with the same points
+* Input      : uint16 u16ActPt    1~65535   Travel to actuate
+*              uint16 u16RelPt    0~65534   Travel to release, less than u16ActPt
+*              uint16 u16RtDist   0~65535   Distance of rapid trigger, 0: disabled
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All keys are released.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Init(uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist);
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Key_Set(uint8 u8Key, uint16 u16ActPt, uint16 u16RelPt,
+*                                    uint16 u16RtDist)
+* Function   : Set the points of one analog key
+* Input      : uint8  u8Key       1~MAX_BTN_ANA_KEY   The number of key
+*              uint16 u16ActPt    1~65535             Travel to actuate
+*              uint16 u16RelPt    0~65534             Travel to release
+*              uint16 u16RtDist   0~65535             Distance of rapid trigger
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The points are set
+* description: The key is released.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Key_Set(uint8 u8Key, uint16 u16ActPt, uint16 u16RelPt, uint16 u16RtDist);
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Process(const uint16 *pu16Travel, T_BTN_RESULT *ptBtnRes)
+* Function   : Process one frame of travel samples of all analog keys
+* Input      : const uint16 *pu16Travel   MAX_BTN_ANA_KEY travel samples, item N-1
+*                                         is key N
+* Output:    : T_BTN_RESULT *ptBtnRes     MAX_BTN_ANA_KEY results, please refer to
+*                                         Btn_Channel_Process()
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The frame is processed
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Process(const uint16 *pu16Travel, T_BTN_RESULT *ptBtnRes);
+
+/******************************************************************************
+* Name       : uint8 Btn_Ana_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the actuation of one analog key (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_ANA_KEY   The number of key
+* Output:    : None
+* Return     : BTN_STATE_0      Key is released
+*              BTN_STATE_1      Key is actuated
+*              BTN_ERROR        Key number is invalid
+* description: The state after the last Btn_Ana_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Ana_Btn_St_Get(uint8 u8Ch);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_ANALOG_ */
+
+/* end-of-file */
@@ -0,0 +1,1364 @@
+/******************************************************************************
+* File       : Btn_SM_Bench.c
+* Function   : Benchmark and profiling harness of button state machine module.
+* description: Runs each engine variant over a set of stimulus scenarios on the
+*              virtual clock of Btn_SM_Replay.c and reports per channel cost.
+*
+*              Hardware counters are read with perf_event_open() (cycles,
+*              instructions, branches, branch misses, L1D read misses). If they are
+*              NOT available (no PMU, container, perf_event_paranoid), the cycles
+*              are read from the time stamp counter (rdtsc on x86, cntvct_el0 on
+*              ARM64) and the other columns are shown as "-".
+*
+*              The calls of the time source ("pfGetTm()") are counted and reported
+*              per scan in column "tm/scan".
+*
+*              The stimulus of each tick is generated outside the measured engine
+*              call, and the cost of an empty scan loop is subtracted, so the
+*              numbers are the cost of the engine only.
+*
+*              In "wcet" mode each scan is timed separately over adversarial stimulus
+*              and max, p99.9 and mean scan time are reported. With hardware counters
+*              the instructions of each scan are counted too: if they are NOT the same
+*              for every scan, the engine has a data-dependent path and is flagged.
+*
+*              In "pulse" mode all channels are pulse counters (__BTN_SM_PULSE_CNT)
+*              fed with square waves; the counted edges are checked against the
+*              stimulus and the aggregate edge rate per second of CPU time is reported.
+*
+*              In "mix" mode the profile is run with channel modes mixed (normal, pulse
+*              and toggle, whichever are enabled, in turn by channel number), to
+*              compare with the profile of normal channels only.
+*
+*              In "sleep" mode (__BTN_SM_SLEEP) the scan is stopped whenever all
+*              channels are idle and only the wake check runs; the ticks in sleep
+*              and the delay from each press to BTN_PRESSED_EVT are reported. The
+*              delay must be the debounce time plus one scan (the event is output by
+*              the scan after the debounce), one scan less than without sleep.
+*
+*              In "vel" mode (__BTN_SM_VELOCITY) all dual-contact keys are struck at
+*              10 kHz sampling, with bounce on each edge, through both the block and
+*              the queue input of Btn_SM_Velocity.c. The note events must be at the
+*              exact sample of the stimulus edges; the time per sample is reported
+*              against the budget of 100us.
+*
+*              In "ana" mode (__BTN_SM_ANALOG) all analog keys travel with random
+*              steps and rapid trigger; the time of Btn_Ana_Process() per frame and
+*              per key is reported.
+*
+*              In "touch" mode (__BTN_SM_TOUCH) simulated count traces of all pads
+*              (noise, slow drift, short and long touches) run through the touch
+*              filters and the scan; the presses and long-presses of each touch
+*              which ends within the ticks are checked against the touch (the run
+*              fails on a mismatch), and the filter time per scan is reported.
+*
+*              Usage: Btn_SM_Bench [ticks]          Profile all engines
+*                     Btn_SM_Bench mix [ticks]      Profile all engines, mixed modes
+*                     Btn_SM_Bench wcet [ticks]     Worst-case scan time of all engines
+*                     Btn_SM_Bench pulse [ticks]    Edge rate of pulse counter mode
+*                     Btn_SM_Bench sleep [ticks]    Sleep and wake-on-press
+*                     Btn_SM_Bench vel [samples]    Velocity of dual-contact keys
+*                     Btn_SM_Bench ana [frames]     Analog keys with rapid trigger
+*                     Btn_SM_Bench touch [ticks]    Capacitive touch pads
+*
+*              Build: cc -O2 -DMAX_BTN_CH=64 -D__BTN_SM_SOA -D__BTN_SM_GROUP
+*                        -D__BTN_SM_PULSE_CNT -D__BTN_SM_TOGGLE -I<path of common.h>
+*                        -D__BTN_SM_SLEEP -D__BTN_SM_VELOCITY -D__BTN_SM_ANALOG -D__BTN_SM_TOUCH
+*                        -o Btn_SM_Bench Btn_SM_Bench.c Btn_SM_Module.c Btn_SM_Replay.c
+*                        Btn_SM_Velocity.c Btn_SM_Analog.c Btn_SM_Touch.c
+*                     (-O3 -msse4.2 to vectorize Btn_SM_Analog.c and Btn_SM_Touch.c)
+*                     For the "ct" engine, build again with -D__BTN_SM_CONST_TIME and
+*                     without -D__BTN_SM_PULSE_CNT -D__BTN_SM_TOGGLE (it runs normal
+*                     channels only), e.g. to compare it in "wcet" mode.
+*                     Build with several MAX_BTN_CH to compare channel counts.
+*                     (On host "common.h" must provide NULL, e.g. include <stddef.h>.)
+*              Unknown modes, modes NOT built in and a count of 0 are rejected with
+*              the usage.
+*
+*              NOTE: This file is for host (Linux) environment only.
+* Version    : V1.14
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Add constant-time engine and WCET mode
+*               3    18/Oct/2026   Ian   V1.02     Add pulse counter mode
+*               4    18/Oct/2026   Ian   V1.03     Add structure-of-arrays engine
+*               5    18/Oct/2026   Ian   V1.04     Add grouped engine and mixed modes
+*               6    18/Oct/2026   Ian   V1.05     Report time-source calls per scan
+*               7    18/Oct/2026   Ian   V1.06     Add sleep mode
+*               8    18/Oct/2026   Ian   V1.07     Add velocity mode
+*               9    18/Oct/2026   Ian   V1.08     Add analog key mode
+*               10   18/Oct/2026   Ian   V1.09     Add touch pad mode
+*               11   18/Oct/2026   Ian   V1.10     Reject unknown modes and invalid counts
+*               12   18/Oct/2026   Ian   V1.11     Check the events of each touch
+*               13   18/Oct/2026   Ian   V1.12     Build the constant-time engine separately
+*               14   18/Oct/2026   Ian   V1.13     Set the channel mode only when it is a member
+*               15   18/Oct/2026   Ian   V1.14     Give the pins to the sleep functions
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Replay.h"
+#include "Btn_SM_Velocity.h"
+#include "Btn_SM_Analog.h"
+#include "Btn_SM_Touch.h"
+
+#define BENCH_TICKS                  (200000)    /* Default number of ticks of each run */
+#define BENCH_WCET_PERMILLE          (999)       /* Percentile of WCET report (p99.9)   */
+#define BENCH_PULSE_HALF             (6)         /* Min half period of pulse stimulus   */
+#define BENCH_PULSE_WIN              (1000)      /* Measure window of pulse counters    */
+#define BENCH_SLEEP_PERIOD           (1000)      /* One press per period in sleep mode  */
+#define BENCH_SLEEP_PRESS            (300)       /* Length of the press in sleep mode   */
+#define BENCH_VEL_SAMPLES            (1000000)   /* Default samples in velocity mode    */
+#define BENCH_VEL_BLOCK              (100)       /* Samples per block (10ms at 10kHz)   */
+#define BENCH_VEL_LOCK               (5)         /* Lock time of bounce (0.5ms)         */
+#define BENCH_VEL_OFF                (600)       /* Contact 1 opens (release)           */
+#define BENCH_VEL_C2_OFF             (500)       /* Contact 2 opens                     */
+#define BENCH_ANA_FRAMES             (1000000)   /* Default frames in analog mode       */
+#define BENCH_ANA_FULL               (4000)      /* Full travel of analog keys          */
+#define BENCH_TOUCH_START            (1000)      /* Touch starts in the period          */
+#define BENCH_TOUCH_SHORT            (300)       /* Length of short touches             */
+#define BENCH_TOUCH_LONG             (1800)      /* Length of long touches              */
+#define BENCH_TOUCH_DELTA            (180)       /* Count delta of a touch              */
+
+#define BENCH_CNT_CYCLE              (0)         /* Counter: CPU cycles                 */
+#define BENCH_CNT_INSTR              (1)         /* Counter: instructions               */
+#define BENCH_CNT_BRANCH             (2)         /* Counter: branch instructions        */
+#define BENCH_CNT_BR_MISS            (3)         /* Counter: branch misses              */
+#define BENCH_CNT_L1_MISS            (4)         /* Counter: L1D read misses            */
+#define BENCH_CNT_NUM                (5)         /* Number of counters                  */
+
+/* Stimulus of one tick: set the inputs at the given tick */
+typedef void (*PF_BENCH_STIM)(uint32 u32Tick);
+
+/* Engine variant: process all channels once */
+typedef void (*PF_BENCH_ENGINE)(T_BTN_RESULT *ptRes);
+
+/* Scenario of stimulus */
+typedef struct _T_BENCH_SCENARIO_
+{
+    const char     *pcName;         /* Name of the scenario   */
+    PF_BENCH_STIM   pfStim;         /* Stimulus function      */
+}T_BENCH_SCENARIO;
+
+/* Engine variant */
+typedef struct _T_BENCH_ENGINE_
+{
+    const char     *pcName;         /* Name of the variant    */
+    PF_BENCH_ENGINE pfEngine;       /* Engine function        */
+}T_BENCH_ENGINE;
+
+static int      sg_aiFd[BENCH_CNT_NUM];                   /* perf event fds, -1 if NOT used */
+static uint8    sg_u8Perf                    = 0;         /* Hardware counters available    */
+static uint32   sg_u32Seed                   = 1;         /* Seed of pseudo random numbers  */
+static T_BTN_RESULT sg_atRes[MAX_BTN_CH];                 /* Results of engine              */
+#ifdef __BTN_SM_SOA
+static T_BTN_SOA    sg_tSoa;                              /* Results of SoA engine          */
+#endif
+static T_BTN_PARA   sg_atPara[MAX_BTN_CH];                /* Parameters of channels         */
+static uint8        sg_u8Mix                     = 0;     /* Mix the channel modes          */
+static uint32       sg_u32TmCnt                  = 0;     /* Calls of the time source       */
+
+#ifdef __BTN_SM_CH_MODE
+/* Channel modes used in turn in "mix" mode */
+static const uint8 cg_au8MixMode[] =
+{
+    BTN_MODE_NORMAL,
+#ifdef __BTN_SM_PULSE_CNT
+    BTN_MODE_PULSE,
+#endif
+#ifdef __BTN_SM_TOGGLE
+    BTN_MODE_TOGGLE,
+#endif
+};
+#endif
+
+/******************************************************************************
+* Name       : static uint32 Bench_Rand(void)
+* Function   : Fast pseudo random number (xorshift32), same sequence in each run
+* Input      : None
+* Output:    : None
+* Return     : Random number
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint32 Bench_Rand(void)
+{
+    sg_u32Seed ^= sg_u32Seed << 13;
+    sg_u32Seed ^= (sg_u32Seed & 0xFFFFFFFF) >> 17;
+    sg_u32Seed ^= sg_u32Seed << 5;
+    sg_u32Seed &= 0xFFFFFFFF;
+    return sg_u32Seed;
+}
+
+/******************************************************************************
+* Name       : static uint16 Bench_Time(void)
+* Function   : Time source of the module (PF_GET_TM), counting the calls
+* Input      : None
+* Output:    : None
+* Return     : 0~65535  The virtual clock
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint16 Bench_Time(void)
+{
+    sg_u32TmCnt++;
+    return Btn_Replay_Time();
+}
+
+/************************** Scenarios of stimulus ****************************/
+/* All buttons stay released */
+static void Bench_Stim_Idle(uint32 u32Tick)
+{
+    (void)u32Tick;
+}
+
+/* All buttons are held all the time */
+static void Bench_Stim_Hold(uint32 u32Tick)
+{
+    uint8 u8Ch;
+    if(0 == u32Tick)
+    {
+        for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+        {
+            Btn_Replay_Level_Set(u8Ch, BTN_STATE_1);
+        }
+    }
+}
+
+/* Each button is pressed for 300 ticks every 1000 ticks, with 5 ticks bounce */
+static void Bench_Stim_Typing(uint32 u32Tick)
+{
+    uint8  u8Ch;
+    uint32 u32Tm;
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        u32Tm = (u32Tick + u8Ch * 37) % 1000;
+        if((u32Tm < 5) || ((u32Tm >= 300) && (u32Tm < 305)))
+        {
+            Btn_Replay_Level_Set(u8Ch, (uint8)(Bench_Rand() & 1));
+        }
+        else
+        {
+            Btn_Replay_Level_Set(u8Ch, (uint8)(u32Tm < 300));
+        }
+    }
+}
+
+/* All inputs flip on every tick, most transitions per scan */
+static void Bench_Stim_Flip(uint32 u32Tick)
+{
+    uint8 u8Ch;
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        Btn_Replay_Level_Set(u8Ch, (uint8)(u32Tick & 1));
+    }
+}
+
+/* Held until long-press, released for one debounce time, channels out of phase */
+static void Bench_Stim_Ladder(uint32 u32Tick)
+{
+    uint8 u8Ch;
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        Btn_Replay_Level_Set(u8Ch, (uint8)(((u32Tick + u8Ch * 13) % 1100) < 1052));
+    }
+}
+
+/* Random level on every tick, worst case for branch prediction */
+static void Bench_Stim_Noise(uint32 u32Tick)
+{
+    uint8  u8Ch;
+    uint32 u32Rand = 0;
+    (void)u32Tick;
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        if(0 == ((u8Ch - 1) & 31))
+        {
+            u32Rand = Bench_Rand();
+        }
+        Btn_Replay_Level_Set(u8Ch, (uint8)((u32Rand >> ((u8Ch - 1) & 31)) & 1));
+    }
+}
+
+static const T_BENCH_SCENARIO cg_atScenario[] =
+{
+    {"idle",   Bench_Stim_Idle},
+    {"hold",   Bench_Stim_Hold},
+    {"typing", Bench_Stim_Typing},
+    {"noise",  Bench_Stim_Noise}
+};
+
+static const T_BENCH_SCENARIO cg_atWcetScenario[] =
+{
+    {"flip",   Bench_Stim_Flip},
+    {"ladder", Bench_Stim_Ladder},
+    {"noise",  Bench_Stim_Noise}
+};
+
+/****************************** Engine variants ******************************/
+/* No engine, measures the cost of the harness itself */
+static void Bench_Engine_None(T_BTN_RESULT *ptRes)
+{
+    (void)ptRes;
+}
+
+/* Per channel process, same as the demo loop of V1.10 */
+static void Bench_Engine_Channel(T_BTN_RESULT *ptRes)
+{
+    uint8 u8Ch;
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        Btn_Channel_Process(u8Ch, &(ptRes[u8Ch - 1]));
+    }
+}
+
+/* Whole scan process */
+static void Bench_Engine_Scan(T_BTN_RESULT *ptRes)
+{
+    Btn_Scan_Process(ptRes);
+}
+
+#ifdef __BTN_SM_CONST_TIME
+/* Constant-time scan process */
+static void Bench_Engine_Ct(T_BTN_RESULT *ptRes)
+{
+    Btn_Scan_Process_CT(ptRes);
+}
+#endif
+
+#ifdef __BTN_SM_SOA
+/* Structure-of-arrays scan process, results in sg_tSoa */
+static void Bench_Engine_Soa(T_BTN_RESULT *ptRes)
+{
+    (void)ptRes;
+    Btn_Scan_Process_SoA(&sg_tSoa);
+}
+#endif
+
+#ifdef __BTN_SM_GROUP
+/* Scan process grouped by channel mode */
+static void Bench_Engine_Grp(T_BTN_RESULT *ptRes)
+{
+    Btn_Scan_Process_Grp(ptRes);
+}
+#endif
+
+static const T_BENCH_ENGINE cg_atEngine[] =
+{
+    {"channel", Bench_Engine_Channel},
+    {"scan",    Bench_Engine_Scan},
+#ifdef __BTN_SM_CONST_TIME
+    {"ct",      Bench_Engine_Ct},
+#endif
+#ifdef __BTN_SM_SOA
+    {"soa",     Bench_Engine_Soa},
+#endif
+#ifdef __BTN_SM_GROUP
+    {"group",   Bench_Engine_Grp},
+#endif
+};
+
+/********************************* Counters **********************************/
+/******************************************************************************
+* Name       : static uint64_t Bench_Tsc(void)
+* Function   : Read the time stamp counter
+* Input      : None
+* Output:    : None
+* Return     : Counter value
+* description: rdtsc on x86, cntvct_el0 on ARM64, ns of monotonic clock otherwise.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint64_t Bench_Tsc(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint32_t u32Lo, u32Hi;
+    __asm__ __volatile__("rdtsc" : "=a"(u32Lo), "=d"(u32Hi));
+    return ((uint64_t)u32Hi << 32) | u32Lo;
+#elif defined(__aarch64__)
+    uint64_t u64Val;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(u64Val));
+    return u64Val;
+#else
+    struct timespec tTs;
+    clock_gettime(CLOCK_MONOTONIC, &tTs);
+    return (uint64_t)tTs.tv_sec * 1000000000ull + (uint64_t)tTs.tv_nsec;
+#endif
+}
+
+/******************************************************************************
+* Name       : static void Bench_Perf_Open(void)
+* Function   : Open the hardware counters as one group
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: sg_u8Perf is set if all counters are opened.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Perf_Open(void)
+{
+    static const uint32_t s_au32Type[BENCH_CNT_NUM] =
+        {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+    static const uint64_t s_au64Cfg[BENCH_CNT_NUM] =
+        {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+         PERF_COUNT_HW_BRANCH_MISSES,
+         PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    struct perf_event_attr tAttr;
+    uint8 u8Idx;
+
+    sg_u8Perf = 1;
+    for(u8Idx = 0; u8Idx < BENCH_CNT_NUM; u8Idx++)
+    {
+        memset(&tAttr, 0, sizeof(tAttr));
+        tAttr.size           = sizeof(tAttr);
+        tAttr.type           = s_au32Type[u8Idx];
+        tAttr.config         = s_au64Cfg[u8Idx];
+        tAttr.disabled       = (0 == u8Idx);   /* Leader starts the group */
+        tAttr.read_format    = PERF_FORMAT_GROUP;
+        tAttr.exclude_kernel = 1;
+        tAttr.exclude_hv     = 1;
+        sg_aiFd[u8Idx] = (int)syscall(SYS_perf_event_open, &tAttr, 0, -1,
+                                      (0 == u8Idx) ? -1 : sg_aiFd[0], 0);
+        if(sg_aiFd[u8Idx] < 0)
+        {
+            sg_u8Perf = 0;
+        }
+    }
+
+    if(!sg_u8Perf)
+    {   /* Fall back to the time stamp counter */
+        for(u8Idx = 0; u8Idx < BENCH_CNT_NUM; u8Idx++)
+        {
+            if(sg_aiFd[u8Idx] >= 0)
+            {
+                close(sg_aiFd[u8Idx]);
+            }
+            sg_aiFd[u8Idx] = -1;
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static void Bench_Reset(void)
+* Function   : Restart the stimulus and the module from idle state
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Reset(void)
+{
+#ifdef __BTN_SM_PULSE_CNT
+    static T_BTN_PULSE s_atPulse[MAX_BTN_CH];
+#endif
+    uint8 u8Ch;
+
+    sg_u32Seed = 1;
+#ifdef __BTN_SM_SOA
+    memset(&sg_tSoa, 0, sizeof(sg_tSoa));
+#endif
+    Btn_Replay_Init(NULL, 0);
+    Btn_General_Init(Bench_Time, Btn_Replay_Btn_St_Get);
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {   /* Same parameters as Btn_SM_Easy_Init(), start from idle state */
+        sg_atPara[u8Ch - 1].u8Ch           = u8Ch;
+        sg_atPara[u8Ch - 1].u16DebounceTm  = 50;
+        sg_atPara[u8Ch - 1].u16LongPressTm = 1000;
+        sg_atPara[u8Ch - 1].u8NormalSt     = 0;
+        sg_atPara[u8Ch - 1].u8BtnEn        = BTN_FUNC_ENABLE;
+#ifdef __BTN_SM_CH_MODE
+        sg_atPara[u8Ch - 1].u8Mode         = sg_u8Mix ? cg_au8MixMode[u8Ch % sizeof(cg_au8MixMode)] : BTN_MODE_NORMAL;
+#endif
+        Btn_Channel_Init(u8Ch, &sg_atPara[u8Ch - 1]);
+#ifdef __BTN_SM_PULSE_CNT
+        s_atPulse[u8Ch - 1].u16WinTm = 1000;
+        Btn_Pulse_Init(u8Ch, &s_atPulse[u8Ch - 1]);
+#endif
+    }
+#ifdef __BTN_SM_GROUP
+    Btn_Group_Build();
+#endif
+    sg_u32TmCnt = 0;
+}
+
+/******************************************************************************
+* Name       : static void Bench_Run(PF_BENCH_STIM pfStim, PF_BENCH_ENGINE pfEngine,
+*                                    uint32 u32Ticks, uint64_t *pu64Cnt)
+* Function   : Run one engine over one scenario and read the counters
+* Input      : PF_BENCH_STIM   pfStim     Stimulus function
+*              PF_BENCH_ENGINE pfEngine   Engine function
+*              uint32          u32Ticks   Number of ticks
+* Output:    : uint64_t       *pu64Cnt    Counter values, BENCH_CNT_NUM items
+* Return     : None
+* description: The module is re-initialized, so each run starts from idle state.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Run(PF_BENCH_STIM pfStim, PF_BENCH_ENGINE pfEngine, uint32 u32Ticks, uint64_t *pu64Cnt)
+{
+    uint64_t au64Val[1 + BENCH_CNT_NUM];
+    uint64_t u64Tsc = 0;
+    uint32   u32Tick;
+
+    Bench_Reset();
+
+    if(sg_u8Perf)
+    {
+        ioctl(sg_aiFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    }
+
+    for(u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        /* Stimulus is NOT measured */
+        Btn_Replay_Step(u32Tick);
+        pfStim(u32Tick);
+
+        if(sg_u8Perf)
+        {
+            ioctl(sg_aiFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            pfEngine(sg_atRes);
+            ioctl(sg_aiFd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+        else
+        {
+            uint64_t u64Start = Bench_Tsc();
+            pfEngine(sg_atRes);
+            u64Tsc += Bench_Tsc() - u64Start;
+        }
+    }
+
+    memset(pu64Cnt, 0, BENCH_CNT_NUM * sizeof(uint64_t));
+    if(sg_u8Perf)
+    {   /* Group read format: number of counters, then the values */
+        if(read(sg_aiFd[0], au64Val, sizeof(au64Val)) == (ssize_t)sizeof(au64Val))
+        {
+            memcpy(pu64Cnt, &au64Val[1], BENCH_CNT_NUM * sizeof(uint64_t));
+        }
+    }
+    else
+    {
+        pu64Cnt[BENCH_CNT_CYCLE] = u64Tsc;
+    }
+}
+
+/******************************************************************************
+* Name       : static void Bench_Profile(uint32 u32Ticks)
+* Function   : Run all scenarios with all engine variants and print the report
+* Input      : uint32 u32Ticks   Number of ticks of each run
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Profile(uint32 u32Ticks)
+{
+    uint64_t au64Base[BENCH_CNT_NUM], au64Cnt[BENCH_CNT_NUM];
+    double   dChScan, dCyc, dInstr;
+    uint8    u8Sc, u8En, u8Idx;
+    uint64_t u64Diff[BENCH_CNT_NUM];
+
+    printf("Channels: %u, ticks: %lu, counters: %s\n", MAX_BTN_CH, (unsigned long)u32Ticks,
+           sg_u8Perf ? "perf_event" : "time stamp counter only, cyc are TSC ticks");
+    printf("%-8s %-10s %10s %8s %6s %9s %9s %9s\n", "scenario", "engine", "cyc/ch", "tm/scan", "IPC", "br/ch", "brmiss%", "L1miss/ch");
+
+    dChScan = (double)u32Ticks * MAX_BTN_CH;
+    for(u8Sc = 0; u8Sc < sizeof(cg_atScenario) / sizeof(cg_atScenario[0]); u8Sc++)
+    {
+        /* Cost of the harness without engine */
+        Bench_Run(cg_atScenario[u8Sc].pfStim, Bench_Engine_None, u32Ticks, au64Base);
+
+        for(u8En = 0; u8En < sizeof(cg_atEngine) / sizeof(cg_atEngine[0]); u8En++)
+        {
+            Bench_Run(cg_atScenario[u8Sc].pfStim, cg_atEngine[u8En].pfEngine, u32Ticks, au64Cnt);
+            for(u8Idx = 0; u8Idx < BENCH_CNT_NUM; u8Idx++)
+            {
+                u64Diff[u8Idx] = (au64Cnt[u8Idx] > au64Base[u8Idx]) ? (au64Cnt[u8Idx] - au64Base[u8Idx]) : 0;
+            }
+
+            dCyc = (double)u64Diff[BENCH_CNT_CYCLE];
+            printf("%-8s %-10s %10.2f %8.2f", cg_atScenario[u8Sc].pcName, cg_atEngine[u8En].pcName, dCyc / dChScan,
+                   (double)sg_u32TmCnt / (double)u32Ticks);
+            if(sg_u8Perf)
+            {
+                dInstr = (double)u64Diff[BENCH_CNT_INSTR];
+                printf(" %6.2f %9.2f %9.3f %9.4f\n",
+                       (dCyc > 0) ? (dInstr / dCyc) : 0.0,
+                       (double)u64Diff[BENCH_CNT_BRANCH] / dChScan,
+                       u64Diff[BENCH_CNT_BRANCH] ? (100.0 * (double)u64Diff[BENCH_CNT_BR_MISS] / (double)u64Diff[BENCH_CNT_BRANCH]) : 0.0,
+                       (double)u64Diff[BENCH_CNT_L1_MISS] / dChScan);
+            }
+            else
+            {
+                printf(" %6s %9s %9s %9s\n", "-", "-", "-", "-");
+            }
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static int Bench_Cmp(const void *pvA, const void *pvB)
+* Function   : Compare two scan times for qsort()
+* Input      : const void *pvA, *pvB    Scan times
+* Output:    : None
+* Return     : <0, 0, >0
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static int Bench_Cmp(const void *pvA, const void *pvB)
+{
+    uint64_t u64A = *(const uint64_t*)pvA, u64B = *(const uint64_t*)pvB;
+    return (u64A > u64B) - (u64A < u64B);
+}
+
+/******************************************************************************
+* Name       : static void Bench_Wcet(uint32 u32Ticks)
+* Function   : Time each scan over adversarial stimulus and report the worst case
+* Input      : uint32 u32Ticks   Number of ticks of each run
+* Output:    : None
+* Return     : None
+* description: Times are in counter units (cycles with perf_event, otherwise time
+*              stamp counter ticks). The instructions of each scan are counted
+*              with perf_event; an engine whose count differs between scans has
+*              a data-dependent path and is flagged with "DATA-DEPENDENT".
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Wcet(uint32 u32Ticks)
+{
+    uint64_t *pu64Tm = (uint64_t*)malloc(u32Ticks * sizeof(uint64_t));
+    uint64_t  au64Val[1 + BENCH_CNT_NUM];
+    uint64_t  u64Sum, u64Start, u64InstrMin, u64InstrMax;
+    uint32    u32Tick;
+    uint8     u8Sc, u8En;
+
+    if((NULL == pu64Tm) || (0 == u32Ticks))
+    {
+        free(pu64Tm);
+        return;
+    }
+
+    printf("Channels: %u, scans: %lu, counters: %s\n", MAX_BTN_CH, (unsigned long)u32Ticks,
+           sg_u8Perf ? "perf_event" : "time stamp counter only, no path check");
+    printf("%-8s %-10s %10s %10s %10s %10s %s\n", "scenario", "engine", "max", "p99.9", "mean", "max/ch", "path");
+
+    for(u8Sc = 0; u8Sc < sizeof(cg_atWcetScenario) / sizeof(cg_atWcetScenario[0]); u8Sc++)
+    {
+        for(u8En = 0; u8En < sizeof(cg_atEngine) / sizeof(cg_atEngine[0]); u8En++)
+        {
+            Bench_Reset();
+            u64Sum      = 0;
+            u64InstrMin = ~(uint64_t)0;
+            u64InstrMax = 0;
+
+            for(u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+            {
+                Btn_Replay_Step(u32Tick);
+                cg_atWcetScenario[u8Sc].pfStim(u32Tick);
+
+                if(sg_u8Perf)
+                {   /* Count this scan only */
+                    ioctl(sg_aiFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                    ioctl(sg_aiFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    cg_atEngine[u8En].pfEngine(sg_atRes);
+                    ioctl(sg_aiFd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                    if(read(sg_aiFd[0], au64Val, sizeof(au64Val)) != (ssize_t)sizeof(au64Val))
+                    {
+                        memset(au64Val, 0, sizeof(au64Val));
+                    }
+                    pu64Tm[u32Tick] = au64Val[1 + BENCH_CNT_CYCLE];
+                    if(au64Val[1 + BENCH_CNT_INSTR] < u64InstrMin)
+                    {
+                        u64InstrMin = au64Val[1 + BENCH_CNT_INSTR];
+                    }
+                    if(au64Val[1 + BENCH_CNT_INSTR] > u64InstrMax)
+                    {
+                        u64InstrMax = au64Val[1 + BENCH_CNT_INSTR];
+                    }
+                }
+                else
+                {
+                    u64Start = Bench_Tsc();
+                    cg_atEngine[u8En].pfEngine(sg_atRes);
+                    pu64Tm[u32Tick] = Bench_Tsc() - u64Start;
+                }
+                u64Sum += pu64Tm[u32Tick];
+            }
+
+            qsort(pu64Tm, u32Ticks, sizeof(uint64_t), Bench_Cmp);
+            printf("%-8s %-10s %10lu %10lu %10.1f %10.2f %s\n",
+                   cg_atWcetScenario[u8Sc].pcName, cg_atEngine[u8En].pcName,
+                   (unsigned long)pu64Tm[u32Ticks - 1],
+                   (unsigned long)pu64Tm[((uint64_t)u32Ticks * BENCH_WCET_PERMILLE) / 1000],
+                   (double)u64Sum / u32Ticks,
+                   (double)pu64Tm[u32Ticks - 1] / MAX_BTN_CH,
+                   (!sg_u8Perf) ? "-" : ((u64InstrMin == u64InstrMax) ? "constant" : "DATA-DEPENDENT"));
+        }
+    }
+    free(pu64Tm);
+}
+
+#ifdef __BTN_SM_PULSE_CNT
+/******************************************************************************
+* Name       : static void Bench_Pulse(uint32 u32Ticks)
+* Function   : Measure the edge rate of pulse counter mode
+* Input      : uint32 u32Ticks   Number of ticks of the run
+* Output:    : None
+* Return     : None
+* description: Channel N gets a square wave with half period BENCH_PULSE_HALF + (N & 3)
+*              ticks, one scan per tick. The count of each channel must match the
+*              rising edges of its stimulus.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Pulse(uint32 u32Ticks)
+{
+    static T_BTN_PARA  s_atPara[MAX_BTN_CH];
+    static T_BTN_PULSE s_atPulse[MAX_BTN_CH];
+    static uint32      s_au32Exp[MAX_BTN_CH];
+    struct timespec    tBeg, tEnd;
+    uint32 u32Tick, u32Half, u32Edge = 0, u32Bad = 0;
+    uint8  u8Ch, u8Level;
+    double dSec;
+
+    Btn_Replay_Init(NULL, 0);
+    Btn_General_Init(Btn_Replay_Time, Btn_Replay_Btn_St_Get);
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        s_atPara[u8Ch - 1].u8Ch           = u8Ch;
+        s_atPara[u8Ch - 1].u16DebounceTm  = 1;           /* Glitch filter of one tick */
+        s_atPara[u8Ch - 1].u16LongPressTm = 0xFFFF;
+        s_atPara[u8Ch - 1].u8BtnEn        = BTN_FUNC_ENABLE;
+        s_atPara[u8Ch - 1].u8Mode         = BTN_MODE_PULSE;
+        Btn_Channel_Init(u8Ch, &s_atPara[u8Ch - 1]);
+        s_atPulse[u8Ch - 1].u16WinTm = BENCH_PULSE_WIN;
+        Btn_Pulse_Init(u8Ch, &s_atPulse[u8Ch - 1]);
+        s_au32Exp[u8Ch - 1] = 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &tBeg);
+    for(u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        Btn_Replay_Step(u32Tick);
+        for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+        {
+            u32Half = BENCH_PULSE_HALF + (u8Ch & 3);
+            u8Level = (uint8)((u32Tick / u32Half) & 1);
+            if((u32Tick > 0) && (u8Level) && (0 == (u32Tick % u32Half)))
+            {   /* Rising edge of the stimulus */
+                s_au32Exp[u8Ch - 1]++;
+            }
+            Btn_Replay_Level_Set(u8Ch, u8Level);
+        }
+        Btn_Scan_Process(sg_atRes);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &tEnd);
+    dSec = (double)(tEnd.tv_sec - tBeg.tv_sec) + (double)(tEnd.tv_nsec - tBeg.tv_nsec) / 1e9;
+
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {   /* The last edge may still be in the debounce */
+        u32Edge += s_atPulse[u8Ch - 1].u32Cnt;
+        if((s_atPulse[u8Ch - 1].u32Cnt + 1) < s_au32Exp[u8Ch - 1]
+        || (s_atPulse[u8Ch - 1].u32Cnt > s_au32Exp[u8Ch - 1]))
+        {
+            u32Bad++;
+        }
+    }
+
+    printf("channels %u, ticks %lu, edges %lu, mismatched channels %lu\n",
+           (unsigned)MAX_BTN_CH, (unsigned long)u32Ticks, (unsigned long)u32Edge, (unsigned long)u32Bad);
+    printf("ch1: freq %u per %u ticks, period %u ticks\n",
+           (unsigned)s_atPulse[0].u16Freq, (unsigned)BENCH_PULSE_WIN, (unsigned)s_atPulse[0].u16Period);
+    printf("%.0f edges/s, %.1f ns/edge (stimulus included)\n",
+           (double)u32Edge / dSec, dSec * 1e9 / (double)(u32Edge ? u32Edge : 1));
+}
+#endif
+
+#ifdef __BTN_SM_SLEEP
+/******************************************************************************
+* Name       : static void Bench_Sleep(uint32 u32Ticks)
+* Function   : Run sleep and wake-on-press under the virtual clock
+* Input      : uint32 u32Ticks   Number of ticks of the run
+* Output:    : None
+* Return     : None
+* description: One channel (in turn) is pressed at a pseudo random tick of each
+*              BENCH_SLEEP_PERIOD. While sleeping only Btn_Sleep_Check() is called
+*              on the port words; on wake the edge tick is given to Btn_Sleep_Wake().
+*              The replayed port words are in channel order, so NO pins are given.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Sleep(uint32 u32Ticks)
+{
+    uint32      au32Port[BTN_MAP_WORDS];
+    T_BTN_SLEEP tSleep;
+    uint32 u32Tick, u32Press = 0, u32Evt = 0, u32Scan = 0, u32Sleep = 0, u32Wake = 0;
+    uint32 u32PressTm = 0, u32Delay, u32DelayMax = 0, u32DelaySum = 0;
+    uint8  u8Ch = 1, u8Asleep = 0;
+
+    Bench_Reset();
+    for(u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        Btn_Replay_Step(u32Tick);
+
+        /* Stimulus: one press per period */
+        if(0 == (u32Tick % BENCH_SLEEP_PERIOD))
+        {
+            u8Ch       = (uint8)((u32Tick / BENCH_SLEEP_PERIOD) % MAX_BTN_CH + 1);
+            u32PressTm = u32Tick + Bench_Rand() % (BENCH_SLEEP_PERIOD - BENCH_SLEEP_PRESS - 100);
+        }
+        if(u32Tick == u32PressTm)
+        {
+            Btn_Replay_Level_Set(u8Ch, BTN_STATE_1);
+            u32Press++;
+        }
+        if(u32Tick == u32PressTm + BENCH_SLEEP_PRESS)
+        {
+            Btn_Replay_Level_Set(u8Ch, BTN_STATE_0);
+        }
+
+        if(u8Asleep)
+        {   /* Only the wake check */
+            Btn_Replay_Port_Get(au32Port);
+            if(0 == Btn_Sleep_Check(&tSleep, au32Port))
+            {
+                u32Sleep++;
+                continue;
+            }
+            Btn_Sleep_Wake(&tSleep, au32Port, (uint16)u32Tick);
+            u8Asleep = 0;
+            u32Wake++;
+        }
+
+        Btn_Scan_Process(sg_atRes);
+        u32Scan++;
+        if(BTN_PRESSED_EVT == sg_atRes[u8Ch - 1].u8Evt)
+        {
+            u32Evt++;
+            u32Delay     = u32Tick - u32PressTm;
+            u32DelaySum += u32Delay;
+            u32DelayMax  = (u32Delay > u32DelayMax) ? u32Delay : u32DelayMax;
+        }
+        u8Asleep = (SUCCESS == Btn_Sleep_Enter(&tSleep, NULL));
+    }
+
+    printf("ticks %lu, asleep %.1f%%, scans %lu, wakes %lu\n", (unsigned long)u32Ticks,
+           100.0 * (double)u32Sleep / (double)u32Ticks, (unsigned long)u32Scan, (unsigned long)u32Wake);
+    printf("presses %lu, pressed events %lu, delay mean %.2f max %lu ticks (debounce %u)\n",
+           (unsigned long)u32Press, (unsigned long)u32Evt, u32Evt ? (double)u32DelaySum / (double)u32Evt : 0.0,
+           (unsigned long)u32DelayMax, (unsigned)sg_atPara[0].u16DebounceTm);
+}
+#endif
+
+#ifdef __BTN_SM_VELOCITY
+static const uint32 cg_au32VelDt[]  = {10, 50, 150, 500};  /* 1ms ~ 50ms at 10kHz */
+static const uint8  cg_au8VelVel[]  = {127, 96, 40, 1};
+static uint32 sg_u32VelEvt = 0;                           /* Note events                    */
+static uint32 sg_u32VelBad = 0;                           /* Note events at a wrong sample  */
+
+/******************************************************************************
+* Name       : static uint8 Bench_Vel_Level(uint8 u8KeyIdx, uint8 u8Contact, uint32 u32Tm,
+*                                           uint32 *pu32Dt)
+* Function   : Stimulus of one contact in velocity mode
+* Input      : uint8   u8KeyIdx   Index of the key
+*              uint8   u8Contact  0: contact 1, 1: contact 2
+*              uint32  u32Tm      The sample
+* Output:    : uint32 *pu32Dt     Position in the strike (NULL if NOT needed)
+* Return     : Level of the contact
+* description: Each key is struck once per period, with a time between contacts
+*              that changes by strike. Each close edge has one bounce sample after
+*              it, which is within the lock time.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Bench_Vel_Level(uint8 u8KeyIdx, uint8 u8Contact, uint32 u32Tm, uint32 *pu32Dt)
+{
+    uint32 u32Period = 2000 + (u8KeyIdx * 37) % 1000;
+    uint32 u32Pos    = (u32Tm + u8KeyIdx * 131) % u32Period;
+    uint32 u32Dt     = 10 + (((u32Tm + u8KeyIdx * 131) / u32Period) * 7 + u8KeyIdx * 3) % 400;
+
+    if(NULL != pu32Dt)
+    {
+        pu32Dt[0] = u32Pos;
+        pu32Dt[1] = u32Dt;
+    }
+    if(0 == u8Contact)
+    {
+        return (uint8)((u32Pos < BENCH_VEL_OFF) && (1 != u32Pos));
+    }
+    return (uint8)((u32Pos >= u32Dt) && (u32Pos < BENCH_VEL_C2_OFF) && ((u32Dt + 1) != u32Pos));
+}
+
+/******************************************************************************
+* Name       : static void Bench_Vel_Evt(const T_BTN_VEL_EVT *ptEvt)
+* Function   : Check one note event against the stimulus
+* Input      : const T_BTN_VEL_EVT *ptEvt    The event
+* Output:    : None
+* Return     : None
+* description: Note-on must be at the closing of contact 2, note-off at the
+*              opening of contact 1. Keys already down at the first sample are
+*              NOT checked.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Vel_Evt(const T_BTN_VEL_EVT *ptEvt)
+{
+    uint32 au32Pos[2];
+
+    sg_u32VelEvt++;
+    (void)Bench_Vel_Level((uint8)(ptEvt->u8Key - 1), 0, ptEvt->u32Tm, au32Pos);
+    if(ptEvt->u32Tm < au32Pos[0])
+    {   /* The strike started before the first sample */
+        return;
+    }
+    if(BTN_VEL_NOTE_ON_EVT == ptEvt->u8Evt)
+    {
+        sg_u32VelBad += (au32Pos[0] != au32Pos[1]);
+    }
+    else
+    {
+        sg_u32VelBad += (au32Pos[0] != BENCH_VEL_OFF);
+    }
+}
+
+/******************************************************************************
+* Name       : static void Bench_Vel(uint32 u32Samples)
+* Function   : Run the velocity sensing of MAX_BTN_VEL_KEY keys
+* Input      : uint32 u32Samples   Number of samples (1 sample = 100us)
+* Output:    : None
+* Return     : None
+* description: The same stimulus is run through Btn_Vel_Block() and through
+*              Btn_Vel_Edge_Put() + Btn_Vel_Process(), one block at a time. Only
+*              the calls of Btn_SM_Velocity.c are timed.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Vel(uint32 u32Samples)
+{
+    static uint32 s_au32Block[BENCH_VEL_BLOCK][BTN_VEL_WORDS];
+    static uint32 s_au32Last[BTN_VEL_WORDS];
+    T_BTN_VEL_PARA  tPara;
+    struct timespec tBeg, tEnd;
+    double   adNs[2] = {0, 0};
+    uint32   au32Evt[2], au32Bad[2], u32Start, u32Tm, u32Edge = 0;
+    uint16   u16Idx, u16Contact;
+    uint8    u8Way, u8Level;
+
+    tPara.pu32Dt    = cg_au32VelDt;
+    tPara.pu8Vel    = cg_au8VelVel;
+    tPara.u8Num     = (uint8)(sizeof(cg_au8VelVel) / sizeof(cg_au8VelVel[0]));
+    tPara.u32LockTm = BENCH_VEL_LOCK;
+    tPara.pfEvt     = Bench_Vel_Evt;
+
+    for(u8Way = 0; u8Way < 2; u8Way++)
+    {   /* 0: block input, 1: queue input */
+        Btn_Vel_Init(&tPara);
+        memset(s_au32Last, 0, sizeof(s_au32Last));
+        sg_u32VelEvt = 0;
+        sg_u32VelBad = 0;
+        for(u32Start = 0; u32Start + BENCH_VEL_BLOCK <= u32Samples; u32Start += BENCH_VEL_BLOCK)
+        {
+            memset(s_au32Block, 0, sizeof(s_au32Block));
+            for(u16Idx = 0; u16Idx < BENCH_VEL_BLOCK; u16Idx++)
+            {
+                u32Tm = u32Start + u16Idx;
+                for(u16Contact = 0; u16Contact < BTN_VEL_CONTACT_NUM; u16Contact++)
+                {
+                    u8Level = Bench_Vel_Level((uint8)(u16Contact >> 1), (uint8)(u16Contact & 1), u32Tm, NULL);
+                    s_au32Block[u16Idx][u16Contact >> 5] |= (uint32)u8Level << (u16Contact & 31);
+                    if(((s_au32Last[u16Contact >> 5] >> (u16Contact & 31)) & 1) != u8Level)
+                    {   /* Edge: put into the queue in the way of ISR */
+                        s_au32Last[u16Contact >> 5] ^= (uint32)1 << (u16Contact & 31);
+                        if(1 == u8Way)
+                        {
+                            clock_gettime(CLOCK_MONOTONIC, &tBeg);
+                            Btn_Vel_Edge_Put((uint8)((u16Contact >> 1) + 1), (uint8)((u16Contact & 1) + 1), u8Level, u32Tm);
+                            clock_gettime(CLOCK_MONOTONIC, &tEnd);
+                            adNs[u8Way] += (double)(tEnd.tv_sec - tBeg.tv_sec) * 1e9 + (double)(tEnd.tv_nsec - tBeg.tv_nsec);
+                            if(0 == (++u32Edge & (BTN_VEL_QUEUE_LEN / 2 - 1)))
+                            {   /* Drain before the queue is full, as a main loop would */
+                                Btn_Vel_Process(u32Tm);
+                            }
+                        }
+                    }
+                }
+            }
+
+            clock_gettime(CLOCK_MONOTONIC, &tBeg);
+            if(0 == u8Way)
+            {
+                Btn_Vel_Block(&s_au32Block[0][0], BENCH_VEL_BLOCK, u32Start);
+            }
+            else
+            {
+                Btn_Vel_Process(u32Start + BENCH_VEL_BLOCK - 1);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &tEnd);
+            adNs[u8Way] += (double)(tEnd.tv_sec - tBeg.tv_sec) * 1e9 + (double)(tEnd.tv_nsec - tBeg.tv_nsec);
+        }
+        au32Evt[u8Way] = sg_u32VelEvt;
+        au32Bad[u8Way] = sg_u32VelBad;
+    }
+
+    printf("keys %u, contacts %u, samples %lu (10kHz, %.1fs), lock %u samples\n",
+           (unsigned)MAX_BTN_VEL_KEY, (unsigned)BTN_VEL_CONTACT_NUM, (unsigned long)u32Samples,
+           (double)u32Samples / 10000.0, (unsigned)BENCH_VEL_LOCK);
+    printf("block   %8.1f ns/sample (%.3f%% of 100us), notes %lu, wrong sample %lu\n",
+           adNs[0] / u32Samples, adNs[0] / u32Samples / 1000.0, (unsigned long)au32Evt[0], (unsigned long)au32Bad[0]);
+    printf("queue   %8.1f ns/sample (%.3f%% of 100us), notes %lu, wrong sample %lu, dropped %lu\n",
+           adNs[1] / u32Samples, adNs[1] / u32Samples / 1000.0, (unsigned long)au32Evt[1], (unsigned long)au32Bad[1],
+           (unsigned long)Btn_Vel_Drop_Get());
+}
+#endif
+
+#ifdef __BTN_SM_ANALOG
+/******************************************************************************
+* Name       : static void Bench_Ana(uint32 u32Frames)
+* Function   : Run the analog keys with rapid trigger
+* Input      : uint32 u32Frames   Number of frames
+* Output:    : None
+* Return     : None
+* description: Each key moves a random step of -64~63 per frame within the full
+*              travel. The stimulus is generated outside the timed call.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Ana(uint32 u32Frames)
+{
+    static uint16       s_au16Travel[MAX_BTN_ANA_KEY];
+    static T_BTN_RESULT s_atRes[MAX_BTN_ANA_KEY];
+    struct timespec tBeg, tEnd;
+    double   dNs = 0;
+    uint32   u32Frame, u32Evt = 0;
+    uint16   u16Idx;
+    long     lTv;
+
+    Btn_Ana_Init(BENCH_ANA_FULL / 2, BENCH_ANA_FULL / 2 - 200, 100);
+    memset(s_au16Travel, 0, sizeof(s_au16Travel));
+    for(u32Frame = 0; u32Frame < u32Frames; u32Frame++)
+    {
+        for(u16Idx = 0; u16Idx < MAX_BTN_ANA_KEY; u16Idx++)
+        {
+            lTv = (long)s_au16Travel[u16Idx] + (long)(Bench_Rand() & 127) - 64;
+            s_au16Travel[u16Idx] = (uint16)((lTv < 0) ? 0 : ((lTv > BENCH_ANA_FULL) ? BENCH_ANA_FULL : lTv));
+        }
+        clock_gettime(CLOCK_MONOTONIC, &tBeg);
+        Btn_Ana_Process(s_au16Travel, s_atRes);
+        clock_gettime(CLOCK_MONOTONIC, &tEnd);
+        dNs += (double)(tEnd.tv_sec - tBeg.tv_sec) * 1e9 + (double)(tEnd.tv_nsec - tBeg.tv_nsec);
+        for(u16Idx = 0; u16Idx < MAX_BTN_ANA_KEY; u16Idx++)
+        {
+            u32Evt += (BTN_NONE_EVT != s_atRes[u16Idx].u8Evt);
+        }
+    }
+
+    printf("keys %u, frames %lu, events %lu (timer overhead included)\n",
+           (unsigned)MAX_BTN_ANA_KEY, (unsigned long)u32Frames, (unsigned long)u32Evt);
+    printf("%.1f ns/frame, %.2f ns/key\n", dNs / u32Frames, dNs / u32Frames / MAX_BTN_ANA_KEY);
+}
+#endif
+
+#ifdef __BTN_SM_TOUCH
+/******************************************************************************
+* Name       : static uint8 Bench_Touch_On(uint8 u8PadIdx, uint32 u32Tick, uint8 *pu8Long)
+* Function   : Touch stimulus of one pad
+* Input      : uint8  u8PadIdx   Index of the pad
+*              uint32 u32Tick    The tick
+* Output:    : uint8 *pu8Long    1: The touch of this period is long
+* Return     : 1: Pad is touched, 0: NOT
+* description: One touch per period, short and long in turn.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Bench_Touch_On(uint8 u8PadIdx, uint32 u32Tick, uint8 *pu8Long)
+{
+    uint32 u32Period = 3000 + u8PadIdx * 7;
+    uint32 u32Pos    = (u32Tick + u8PadIdx * 97) % u32Period;
+
+    *pu8Long = (uint8)(((u32Tick + u8PadIdx * 97) / u32Period) & 1);
+    return (uint8)((u32Pos >= BENCH_TOUCH_START)
+                && (u32Pos < BENCH_TOUCH_START + (*pu8Long ? BENCH_TOUCH_LONG : BENCH_TOUCH_SHORT)));
+}
+
+/******************************************************************************
+* Name       : static void Bench_Touch(uint32 u32Ticks)
+* Function   : Run the touch pads under the virtual clock
+* Input      : uint32 u32Ticks   Number of ticks (1 tick = 1 scan = 1ms)
+* Output:    : None
+* Return     : BTN_ERROR         A touch is missed or a press is false
+*              SUCCESS           Each checked touch gave its events
+* description: Raw count = 1000 + drift + noise + touch. The drift is a triangle
+*              of +/-400 counts over 200000 ticks (much larger than a touch), the
+*              noise is +/-16 counts. A press is false if the pad is NOT touched
+*              at the tick of BTN_PRESSED_EVT.
+*              Only the touches which start and end within the ticks are checked:
+*              each must give exactly one BTN_PRESSED_EVT, and one
+*              BTN_LONG_PRESSED_EVT if it is long (none if short). The events are
+*              counted from the start to the end of the touch.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Bench_Touch(uint32 u32Ticks)
+{
+    static uint16     s_au16Raw[MAX_BTN_TOUCH_PAD];
+    static T_BTN_PARA s_atPara[MAX_BTN_CH];
+    static uint8      s_au8Track[MAX_BTN_CH];         /* Touch of the pad is checked   */
+    static uint8      s_au8Press[MAX_BTN_CH];         /* Presses within the touch      */
+    static uint8      s_au8LongEvt[MAX_BTN_CH];       /* Long-presses within the touch */
+    T_BTN_TOUCH_PARA  tTouch;
+    struct timespec   tBeg, tEnd;
+    double   dNs = 0;
+    uint32   u32Tick, u32Tri, u32Touch = 0, u32Long = 0, u32Press = 0, u32LongEvt = 0, u32False = 0, u32Miss = 0;
+    uint8    u8Idx, u8On, u8OnOld, u8IsLong, u8Num = (MAX_BTN_TOUCH_PAD < MAX_BTN_CH) ? MAX_BTN_TOUCH_PAD : MAX_BTN_CH;
+    long     lRaw;
+
+    tTouch.u16TouchTh   = 80;
+    tTouch.u16RelTh     = 50;
+    tTouch.u16NegTh     = 60;
+    tTouch.u16MaxOnScan = 10000;
+    tTouch.u8FiltShift  = 2;
+    tTouch.u8BaseShift  = 6;
+    Btn_Touch_Init(&tTouch);
+
+    Btn_Replay_Init(NULL, 0);
+    Btn_General_Init(Btn_Replay_Time, Btn_Touch_Btn_St_Get);
+    for(u8Idx = 0; u8Idx < u8Num; u8Idx++)
+    {
+        s_atPara[u8Idx].u8Ch           = (uint8)(u8Idx + 1);
+        s_atPara[u8Idx].u16DebounceTm  = 20;
+        s_atPara[u8Idx].u16LongPressTm = 1000;
+        s_atPara[u8Idx].u8BtnEn        = BTN_FUNC_ENABLE;
+        s_atPara[u8Idx].u8NormalSt     = BTN_NORMAL_0;
+#ifdef __BTN_SM_CH_MODE
+        s_atPara[u8Idx].u8Mode         = BTN_MODE_NORMAL;
+#endif
+        Btn_Channel_Init((uint8)(u8Idx + 1), &s_atPara[u8Idx]);
+    }
+
+    for(u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        Btn_Replay_Step(u32Tick);
+        u32Tri = u32Tick % 200000;
+        for(u8Idx = 0; u8Idx < MAX_BTN_TOUCH_PAD; u8Idx++)
+        {
+            u8On  = Bench_Touch_On(u8Idx, u32Tick, &u8IsLong);
+            lRaw  = 1000 + (long)((u32Tri < 100000) ? u32Tri : (200000 - u32Tri)) * 800 / 100000 - 400;
+            lRaw += (long)(Bench_Rand() & 31) - 16 + (u8On ? BENCH_TOUCH_DELTA : 0);
+            s_au16Raw[u8Idx] = (uint16)lRaw;
+            if((u8Idx >= u8Num) || (0 == u32Tick) || (u8On == Bench_Touch_On(u8Idx, u32Tick - 1, &u8OnOld)))
+            {   /* No edge of a checked pad */
+                continue;
+            }
+            if(u8On)
+            {   /* Touch starts, count its events from here */
+                s_au8Track[u8Idx]   = 1;
+                s_au8Press[u8Idx]   = 0;
+                s_au8LongEvt[u8Idx] = 0;
+            }
+            else if(s_au8Track[u8Idx])
+            {   /* Touch ends, check its events */
+                s_au8Track[u8Idx] = 0;
+                u32Touch++;
+                u32Long    += u8IsLong;
+                u32Press   += s_au8Press[u8Idx];
+                u32LongEvt += s_au8LongEvt[u8Idx];
+                if((1 != s_au8Press[u8Idx]) || (u8IsLong != s_au8LongEvt[u8Idx]))
+                {
+                    u32Miss++;
+                }
+            }
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &tBeg);
+        Btn_Touch_Process(s_au16Raw);
+        clock_gettime(CLOCK_MONOTONIC, &tEnd);
+        dNs += (double)(tEnd.tv_sec - tBeg.tv_sec) * 1e9 + (double)(tEnd.tv_nsec - tBeg.tv_nsec);
+
+        Btn_Scan_Process(sg_atRes);
+        for(u8Idx = 0; u8Idx < u8Num; u8Idx++)
+        {
+            if(BTN_PRESSED_EVT == sg_atRes[u8Idx].u8Evt)
+            {
+                s_au8Press[u8Idx]++;
+                u32False += !Bench_Touch_On(u8Idx, u32Tick, &u8IsLong);
+            }
+            s_au8LongEvt[u8Idx] += (BTN_LONG_PRESSED_EVT == sg_atRes[u8Idx].u8Evt);
+        }
+    }
+
+    printf("pads %u, ticks %lu, drift +/-400, noise +/-16, touch %u counts\n",
+           (unsigned)u8Num, (unsigned long)u32Ticks, (unsigned)BENCH_TOUCH_DELTA);
+    printf("touches %lu (long %lu), pressed %lu, long-pressed %lu, wrong touches %lu, false presses %lu\n",
+           (unsigned long)u32Touch, (unsigned long)u32Long, (unsigned long)u32Press,
+           (unsigned long)u32LongEvt, (unsigned long)u32Miss, (unsigned long)u32False);
+    printf("filters %.1f ns/scan, %.2f ns/pad (timer overhead included)\n",
+           dNs / u32Ticks, dNs / u32Ticks / MAX_BTN_TOUCH_PAD);
+
+    if((0 != u32Miss) || (0 != u32False))
+    {
+        printf("FAIL: touches and events do NOT match\n");
+        return BTN_ERROR;
+    }
+    return SUCCESS;
+}
+#endif
+
+/******************************************************************************
+* Name       : static void Bench_Usage(const char *pcName)
+* Function   : Print the usage
+* Input      : const char *pcName    Name of the program
+* Output:    : None
+* Return     : None
+* description: Only the modes built in are listed.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Usage(const char *pcName)
+{
+    printf("Usage: %s [ticks]          Profile all engines\n", pcName);
+    printf("       %s mix [ticks]      Profile all engines, mixed modes\n", pcName);
+    printf("       %s wcet [ticks]     Worst-case scan time of all engines\n", pcName);
+#ifdef __BTN_SM_PULSE_CNT
+    printf("       %s pulse [ticks]    Edge rate of pulse counter mode\n", pcName);
+#endif
+#ifdef __BTN_SM_SLEEP
+    printf("       %s sleep [ticks]    Sleep and wake-on-press\n", pcName);
+#endif
+#ifdef __BTN_SM_VELOCITY
+    printf("       %s vel [samples]    Velocity of dual-contact keys\n", pcName);
+#endif
+#ifdef __BTN_SM_ANALOG
+    printf("       %s ana [frames]     Analog keys with rapid trigger\n", pcName);
+#endif
+#ifdef __BTN_SM_TOUCH
+    printf("       %s touch [ticks]    Capacitive touch pads\n", pcName);
+#endif
+    printf("       The count must be a number greater than 0.\n");
+}
+
+/******************************************************************************
+* Name       : int main(int argc, char *argv[])
+* Function   : Run the benchmark in the selected mode
+* Input      : Please refer to the usage in file header
+* Output:    : None
+* Return     : 0        The benchmark is run
+*              1        Unknown mode, invalid count or failed check (touch)
+* description: The first argument is the mode if it does NOT start with a digit.
+* Version    : V1.10
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const char   *pcMode = "";
+    char         *pcEnd;
+    unsigned long ulCnt  = 0;
+    int           iArg   = 1;
+
+    if((argc > 1) && ((argv[1][0] < '0') || (argv[1][0] > '9')))
+    {   /* Mode is given */
+        pcMode = argv[1];
+        iArg   = 2;
+    }
+    if(argc > iArg)
+    {   /* Count is given, it must be a whole number greater than 0 */
+        ulCnt = strtoul(argv[iArg], &pcEnd, 10);
+        if(('\0' != *pcEnd) || (0 == ulCnt) || (ulCnt > 0xFFFFFFFFUL) || (argc > iArg + 1))
+        {
+            Bench_Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Bench_Perf_Open();
+
+    if(0 == strcmp(pcMode, ""))
+    {
+        Bench_Profile((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS);
+    }
+    else if(0 == strcmp(pcMode, "wcet"))
+    {
+        Bench_Wcet((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS);
+    }
+    else if(0 == strcmp(pcMode, "mix"))
+    {
+        sg_u8Mix = 1;
+        Bench_Profile((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS);
+    }
+#ifdef __BTN_SM_SLEEP
+    else if(0 == strcmp(pcMode, "sleep"))
+    {
+        Bench_Sleep((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS);
+    }
+#endif
+#ifdef __BTN_SM_VELOCITY
+    else if(0 == strcmp(pcMode, "vel"))
+    {
+        Bench_Vel((0 != ulCnt) ? (uint32)ulCnt : BENCH_VEL_SAMPLES);
+    }
+#endif
+#ifdef __BTN_SM_ANALOG
+    else if(0 == strcmp(pcMode, "ana"))
+    {
+        Bench_Ana((0 != ulCnt) ? (uint32)ulCnt : BENCH_ANA_FRAMES);
+    }
+#endif
+#ifdef __BTN_SM_TOUCH
+    else if(0 == strcmp(pcMode, "touch"))
+    {
+        if(SUCCESS != Bench_Touch((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS))
+        {
+            return 1;
+        }
+    }
+#endif
+#ifdef __BTN_SM_PULSE_CNT
+    else if(0 == strcmp(pcMode, "pulse"))
+    {
+        Bench_Pulse((0 != ulCnt) ? (uint32)ulCnt : BENCH_TICKS);
+    }
+#endif
+    else
+    {   /* Unknown mode, or the mode is NOT built in */
+        Bench_Usage(argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+/*End of file*/
@@ -0,0 +1,190 @@
+/******************************************************************************
+* File       : Btn_SM_Bench_Hpp.cpp
+* Function   : Compare the C++ facade with the raw C calls of the module.
+* description: The same stimulus (Btn_SM_Replay.c, random toggles) is run twice:
+*                  * raw     Btn_Scan_Process() and a loop over T_BTN_RESULT
+*                  * facade  Btn_SM::Engine::Scan() and Btn_SM::EventView
+*              Both runs must see the same number of events; the time per scan of
+*              both is reported. The best of several rounds is taken.
+*
+*              Usage: Btn_SM_Bench_Hpp [ticks]
+*
+*              Build: cc  -O2 -DMAX_BTN_CH=64 -I<path of common.h> -c Btn_SM_Module.c Btn_SM_Replay.c
+*                     c++ -O2 -std=c++20 -DMAX_BTN_CH=64 -o Btn_SM_Bench_Hpp
+*                         Btn_SM_Bench_Hpp.cpp Btn_SM_Module.o Btn_SM_Replay.o
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include "Btn_SM_Module.hpp"
+#include "Btn_SM_Replay.h"
+
+#define BENCH_TICKS                  (200000)    /* Default number of ticks of each run */
+#define BENCH_ROUNDS                 (5)         /* Rounds of each variant              */
+#define BENCH_TOGGLE_MASK            (0x3FF)     /* One toggle per 1024 inputs          */
+
+static uint32 sg_u32Seed = 1;                    /* Seed of pseudo random numbers       */
+
+/******************************************************************************
+* Name       : static void Bench_Stim(uint32 u32Tick)
+* Function   : Move the virtual clock and toggle random inputs
+* Input      : uint32 u32Tick   The tick
+* Output:    : None
+* Return     : None
+* description: xorshift32, same sequence in each run.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Bench_Stim(uint32 u32Tick)
+{
+    Btn_Replay_Step(u32Tick);
+    for(uint8 u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        sg_u32Seed ^= (sg_u32Seed << 13) & 0xFFFFFFFF;
+        sg_u32Seed ^= sg_u32Seed >> 17;
+        sg_u32Seed ^= (sg_u32Seed << 5) & 0xFFFFFFFF;
+        if(0 == (sg_u32Seed & BENCH_TOGGLE_MASK))
+        {
+            Btn_Replay_Level_Set(u8Ch, (uint8)!Btn_Replay_Btn_St_Get(u8Ch));
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static double Bench_Now(void)
+* Function   : Get monotonic time in ns
+* Input      : None
+* Output:    : None
+* Return     : Time in ns
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static double Bench_Now(void)
+{
+    struct timespec tTs;
+
+    clock_gettime(CLOCK_MONOTONIC, &tTs);
+    return (double)tTs.tv_sec * 1e9 + (double)tTs.tv_nsec;
+}
+
+/******************************************************************************
+* Name       : static double Bench_Raw(uint32 u32Ticks, uint32 *pu32Evt)
+* Function   : Run the raw C calls
+* Input      : uint32  u32Ticks   Number of ticks
+* Output:    : uint32 *pu32Evt    Number of events seen
+* Return     : Time of the engine part in ns
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static double Bench_Raw(uint32 u32Ticks, uint32 *pu32Evt)
+{
+    static T_BTN_RESULT s_atRes[MAX_BTN_CH];
+    double dNs = 0, dBeg;
+    uint32 u32Evt = 0;
+
+    sg_u32Seed = 1;
+    Btn_Replay_Init(NULL, 0);
+    Btn_SM_Easy_Init(Btn_Replay_Time, Btn_Replay_Btn_St_Get);
+    for(uint32 u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        Bench_Stim(u32Tick);
+        dBeg = Bench_Now();
+        Btn_Scan_Process(s_atRes);
+        for(uint8 u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+        {
+            if(BTN_NONE_EVT != s_atRes[u8Idx].u8Evt)
+            {
+                u32Evt += s_atRes[u8Idx].u8Evt + u8Idx;
+            }
+        }
+        dNs += Bench_Now() - dBeg;
+    }
+    *pu32Evt = u32Evt;
+    return dNs;
+}
+
+/******************************************************************************
+* Name       : static double Bench_Facade(uint32 u32Ticks, uint32 *pu32Evt)
+* Function   : Run the C++ facade
+* Input      : uint32  u32Ticks   Number of ticks
+* Output:    : uint32 *pu32Evt    Number of events seen
+* Return     : Time of the engine part in ns
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static double Bench_Facade(uint32 u32Ticks, uint32 *pu32Evt)
+{
+    static std::array<T_BTN_RESULT, MAX_BTN_CH> s_atRes;
+    double dNs = 0, dBeg;
+    uint32 u32Evt = 0;
+
+    sg_u32Seed = 1;
+    Btn_Replay_Init(NULL, 0);
+    Btn_SM::Engine tEngine(Btn_Replay_Time, Btn_Replay_Btn_St_Get);
+    if(!tEngine.Ok())
+    {
+        return 0;
+    }
+    for(uint32 u32Tick = 0; u32Tick < u32Ticks; u32Tick++)
+    {
+        Bench_Stim(u32Tick);
+        dBeg = Bench_Now();
+        tEngine.Scan(s_atRes);
+        for(const Btn_SM::Event &tEvt : Btn_SM::Engine::Events(s_atRes))
+        {
+            u32Evt += tEvt.u8Evt + tEvt.tCh.Idx();
+        }
+        dNs += Bench_Now() - dBeg;
+    }
+    *pu32Evt = u32Evt;
+    return dNs;
+}
+
+/******************************************************************************
+* Name       : int main(int argc, char *argv[])
+* Function   : Run both variants and report
+* Input      : Please refer to the usage in file header
+* Output:    : None
+* Return     : 0 if both variants see the same events, 1 if NOT
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32 u32Ticks = (argc > 1) ? (uint32)atoi(argv[1]) : BENCH_TICKS;
+    uint32 u32RawEvt = 0, u32FacEvt = 0;
+    double dRaw = 1e300, dFac = 1e300, dNs;
+
+    for(uint8 u8Round = 0; u8Round < BENCH_ROUNDS; u8Round++)
+    {   /* Interleave the variants, keep the best */
+        dNs = Bench_Raw(u32Ticks, &u32RawEvt);
+        dRaw = (dNs < dRaw) ? dNs : dRaw;
+        dNs = Bench_Facade(u32Ticks, &u32FacEvt);
+        dFac = (dNs < dFac) ? dNs : dFac;
+    }
+
+    printf("channels %u, ticks %lu (timer overhead included)\n", (unsigned)MAX_BTN_CH, (unsigned long)u32Ticks);
+    printf("raw     %8.2f ns/scan  events checksum %lu\n", dRaw / u32Ticks, (unsigned long)u32RawEvt);
+    printf("facade  %8.2f ns/scan  events checksum %lu\n", dFac / u32Ticks, (unsigned long)u32FacEvt);
+    return (u32RawEvt == u32FacEvt) ? 0 : 1;
+}
+
+/* end-of-file */
@@ -4,12 +4,82 @@
 * description: All configuration should be done here.
 *              1. Modify number of used button with MAX_BTN_ST      
 *              2. Define __BTN_SM_SPECIFIED_BTN_ST_FN if you want use specified
-*                 button state getting function for each button.    
-* Version    : V1.10
+*                 button state getting function for each button.
+*              3. Define __BTN_SM_FLIGHT_RECORDER if you want to record the last
+*                 transitions of selected buttons.
+*              4. Define __BTN_SM_TRACE if you want to trace input, state and event
+*                 of each button (e.g. for waveform export).
+*              5. Define __BTN_SM_METRICS if you want to count scans, scan duration,
+*                 events and errors. The scan duration needs a fine tick set by
+*                 Btn_Metrics_Tick_Set().
+*              6. Define __BTN_SM_CONST_TIME if you want Btn_Scan_Process_CT(), which
+*                 runs the same instruction path for every channel (for WCET). It
+*                 runs normal channels only, so do NOT define 7, 8, 14, 18, 19, 20,
+*                 21 or 22 with it.
+*              7. Define __BTN_SM_PULSE_CNT if you want channels in BTN_MODE_PULSE to
+*                 count debounced edges and measure frequency and period.
+*              8. Define __BTN_SM_TOGGLE if you want channels in BTN_MODE_TOGGLE to
+*                 be latched inside the module with toggle events.
+*              9. Define __BTN_SM_BITMAP if you want the module to keep bitmaps of
+*                 pressed, holding and event channels for fast queries.
+*              10.Define __BTN_SM_SOA if you want the scan results as separated state
+*                 array, event bitmap and event list, written only on change.
+*              11.Define __BTN_SM_HOLD_PROGRESS if you want the progress of pressed
+*                 buttons toward long-press (e.g. for a fill bar on UI).
+*              12.Define __BTN_SM_GROUP if you want the scan to process the channels
+*                 grouped by channel mode, one loop per mode.
+*              13.Define __BTN_SM_SLEEP if you want to stop scanning in sleep and wake
+*                 on any press with one compare per input port word, and modify
+*                 BTN_SLEEP_PORTS to the number of words of your input ports.
+*              14.Define __BTN_SM_SPECULATIVE if you want channels with option
+*                 BTN_OPT_SPECULATIVE to report the first edge before debounce.
+*              15.Define __BTN_SM_VELOCITY if you want note events with velocity of
+*                 dual-contact keys (Btn_SM_Velocity.c), and modify MAX_BTN_VEL_KEY.
+*              16.Define __BTN_SM_ANALOG if you want analog (Hall-effect) keys with
+*                 actuation point and rapid trigger (Btn_SM_Analog.c).
+*              17.Define __BTN_SM_TOUCH if you want capacitive touch pads with
+*                 baseline tracking as button channels (Btn_SM_Touch.c).
+*              18.Define __BTN_SM_INTERLOCK if you want interlock rules (inhibit,
+*                 mutual exclusion, hold-off) checked inside the module. It needs
+*                 __BTN_SM_BITMAP, which is defined with it.
+*              19.Define __BTN_SM_LOGICAL if you want logical channels, which take
+*                 the debounced state of another channel instead of reading an
+*                 input (one key with several behaviors).
+*              20.Define __BTN_SM_LP_ADAPT if you want the long-press time of some
+*                 channels adapted to the short presses of the user.
+*              21.Define __BTN_SM_REPLICA if you want the running status replicated
+*                 to a standby process through a ring in shared memory.
+*              22.Define __BTN_SM_DIGEST if you want a digest of the running status of
+*                 all channels, to compare redundant instances in lockstep.
+* Version    : V1.34
 * Author     : Ian
-* Date       : 15th Jun 2016
+* Date       : 18th Oct 2026
 * History    :  No.  When          Who   Version   What        
 *               1    15/Jun/2016   Ian   V1.10     Create      
+*               2    18/Oct/2026   Ian   V1.11     Add flight recorder option
+*               3    18/Oct/2026   Ian   V1.12     Add trace option
+*               4    18/Oct/2026   Ian   V1.13     Add metrics option
+*               5    18/Oct/2026   Ian   V1.14     Add constant-time scan option
+*               6    18/Oct/2026   Ian   V1.15     Add pulse counter mode option
+*               7    18/Oct/2026   Ian   V1.16     Add toggle mode option
+*               8    18/Oct/2026   Ian   V1.17     Add channel bitmap option
+*               9    18/Oct/2026   Ian   V1.18     Add structure-of-arrays scan option
+*               10   18/Oct/2026   Ian   V1.19     Add hold progress option
+*               11   18/Oct/2026   Ian   V1.20     Add grouped scan option
+*               12   18/Oct/2026   Ian   V1.21     Add sleep option
+*               13   18/Oct/2026   Ian   V1.22     Add speculative press option
+*               14   18/Oct/2026   Ian   V1.23     Add velocity option and MAX_BTN_VEL_KEY
+*               15   18/Oct/2026   Ian   V1.24     Add analog key option and MAX_BTN_ANA_KEY
+*               16   18/Oct/2026   Ian   V1.25     Add touch pad option and MAX_BTN_TOUCH_PAD
+*               17   18/Oct/2026   Ian   V1.26     Add interlock rule option
+*               18   18/Oct/2026   Ian   V1.27     Add logical channel option
+*               19   18/Oct/2026   Ian   V1.28     Add adaptive long-press option
+*               20   18/Oct/2026   Ian   V1.29     Add replication option, BTN_REPL_LEN and BTN_REPL_BARRIER
+*               21   18/Oct/2026   Ian   V1.30     Add digest option
+*               22   18/Oct/2026   Ian   V1.31     Add BTN_BARRIER, default the ring barrier to it
+*               23   18/Oct/2026   Ian   V1.32     Note the fine tick of the scan duration
+*               24   18/Oct/2026   Ian   V1.33     Note the options excluded by the constant-time scan
+*               25   18/Oct/2026   Ian   V1.34     Add BTN_SLEEP_PORTS for the pins of the sleep check
 ******************************************************************************/
 
 
@@ -20,11 +90,112 @@
 extern "C" {
 #endif
   
+#ifndef MAX_BTN_CH
 #define MAX_BTN_CH                   (3)         /* Max number of buttons, please define it here */
+#endif
 
 /* If you want to use specified button state getting function, define the MACRO */
 //#define __BTN_SM_SPECIFIED_BTN_ST_FN             /* Use specified button state getting function  */
 
+/* If you want to record the last transitions of selected channels, define the MACRO */
+//#define __BTN_SM_FLIGHT_RECORDER                 /* Use per-channel flight recorder              */
+
+/* If you want to trace every process of each button, define the MACRO */
+//#define __BTN_SM_TRACE                           /* Use trace hook                               */
+
+/* If you want to count scans, events and errors for monitoring, define the MACRO */
+//#define __BTN_SM_METRICS                         /* Use metrics counters                         */
+
+/* If you need a bounded scan time (WCET) regardless of button states, define the MACRO */
+//#define __BTN_SM_CONST_TIME                      /* Use constant-time scan process               */
+
+/* If you want to use buttons as pulse counters (flow meter, tachometer), define the MACRO */
+//#define __BTN_SM_PULSE_CNT                       /* Use pulse counter channel mode               */
+
+/* If you want the module to keep the latch of toggle buttons (power, mute), define the MACRO */
+//#define __BTN_SM_TOGGLE                          /* Use toggle channel mode                      */
+
+/* If you want to query pressed/holding channels without walking the results, define the MACRO */
+//#define __BTN_SM_BITMAP                          /* Use channel bitmaps                          */
+
+/* If you want the scan to write only changed results, define the MACRO */
+//#define __BTN_SM_SOA                             /* Use structure-of-arrays scan output          */
+
+/* If you want to show the progress toward long-press, define the MACRO */
+//#define __BTN_SM_HOLD_PROGRESS                   /* Use hold progress                            */
+
+/* If you mix channel modes (normal, pulse, toggle), define the MACRO to scan them by groups */
+//#define __BTN_SM_GROUP                           /* Use scan grouped by channel mode             */
+
+/* If you want to wake up from sleep on any press without scanning, define the MACRO */
+//#define __BTN_SM_SLEEP                           /* Use sleep and wake-on-press detection        */
+#ifdef __BTN_SM_SLEEP
+#ifndef BTN_SLEEP_PORTS
+#define BTN_SLEEP_PORTS              ((MAX_BTN_CH + 31) / 32) /* Words of the input ports       */
+#endif
+#endif
+
+/* If you need press events without debounce latency (gaming, music), define the MACRO */
+//#define __BTN_SM_SPECULATIVE                     /* Use speculative press events                 */
+
+/* If you have dual-contact keys with velocity (musical keyboards), define the MACRO */
+//#define __BTN_SM_VELOCITY                        /* Use velocity of dual-contact keys            */
+#ifdef __BTN_SM_VELOCITY
+#ifndef MAX_BTN_VEL_KEY
+#define MAX_BTN_VEL_KEY              (88)        /* Max number of dual-contact keys              */
+#endif
+#define BTN_VEL_QUEUE_LEN            (64)        /* Edges in the queue from ISR, power of 2      */
+#endif
+
+/* If your keys report analog travel (Hall-effect), define the MACRO */
+//#define __BTN_SM_ANALOG                          /* Use analog keys                              */
+#ifdef __BTN_SM_ANALOG
+#ifndef MAX_BTN_ANA_KEY
+#define MAX_BTN_ANA_KEY              (MAX_BTN_CH) /* Max number of analog keys                   */
+#endif
+#endif
+
+/* If you use capacitive touch pads, define the MACRO */
+//#define __BTN_SM_TOUCH                           /* Use capacitive touch pads                    */
+#ifdef __BTN_SM_TOUCH
+#ifndef MAX_BTN_TOUCH_PAD
+#define MAX_BTN_TOUCH_PAD            (MAX_BTN_CH) /* Max number of touch pads                    */
+#endif
+#endif
+
+/* If you want interlock rules of channels checked inside the module, define the MACRO */
+//#define __BTN_SM_INTERLOCK                       /* Use interlock rules                          */
+#if defined(__BTN_SM_INTERLOCK) && !defined(__BTN_SM_BITMAP)
+#define __BTN_SM_BITMAP                          /* Rules are checked against the bitmaps        */
+#endif
+
+/* If you want logical channels fed by other channels, define the MACRO */
+//#define __BTN_SM_LOGICAL                         /* Use logical channels                         */
+
+/* If you want the long-press time adapted to the user, define the MACRO */
+//#define __BTN_SM_LP_ADAPT                        /* Use long-press time calibration              */
+
+/* If you want the running status replicated to a standby, define the MACRO */
+//#define __BTN_SM_REPLICA                         /* Use replication to a standby                 */
+#ifdef __BTN_SM_REPLICA
+#define BTN_REPL_LEN                 (256)       /* Items in the ring, power of 2, >= MAX_BTN_CH */
+#ifndef BTN_REPL_BARRIER
+#define BTN_REPL_BARRIER()           BTN_BARRIER()   /* Memory barrier between the processes     */
+#endif
+#endif
+
+/* If you run redundant instances and compare them each scan, define the MACRO */
+//#define __BTN_SM_DIGEST                          /* Use rolling state digest                     */
+
+/* Memory barrier for data read by other threads, processes or interrupts */
+#ifndef BTN_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define BTN_BARRIER()                __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define BTN_BARRIER()                            /* Define it for your compiler, e.g. __DMB()    */
+#endif
+#endif
+
 /* If type is NOT defined, define the type here */
 typedef unsigned char       uint8;
 typedef unsigned short int  uint16;
@@ -140,7 +140,7 @@ void Gpio_Init()
 ******************************************************************************/
 int main (void)
 {   
-    uint8 u8Idx,u8Vol = 0,u8FnCode = 1;;
+    uint8 u8Vol = 0,u8FnCode = 1;
     uint16 u16Tm = App_GetSystemTime_ms();
 
     /* Init hardware */
@@ -153,10 +153,7 @@ int main (void)
     while(1)
     {   
         /* Button process and get button event & state */
-        for(u8Idx = 1; u8Idx <= MAX_BTN_CH; u8Idx++)
-        {
-            Btn_Channel_Process(u8Idx, &(sg_atBtn[u8Idx-1]));
-        }
+        Btn_Scan_Process(sg_atBtn);
 
         /* If the button 3 is long pressed */
         if(BTN_LONG_PRESSED_EVT == sg_atBtn[2].u8Evt)
@@ -0,0 +1,123 @@
+/******************************************************************************
+* File       : Btn_SM_Host_Gen.c
+* Function   : Waveform generator for the fake register bank.
+* description: External process driving the register bank of Btn_SM_Host_Reg.c.
+*              Every tick it increases HOST_REG_SEQ to odd, writes the level of each
+*              button into the port input registers, advances HOST_REG_TM, and
+*              increases HOST_REG_SEQ to even again.
+*              Button n is wired to port (n-1)/32, bit (n-1)%32, active high.
+*
+*              Each button is pressed once per period and held for the hold time,
+*              with random contact bounce on both edges. Buttons are phase shifted
+*              so the edges are spread over the period.
+*
+*              Usage: Btn_SM_Host_Gen <file> <buttons> <period> <hold> <bounce> [us/tick]
+*                     us/tick = 0 runs as fast as possible (default is 1000, real time).
+*
+*              Build: cc -O2 -o Btn_SM_Host_Gen Btn_SM_Host_Gen.c Btn_SM_Host_Reg.c
+*              Check: Btn_SM_Host_Read (Btn_SM_Host_Read.c) with the same arguments.
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.01
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Odd sequence while a tick is written
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Host_Reg.h"
+
+/******************************************************************************
+* Name       : static uint8 Gen_Level(uint32_t u32Tm, uint32_t u32Period,
+*                                     uint32_t u32Hold, uint32_t u32Bounce)
+* Function   : Get the level of one button at the given time
+* Input      : uint32_t u32Tm       Time in the period of this button
+*              uint32_t u32Period   Press period
+*              uint32_t u32Hold     Hold time of each press
+*              uint32_t u32Bounce   Bounce time at each edge
+* Output:    : None
+* Return     : 0/1                  Level of the button
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Gen_Level(uint32_t u32Tm, uint32_t u32Period, uint32_t u32Hold, uint32_t u32Bounce)
+{
+    u32Tm %= u32Period;
+
+    /* Bouncing at the press edge or the release edge */
+    if((u32Tm < u32Bounce) || ((u32Tm >= u32Hold) && (u32Tm < u32Hold + u32Bounce)))
+    {
+        return (uint8)(rand() & 1);
+    }
+    return (uint8)(u32Tm < u32Hold);
+}
+
+/******************************************************************************
+* Name       : int main(int argc, char *argv[])
+* Function   : Generate waveforms into the register bank forever
+* Input      : Please refer to the usage in file header
+* Output:    : None
+* Return     : 1        Invalid arguments or failed to map the bank
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint32_t u32Btn, u32Period, u32Hold, u32Bounce, u32Us, u32Tm, u32Idx;
+
+    if(argc < 6)
+    {
+        printf("Usage: %s <file> <buttons> <period> <hold> <bounce> [us/tick]\n", argv[0]);
+        return 1;
+    }
+    u32Btn    = (uint32_t)atoi(argv[2]);
+    u32Period = (uint32_t)atoi(argv[3]);
+    u32Hold   = (uint32_t)atoi(argv[4]);
+    u32Bounce = (uint32_t)atoi(argv[5]);
+    u32Us     = (argc > 6) ? (uint32_t)atoi(argv[6]) : 1000;
+
+    if((0 == u32Period) || (u32Hold + u32Bounce > u32Period) || (u32Btn > HOST_REG_PORT_NUM * 32))
+    {
+        printf("Invalid waveform parameters\n");
+        return 1;
+    }
+
+    if(SUCCESS != Host_Reg_Open(argv[1], 1))
+    {
+        printf("Failed to map %s\n", argv[1]);
+        return 1;
+    }
+
+    for(u32Tm = 0; ; u32Tm++)
+    {
+        /* Odd sequence while the tick is written, so the reader can find torn reads */
+        __atomic_fetch_add(Host_Reg_Addr(HOST_REG_SEQ), 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        for(u32Idx = 0; u32Idx < u32Btn; u32Idx++)
+        {   /* Spread the edges of buttons over the period */
+            Host_Reg_Bit_Write((uint8)(u32Idx >> 5), (uint8)(u32Idx & 31),
+                               Gen_Level(u32Tm + u32Idx * 7, u32Period, u32Hold, u32Bounce));
+        }
+        /* Publish the tick after the levels of this tick */
+        __atomic_store_n(Host_Reg_Addr(HOST_REG_TM), u32Tm, __ATOMIC_RELEASE);
+        __atomic_fetch_add(Host_Reg_Addr(HOST_REG_SEQ), 1, __ATOMIC_RELEASE);
+
+        if(u32Us)
+        {
+            usleep(u32Us);
+        }
+    }
+    return 0;
+}
+
+/*End of file*/
@@ -0,0 +1,228 @@
+/******************************************************************************
+* File       : Btn_SM_Host_Read.c
+* Function   : Reader of the fake register bank, checking the events.
+* description: Runs the button state machine on the register bank written by
+*              Btn_SM_Host_Gen.c, through Host_Reg_Btn_St_Get() and Host_Reg_Time(),
+*              and checks each event against the generated waveform.
+*
+*              One scan is done for each tick of the generator. HOST_REG_SEQ is
+*              read before and after the scan (seqlock):
+*                  * Missed    The sequence moved more than one tick since the last
+*                              scan (the reader was too slow).
+*                  * Torn      The generator wrote the next tick during the scan, so
+*                              the scan may have read levels of two ticks.
+*              The events within one period after the start, a missed tick or a
+*              torn scan are NOT checked, as their time is NOT known exactly.
+*
+*              Each button is pressed at phase 0 of its period, with bounce B, and
+*              released at phase H (see Btn_SM_Host_Gen.c). With the debounce time
+*              D and the long-press time L of Btn_SM_Easy_Init(), the events must
+*              be at these phases (one tick of margin on both sides):
+*                  * BTN_PRESSED_EVT          D+1   ~ B+D+1
+*                  * BTN_LONG_PRESSED_EVT     L+D+1 ~ L+B+D+2
+*                  * BTN_S/L_RELEASED_EVT     H+D+1 ~ H+B+D+1
+*              and a long-released event only after a long-press event.
+*
+*              Usage: Btn_SM_Host_Read <file> <buttons> <period> <hold> <bounce> [seconds]
+*                     The waveform arguments must be the same as the generator.
+*
+*              Build: cc -O2 -DMAX_BTN_CH=64 -I<path of common.h> -o Btn_SM_Host_Read
+*                        Btn_SM_Host_Read.c Btn_SM_Host_Reg.c Btn_SM_Module.c
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Host_Reg.h"
+
+#define READ_DB_TM                   (50)        /* Debounce time of Btn_SM_Easy_Init()   */
+#define READ_LP_TM                   (1000)      /* Long-press time of Btn_SM_Easy_Init() */
+#define READ_MARGIN                  (1)         /* Margin of the event windows           */
+#define READ_SECONDS                 (10)        /* Default run time                      */
+#define READ_POLL_US                 (50)        /* Poll interval of HOST_REG_SEQ         */
+
+/******************************************************************************
+* Name       : static uint8 Read_In_Win(uint32_t u32Phase, uint32_t u32Lo,
+*                                       uint32_t u32Hi, uint32_t u32Period)
+* Function   : Check if the phase is in the window (with margin)
+* Input      : uint32_t u32Phase    Phase of the event in the period
+*              uint32_t u32Lo       First phase of the window
+*              uint32_t u32Hi       Last phase of the window
+*              uint32_t u32Period   Press period
+* Output:    : None
+* Return     : 1                    In the window
+*              0                    Out of the window
+* description: The window may wrap around the end of the period.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Read_In_Win(uint32_t u32Phase, uint32_t u32Lo, uint32_t u32Hi, uint32_t u32Period)
+{
+    u32Lo -= READ_MARGIN;
+    u32Hi += READ_MARGIN;
+    return (uint8)(((u32Phase + u32Period - (u32Lo % u32Period)) % u32Period) <= (u32Hi - u32Lo));
+}
+
+/******************************************************************************
+* Name       : int main(int argc, char *argv[])
+* Function   : Scan the register bank and check the events
+* Input      : Please refer to the usage in file header
+* Output:    : None
+* Return     : 0        All checked events are in their windows
+*              1        Invalid arguments, failed to map the bank, wrong events or
+*                       no event checked
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static T_BTN_RESULT s_atRes[MAX_BTN_CH];
+    static uint8        s_au8Long[MAX_BTN_CH];
+    volatile uint32_t  *pu32Seq;
+    uint32_t u32Btn, u32Period, u32Hold, u32Bounce, u32Sec;
+    uint32_t u32Seq, u32SeqEnd, u32LastSeq, u32Tm, u32StartTm, u32GapTm, u32Phase;
+    uint32_t u32Scan = 0, u32Miss = 0, u32Torn = 0, u32Ok = 0, u32Bad = 0, u32Skip = 0;
+    uint32_t u32Idx;
+    uint8    u8Ok;
+
+    if(argc < 6)
+    {
+        printf("Usage: %s <file> <buttons> <period> <hold> <bounce> [seconds]\n", argv[0]);
+        return 1;
+    }
+    u32Btn    = (uint32_t)atoi(argv[2]);
+    u32Period = (uint32_t)atoi(argv[3]);
+    u32Hold   = (uint32_t)atoi(argv[4]);
+    u32Bounce = (uint32_t)atoi(argv[5]);
+    u32Sec    = (argc > 6) ? (uint32_t)atoi(argv[6]) : READ_SECONDS;
+
+    if((0 == u32Btn) || (u32Btn > MAX_BTN_CH) || (0 == u32Period) || (0 == u32Sec)
+    || (u32Hold + u32Bounce + READ_DB_TM + 2 > u32Period) || (u32Bounce + READ_DB_TM + 2 > u32Hold))
+    {
+        printf("Invalid waveform parameters (buttons 1~%d, debounce %d)\n", MAX_BTN_CH, READ_DB_TM);
+        return 1;
+    }
+
+    if(SUCCESS != Host_Reg_Open(argv[1], 0))
+    {
+        printf("Failed to map %s\n", argv[1]);
+        return 1;
+    }
+    for(u32Idx = 0; u32Idx < u32Btn; u32Idx++)
+    {   /* Same wiring as the generator */
+        Host_Reg_Map((uint8)(u32Idx + 1), (uint8)(u32Idx >> 5), (uint8)(u32Idx & 31), HOST_REG_ACT_HIGH);
+    }
+    if(SUCCESS != Btn_SM_Easy_Init(Host_Reg_Time, Host_Reg_Btn_St_Get))
+    {
+        printf("Failed to init the module\n");
+        return 1;
+    }
+    for(u32Idx = u32Btn; u32Idx < MAX_BTN_CH; u32Idx++)
+    {   /* Channels NOT driven by the generator */
+        Btn_Func_En_Dis((uint8)(u32Idx + 1), BTN_FUNC_DISABLE);
+    }
+
+    pu32Seq    = Host_Reg_Addr(HOST_REG_SEQ);
+    u32LastSeq = __atomic_load_n(pu32Seq, __ATOMIC_ACQUIRE) & ~(uint32_t)1;
+    u32StartTm = HOST_REG(HOST_REG_TM);
+    u32Tm      = u32StartTm;
+    u32GapTm   = u32StartTm;                    /* The state before the start is NOT known */
+    do
+    {
+        /* Wait for the next tick, NOT while the generator is writing it */
+        u32Seq = __atomic_load_n(pu32Seq, __ATOMIC_ACQUIRE);
+        if((u32Seq & 1) || (u32Seq == u32LastSeq))
+        {
+            usleep(READ_POLL_US);
+            continue;
+        }
+
+        u32Tm = HOST_REG(HOST_REG_TM);
+        Btn_Scan_Process(s_atRes);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        u32SeqEnd = __atomic_load_n(pu32Seq, __ATOMIC_RELAXED);
+        u32Scan++;
+
+        if(u32Seq - u32LastSeq > 2)
+        {
+            u32Miss += (u32Seq - u32LastSeq) / 2 - 1;
+            u32GapTm = u32Tm;
+        }
+        if(u32SeqEnd != u32Seq)
+        {
+            u32Torn++;
+            u32GapTm = u32Tm;
+        }
+        u32LastSeq = u32Seq;
+
+        for(u32Idx = 0; u32Idx < u32Btn; u32Idx++)
+        {
+            if(BTN_NONE_EVT == s_atRes[u32Idx].u8Evt)
+            {
+                continue;
+            }
+            if(u32Tm - u32GapTm < u32Period)
+            {   /* Time of the edges is NOT known exactly */
+                s_au8Long[u32Idx] = (BTN_LONG_PRESSED_EVT == s_atRes[u32Idx].u8Evt);
+                u32Skip++;
+                continue;
+            }
+
+            u32Phase = (u32Tm + u32Idx * 7) % u32Period;
+            switch(s_atRes[u32Idx].u8Evt)
+            {
+                case BTN_PRESSED_EVT:
+                    u8Ok = Read_In_Win(u32Phase, READ_DB_TM + 1, u32Bounce + READ_DB_TM + 1, u32Period);
+                    s_au8Long[u32Idx] = 0;
+                    break;
+                case BTN_LONG_PRESSED_EVT:
+                    u8Ok = Read_In_Win(u32Phase, READ_LP_TM + READ_DB_TM + 1,
+                                       READ_LP_TM + u32Bounce + READ_DB_TM + 2, u32Period);
+                    s_au8Long[u32Idx] = 1;
+                    break;
+                case BTN_S_RELEASED_EVT:
+                case BTN_L_RELEASED_EVT:
+                    u8Ok = Read_In_Win(u32Phase, u32Hold + READ_DB_TM + 1,
+                                       u32Hold + u32Bounce + READ_DB_TM + 1, u32Period)
+                         & (s_au8Long[u32Idx] == (BTN_L_RELEASED_EVT == s_atRes[u32Idx].u8Evt));
+                    break;
+                default:
+                    u8Ok = 0;
+                    break;
+            }
+
+            if(u8Ok)
+            {
+                u32Ok++;
+            }
+            else
+            {
+                u32Bad++;
+                printf("Channel %u event %u at tick %u (phase %u) is NOT expected\n",
+                       (unsigned)(u32Idx + 1), (unsigned)s_atRes[u32Idx].u8Evt,
+                       (unsigned)u32Tm, (unsigned)u32Phase);
+            }
+        }
+    }while(u32Tm - u32StartTm < u32Sec * 1000);
+
+    printf("scans %u, missed ticks %u, torn scans %u\n",
+           (unsigned)u32Scan, (unsigned)u32Miss, (unsigned)u32Torn);
+    printf("events checked %u, wrong %u, NOT checked %u\n",
+           (unsigned)(u32Ok + u32Bad), (unsigned)u32Bad, (unsigned)u32Skip);
+    Host_Reg_Close();
+    return ((0 == u32Bad) && (0 != u32Ok)) ? 0 : 1;
+}
+
+/*End of file*/
@@ -0,0 +1,235 @@
+/******************************************************************************
+* File       : Btn_SM_Host_Reg.c
+* Function   : Fake memory-mapped register bank for running the module on a host.
+* description: Map a shared file as a bank of 32-bit registers, and provide the
+*              PF_GET_BTN/PF_GET_TM interface functions reading it with volatile
+*              semantics. Please refer to Btn_SM_Host_Reg.h for details.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Host_Reg.h"
+
+#define HOST_REG_UNMAPPED            (0xFF)      /* Channel is NOT mapped to any port */
+
+/* Pin assignment of each channel */
+typedef struct _T_HOST_REG_MAP_
+{
+    uint32_t    u32Mask;            /* Bit mask in the port register    */
+    uint8       u8Port;             /* Port index, or HOST_REG_UNMAPPED */
+    uint8       u8ActLow;           /* Pin is "0" when pressed          */
+}T_HOST_REG_MAP;
+
+static volatile uint32_t *sg_pu32Reg            = NULL;  /* Mapped register bank */
+static T_HOST_REG_MAP     sg_atMap[MAX_BTN_CH];          /* Pin assignment       */
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Open(const char *pcPath, uint8 u8Create)
+* Function   : Map the shared file as the fake register bank
+* Input      : const char *pcPath     Path of the shared file (e.g. /dev/shm/btn_reg)
+*              uint8 u8Create         1: create and clear the file; 0: open existing one
+* Output:    : None
+* Return     : BTN_ERROR              Failed to open or map the file
+*              SUCCESS                The bank is mapped
+* description: The generator opens the file with u8Create = 1, the reader with 0.
+*              Only one bank can be mapped at a time in one process.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Open(const char *pcPath, uint8 u8Create)
+{
+    int   iFd;
+    void *pvMap;
+    uint8 u8Idx;
+
+    /* Check if the input parameter is valid or NOT */
+    if((NULL == pcPath) || (NULL != sg_pu32Reg))
+    {   /* Return if the parameter is invalid or bank is already mapped */
+        return BTN_ERROR;
+    }
+
+    iFd = open(pcPath, u8Create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0666);
+    if(iFd < 0)
+    {
+        return BTN_ERROR;
+    }
+
+    /* The file is cleared and extended to the size of the bank by the creator */
+    if(u8Create && (ftruncate(iFd, HOST_REG_SIZE) != 0))
+    {
+        close(iFd);
+        return BTN_ERROR;
+    }
+
+    pvMap = mmap(NULL, HOST_REG_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0);
+    close(iFd);                     /* The mapping keeps the file alive */
+    if(MAP_FAILED == pvMap)
+    {
+        return BTN_ERROR;
+    }
+
+    sg_pu32Reg = (volatile uint32_t*)pvMap;
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {   /* No channel is mapped at the beginning */
+        sg_atMap[u8Idx].u8Port = HOST_REG_UNMAPPED;
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : void Host_Reg_Close(void)
+* Function   : Unmap the fake register bank
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Host_Reg_Close(void)
+{
+    if(NULL != sg_pu32Reg)
+    {
+        munmap((void*)sg_pu32Reg, HOST_REG_SIZE);
+        sg_pu32Reg = NULL;
+    }
+}
+
+/******************************************************************************
+* Name       : volatile uint32_t* Host_Reg_Addr(uint8 u8Idx)
+* Function   : Get the address of one word in the register bank
+* Input      : uint8 u8Idx     0~HOST_REG_NUM-1   Index of the word
+* Output:    : None
+* Return     : Volatile pointer to the word.
+* description: The bank must be mapped with Host_Reg_Open() first. The index is NOT
+*              checked, same as a hardware register address.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+volatile uint32_t* Host_Reg_Addr(uint8 u8Idx)
+{
+    return &(sg_pu32Reg[u8Idx]);
+}
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Map(uint8 u8Ch, uint8 u8Port, uint8 u8Bit, uint8 u8ActLow)
+* Function   : Bind one button channel to one bit of a port input register
+* Input      : uint8 u8Ch       1~MAX_BTN_CH          The number of button channel
+*              uint8 u8Port     0~HOST_REG_PORT_NUM-1 Port index
+*              uint8 u8Bit      0~31                  Bit index in the port
+*              uint8 u8ActLow   HOST_REG_ACT_LOW      Pin is "0" when pressed
+*                               HOST_REG_ACT_HIGH     Pin is "1" when pressed
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The channel is mapped
+* description: Same as the pin assignment in Btn_St_Get() of the demo.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Map(uint8 u8Ch, uint8 u8Port, uint8 u8Bit, uint8 u8ActLow)
+{
+    /* Check if the input parameter is valid or NOT */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH) || (u8Port >= HOST_REG_PORT_NUM) || (u8Bit > 31))
+    {   /* Return if the parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    sg_atMap[u8Ch - 1].u32Mask  = ((uint32_t)1) << u8Bit;
+    sg_atMap[u8Ch - 1].u8Port   = u8Port;
+    sg_atMap[u8Ch - 1].u8ActLow = (u8ActLow != HOST_REG_ACT_HIGH);
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the button state from the fake register bank (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_CH   The number of button channel
+* Output:    : None
+* Return     : BTN_STATE_0      Button state is logic "0"
+*              BTN_STATE_1      Button state is logic "1"
+*              BTN_ERROR        The channel is NOT mapped
+* description: One volatile read of the port register per call.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Btn_St_Get(uint8 u8Ch)
+{
+    T_HOST_REG_MAP *ptMap;
+    uint8           u8Temp;
+
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    ptMap = &(sg_atMap[u8Ch - 1]);
+    if(HOST_REG_UNMAPPED == ptMap->u8Port)
+    {   /* Return error if the channel is NOT mapped */
+        return BTN_ERROR;
+    }
+
+    /* Same as "(!(GPIOA_PDIR & (1 << 5)))" in the demo */
+    u8Temp = ((HOST_PDIR(ptMap->u8Port) & ptMap->u32Mask) != 0);
+    return (uint8)(u8Temp ^ ptMap->u8ActLow);
+}
+
+/******************************************************************************
+* Name       : uint16 Host_Reg_Time(void)
+* Function   : Get the free running tick written by the generator (PF_GET_TM)
+* Input      : None
+* Output:    : None
+* Return     : 0~65535  Lower 16 bits of HOST_REG_TM
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Host_Reg_Time(void)
+{
+    return (uint16)HOST_REG(HOST_REG_TM);
+}
+
+/******************************************************************************
+* Name       : void Host_Reg_Bit_Write(uint8 u8Port, uint8 u8Bit, uint8 u8Val)
+* Function   : Set or clear one bit of a port input register (generator side)
+* Input      : uint8 u8Port     0~HOST_REG_PORT_NUM-1 Port index
+*              uint8 u8Bit      0~31                  Bit index in the port
+*              uint8 u8Val      0/1                   New value of the bit
+* Output:    : None
+* Return     : None
+* description: Atomic read-modify-write, so several generator threads may drive
+*              different bits of the same port.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Host_Reg_Bit_Write(uint8 u8Port, uint8 u8Bit, uint8 u8Val)
+{
+    volatile uint32_t *pu32Reg = &HOST_PDIR(u8Port);
+    uint32_t           u32Mask = ((uint32_t)1) << u8Bit;
+
+    if(u8Val)
+    {
+        __atomic_fetch_or(pu32Reg, u32Mask, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_fetch_and(pu32Reg, ~u32Mask, __ATOMIC_RELEASE);
+    }
+}
+
+/* end-of-file */
@@ -0,0 +1,168 @@
+/******************************************************************************
+* File       : Btn_SM_Host_Reg.h
+* Function   : Fake memory-mapped register bank for running the module on a host.
+* description: The demo reads the button inputs from memory-mapped GPIO (GPIOA_PDIR).
+*              On a Linux host there is no such register, so this file maps a shared
+*              file as a bank of 32-bit "registers". An external generator process
+*              (see Btn_SM_Host_Gen.c) writes waveforms and a free running tick into
+*              the bank, and the button state machine reads it through volatile
+*              pointers exactly like a real port register.
+*
+*              Layout of the shared file (HOST_REG_NUM x 32-bit words):
+*                  * Word 0                   HOST_REG_TM    Free running tick (1 unit = 1ms)
+*                  * Word 1                   HOST_REG_SEQ   Generator sequence counter, odd
+*                                                            while a tick is being written
+*                  * Word 2 ~ HOST_REG_NUM-1  HOST_REG_PDIR  Port data input registers
+*
+*              HOW TO USE:
+*              Step 1: Start the generator: "Btn_SM_Host_Gen /dev/shm/btn_reg ..."
+*              Step 2: Call "Host_Reg_Open()" with the same file.
+*              Step 3: Call "Host_Reg_Map()" for each channel to bind it to a port bit.
+*              Step 4: Call "Btn_SM_Easy_Init(Host_Reg_Time, Host_Reg_Btn_St_Get)".
+*              Btn_SM_Host_Read.c does these steps and checks the events against the
+*              waveform of the generator.
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.01
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Add reader, odd sequence while writing
+******************************************************************************/
+
+#ifndef _BTN_SM_HOST_REG_
+#define _BTN_SM_HOST_REG_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HOST_REG_NUM                 (64)        /* Number of 32-bit words in the register bank  */
+#define HOST_REG_SIZE                (HOST_REG_NUM * sizeof(uint32_t)) /* Size of shared file    */
+#define HOST_REG_TM                  (0)         /* Word index of the free running tick          */
+#define HOST_REG_SEQ                 (1)         /* Word index of the generator sequence counter */
+#define HOST_REG_PDIR_BASE           (2)         /* Word index of the first port input register  */
+#define HOST_REG_PORT_NUM            (HOST_REG_NUM - HOST_REG_PDIR_BASE) /* Number of ports      */
+
+#define HOST_REG_ACT_LOW             (1)         /* Pin reads "0" when the button is pressed     */
+#define HOST_REG_ACT_HIGH            (0)         /* Pin reads "1" when the button is pressed     */
+
+/* Volatile access to the bank, same usage as "GPIOA_PDIR" on target */
+#define HOST_REG(u8Idx)              (*Host_Reg_Addr(u8Idx))
+#define HOST_PDIR(u8Port)            HOST_REG(HOST_REG_PDIR_BASE + (u8Port))
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Open(const char *pcPath, uint8 u8Create)
+* Function   : Map the shared file as the fake register bank
+* Input      : const char *pcPath     Path of the shared file (e.g. /dev/shm/btn_reg)
+*              uint8 u8Create         1: create and clear the file; 0: open existing one
+* Output:    : None
+* Return     : BTN_ERROR              Failed to open or map the file
+*              SUCCESS                The bank is mapped
+* description: The generator opens the file with u8Create = 1, the reader with 0.
+*              Only one bank can be mapped at a time in one process.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Open(const char *pcPath, uint8 u8Create);
+
+/******************************************************************************
+* Name       : void Host_Reg_Close(void)
+* Function   : Unmap the fake register bank
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Host_Reg_Close(void);
+
+/******************************************************************************
+* Name       : volatile uint32_t* Host_Reg_Addr(uint8 u8Idx)
+* Function   : Get the address of one word in the register bank
+* Input      : uint8 u8Idx     0~HOST_REG_NUM-1   Index of the word
+* Output:    : None
+* Return     : Volatile pointer to the word.
+* description: The bank must be mapped with Host_Reg_Open() first. The index is NOT
+*              checked, same as a hardware register address.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+volatile uint32_t* Host_Reg_Addr(uint8 u8Idx);
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Map(uint8 u8Ch, uint8 u8Port, uint8 u8Bit, uint8 u8ActLow)
+* Function   : Bind one button channel to one bit of a port input register
+* Input      : uint8 u8Ch       1~MAX_BTN_CH          The number of button channel
+*              uint8 u8Port     0~HOST_REG_PORT_NUM-1 Port index
+*              uint8 u8Bit      0~31                  Bit index in the port
+*              uint8 u8ActLow   HOST_REG_ACT_LOW      Pin is "0" when pressed
+*                               HOST_REG_ACT_HIGH     Pin is "1" when pressed
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The channel is mapped
+* description: Same as the pin assignment in Btn_St_Get() of the demo.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Map(uint8 u8Ch, uint8 u8Port, uint8 u8Bit, uint8 u8ActLow);
+
+/******************************************************************************
+* Name       : uint8 Host_Reg_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the button state from the fake register bank (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_CH   The number of button channel
+* Output:    : None
+* Return     : BTN_STATE_0      Button state is logic "0"
+*              BTN_STATE_1      Button state is logic "1"
+*              BTN_ERROR        The channel is NOT mapped
+* description: One volatile read of the port register per call.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Host_Reg_Btn_St_Get(uint8 u8Ch);
+
+/******************************************************************************
+* Name       : uint16 Host_Reg_Time(void)
+* Function   : Get the free running tick written by the generator (PF_GET_TM)
+* Input      : None
+* Output:    : None
+* Return     : 0~65535  Lower 16 bits of HOST_REG_TM
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Host_Reg_Time(void);
+
+/******************************************************************************
+* Name       : void Host_Reg_Bit_Write(uint8 u8Port, uint8 u8Bit, uint8 u8Val)
+* Function   : Set or clear one bit of a port input register (generator side)
+* Input      : uint8 u8Port     0~HOST_REG_PORT_NUM-1 Port index
+*              uint8 u8Bit      0~31                  Bit index in the port
+*              uint8 u8Val      0/1                   New value of the bit
+* Output:    : None
+* Return     : None
+* description: Atomic read-modify-write, so several generator threads may drive
+*              different bits of the same port.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Host_Reg_Bit_Write(uint8 u8Port, uint8 u8Bit, uint8 u8Val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_HOST_REG_ */
+
+/* end-of-file */
@@ -0,0 +1,218 @@
+/******************************************************************************
+* File       : Btn_SM_Metrics.c
+* Function   : Render metrics of button state machine in Prometheus text format.
+* description: Please refer to Btn_SM_Metrics.h for details.
+* Version    : V1.02
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Escape the label, check the copy of metrics
+*               3    18/Oct/2026   Ian   V1.02     Export the replication and interlock metrics
+******************************************************************************/
+
+#include <stdio.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Metrics.h"
+
+#ifdef __BTN_SM_METRICS
+
+#define BTN_METRICS_LABEL_LEN        (64)        /* Max length of the label text      */
+#define BTN_METRICS_TEXT_LEN         (2048)      /* Size of text buffer for file      */
+
+/* Description of one metric */
+typedef struct _T_BTN_METRIC_DESC_
+{
+    const char *pcName;             /* Metric name            */
+    const char *pcType;             /* "counter" or "gauge"   */
+    const char *pcHelp;             /* Help text              */
+}T_BTN_METRIC_DESC;
+
+static const T_BTN_METRIC_DESC cg_atMetricDesc[] =
+{
+    {"btn_sm_scans_total",              "counter", "Number of button scans."},
+    {"btn_sm_scan_duration_ticks_total","counter", "Total duration of button scans in ticks."},
+    {"btn_sm_events_total",             "counter", "Number of button events output."},
+    {"btn_sm_errors_total",             "counter", "Number of failed button state readings."},
+    {"btn_sm_scan_duration_ticks",      "gauge",   "Duration of the last button scan in ticks."},
+    {"btn_sm_scan_duration_max_ticks",  "gauge",   "Max duration of button scans in ticks."},
+    {"btn_sm_active_channels",          "gauge",   "Number of buttons NOT idle in the last scan."},
+    {"btn_sm_channels",                 "gauge",   "Number of button channels."},
+#ifdef __BTN_SM_REPLICA
+    {"btn_sm_repl_queue_depth",         "gauge",   "Items in the replication ring NOT applied by the standby."},
+    {"btn_sm_repl_lost_total",          "counter", "Number of changes NOT replicated for the ring was full."},
+#endif
+#ifdef __BTN_SM_INTERLOCK
+    {"btn_sm_suppressed_total",         "counter", "Number of button events suppressed by interlock rules."},
+#endif
+};
+
+#define BTN_METRICS_NUM              (sizeof(cg_atMetricDesc) / sizeof(cg_atMetricDesc[0]))
+
+/******************************************************************************
+* Name       : static uint8 Btn_Metrics_Label(const char *pcUnit, char *pcLabel)
+* Function   : Make the label text of the unit
+* Input      : const char *pcUnit     Value of label "unit"
+* Output:    : char       *pcLabel    Label text, BTN_METRICS_LABEL_LEN bytes
+* Return     : BTN_ERROR              The label is too long
+*              SUCCESS                The label is made
+* description: Backslash, double quote and line feed are escaped as the label
+*              value syntax of Prometheus text format.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Metrics_Label(const char *pcUnit, char *pcLabel)
+{
+    uint32 u32Len;
+    char   cChr;
+
+    u32Len = (uint32)sprintf(pcLabel, "{unit=\"");
+    for(; '\0' != *pcUnit; pcUnit++)
+    {
+        /* Room for 2 bytes of this character and 3 bytes of the end */
+        if(u32Len + 5 > BTN_METRICS_LABEL_LEN)
+        {
+            return BTN_ERROR;
+        }
+        cChr = *pcUnit;
+        if(('\\' == cChr) || ('"' == cChr) || ('\n' == cChr))
+        {
+            pcLabel[u32Len++] = '\\';
+            cChr = ('\n' == cChr) ? 'n' : cChr;
+        }
+        pcLabel[u32Len++] = cChr;
+    }
+    sprintf(&pcLabel[u32Len], "\"}");
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint32 Btn_Metrics_Render(const char *pcUnit, char *pcBuf, uint32 u32Size)
+* Function   : Render the metrics in Prometheus text format
+* Input      : const char *pcUnit     Value of label "unit", NULL for no label
+*              uint32      u32Size    Size of pcBuf
+* Output:    : char       *pcBuf      Rendered text, always terminated with '\0'
+* Return     : 0                      Buffer is too small, parameter is invalid or
+*                                     the metrics were being written
+*              Others                 Length of the text
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Metrics_Render(const char *pcUnit, char *pcBuf, uint32 u32Size)
+{
+    T_BTN_METRICS tMetrics;
+    unsigned long aulVal[BTN_METRICS_NUM];
+    char          acLabel[BTN_METRICS_LABEL_LEN] = "";
+    uint32        u32Len = 0;
+    uint8         u8Idx;
+    int           iRet;
+
+    /* Check if the input parameter is valid or NOT */
+    if((NULL == pcBuf) || (0 == u32Size))
+    {   /* Return if the parameter is invalid */
+        return 0;
+    }
+    pcBuf[0] = '\0';
+
+    if((NULL != pcUnit) && (SUCCESS != Btn_Metrics_Label(pcUnit, acLabel)))
+    {   /* Return if the label is too long */
+        return 0;
+    }
+
+    /* Take one copy, checked to be of one scan */
+    if(SUCCESS != Btn_Metrics_Get(&tMetrics))
+    {
+        return 0;
+    }
+    aulVal[0] = tMetrics.u32ScanCnt;
+    aulVal[1] = tMetrics.u32ScanTmSum;
+    aulVal[2] = tMetrics.u32EvtCnt;
+    aulVal[3] = tMetrics.u32ErrCnt;
+    aulVal[4] = tMetrics.u16ScanTm;
+    aulVal[5] = tMetrics.u16ScanTmMax;
+    aulVal[6] = tMetrics.u8ActiveCh;
+    aulVal[7] = MAX_BTN_CH;
+    u8Idx     = 8;
+#ifdef __BTN_SM_REPLICA
+    aulVal[u8Idx++] = tMetrics.u32ReplDepth;
+    aulVal[u8Idx++] = tMetrics.u32ReplLost;
+#endif
+#ifdef __BTN_SM_INTERLOCK
+    aulVal[u8Idx++] = tMetrics.u32SuppCnt;
+#endif
+
+    for(u8Idx = 0; u8Idx < BTN_METRICS_NUM; u8Idx++)
+    {
+        iRet = snprintf(&pcBuf[u32Len], u32Size - u32Len, "# HELP %s %s\n# TYPE %s %s\n%s%s %lu\n",
+                        cg_atMetricDesc[u8Idx].pcName, cg_atMetricDesc[u8Idx].pcHelp,
+                        cg_atMetricDesc[u8Idx].pcName, cg_atMetricDesc[u8Idx].pcType,
+                        cg_atMetricDesc[u8Idx].pcName, acLabel, aulVal[u8Idx]);
+        if((iRet < 0) || ((uint32)iRet >= u32Size - u32Len))
+        {   /* Buffer is too small */
+            pcBuf[0] = '\0';
+            return 0;
+        }
+        u32Len += (uint32)iRet;
+    }
+    return u32Len;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Metrics_Write(const char *pcUnit, const char *pcPath)
+* Function   : Render the metrics into a file
+* Input      : const char *pcUnit     Value of label "unit", NULL for no label
+*              const char *pcPath     Path of the file (e.g. xxx.prom)
+* Output:    : None
+* Return     : BTN_ERROR              Failed to write the file
+*              SUCCESS                The file is written
+* description: The text is written to "<pcPath>.tmp" and then renamed, so the
+*              collector never reads a half written file.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Metrics_Write(const char *pcUnit, const char *pcPath)
+{
+    char   acText[BTN_METRICS_TEXT_LEN];
+    char   acTmp[FILENAME_MAX];
+    uint32 u32Len;
+    FILE  *ptFile;
+
+    if(NULL == pcPath)
+    {
+        return BTN_ERROR;
+    }
+
+    u32Len = Btn_Metrics_Render(pcUnit, acText, sizeof(acText));
+    if(0 == u32Len)
+    {
+        return BTN_ERROR;
+    }
+
+    snprintf(acTmp, sizeof(acTmp), "%s.tmp", pcPath);
+    ptFile = fopen(acTmp, "w");
+    if(NULL == ptFile)
+    {
+        return BTN_ERROR;
+    }
+    if(fwrite(acText, 1, u32Len, ptFile) != u32Len)
+    {
+        fclose(ptFile);
+        remove(acTmp);
+        return BTN_ERROR;
+    }
+    if((0 != fclose(ptFile)) || (0 != rename(acTmp, pcPath)))
+    {
+        remove(acTmp);
+        return BTN_ERROR;
+    }
+    return SUCCESS;
+}
+
+#endif
+
+/* end-of-file */
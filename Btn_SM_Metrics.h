@@ -0,0 +1,67 @@
+/******************************************************************************
+* File       : Btn_SM_Metrics.h
+* Function   : Render metrics of button state machine in Prometheus text format.
+* description: The metrics are counted inside the module when __BTN_SM_METRICS is
+*              defined (please refer to T_BTN_METRICS). This file renders a copy of
+*              them in Prometheus text exposition format, into a caller buffer or
+*              into a file for the textfile collector of node exporter.
+*              Rates (scans per second, events per second) are derived from the
+*              counters by Prometheus with rate().
+* Version    : V1.02
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Escape the label, check the copy of metrics
+*               3    18/Oct/2026   Ian   V1.02     Export the replication and interlock metrics
+******************************************************************************/
+
+#ifndef _BTN_SM_METRICS_
+#define _BTN_SM_METRICS_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __BTN_SM_METRICS
+/******************************************************************************
+* Name       : uint32 Btn_Metrics_Render(const char *pcUnit, char *pcBuf, uint32 u32Size)
+* Function   : Render the metrics in Prometheus text format
+* Input      : const char *pcUnit     Value of label "unit", NULL for no label
+*              uint32      u32Size    Size of pcBuf
+* Output:    : char       *pcBuf      Rendered text, always terminated with '\0'
+* Return     : 0                      Buffer is too small, parameter is invalid or
+*                                     the metrics were being written
+*              Others                 Length of the text
+* description: The label value is escaped. All values are of the same scan, the
+*              copy is checked by Btn_Metrics_Get().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Metrics_Render(const char *pcUnit, char *pcBuf, uint32 u32Size);
+
+/******************************************************************************
+* Name       : uint8 Btn_Metrics_Write(const char *pcUnit, const char *pcPath)
+* Function   : Render the metrics into a file
+* Input      : const char *pcUnit     Value of label "unit", NULL for no label
+*              const char *pcPath     Path of the file (e.g. xxx.prom)
+* Output:    : None
+* Return     : BTN_ERROR              Failed to write the file
+*              SUCCESS                The file is written
+* description: The text is written to "<pcPath>.tmp" and then renamed, so the
+*              collector never reads a half written file.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Metrics_Write(const char *pcUnit, const char *pcPath);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_METRICS_ */
+
+/* end-of-file */
@@ -32,6 +32,7 @@
 *                      If defined __BTN_SM_SPECIFIED_BTN_ST_FN, each button will use 
 *                      specified button state getting function.
 *              Step 7: Poll "Btn_Channel_Process()" per channel to get events and states.
+*                      Or poll "Btn_Scan_Process()" to process all channels at once.
 *
 *              NOTE: For advanced configuration, please use Btn_General_Init() and
 *                    Btn_channel_Init().
@@ -39,13 +40,48 @@
 *              NOTE: This software is modularization designed, so "Btn_SM_Module.c" and 
 *                    "Btn_SM_Module.h" should work without any modification. 
 *         
-* Version    : V1.10
+* Version    : V1.45
 * Author     : Ian
-* Date       : 15th Jun 2016
+* Date       : 18th Oct 2026
 * History    :  No.  When          Who   Version   What        
 *               1    27/Jan/2016   Ian   V1.00     Create      
 *               2    15/Jun/2016   Ian   V1.10     Re-design the state machine with state
 *                                                  table, return "Event" and "State"                                                          
+*               3    18/Oct/2026   Ian   V1.11     Add flight recorder of channel transitions
+*               4    18/Oct/2026   Ian   V1.12     Add trace hook of input, state and event
+*               5    18/Oct/2026   Ian   V1.13     Add whole scan process and metrics counters
+*               6    18/Oct/2026   Ian   V1.14     Add constant-time scan process for WCET
+*               7    18/Oct/2026   Ian   V1.15     Add channel mode and pulse counter mode
+*               8    18/Oct/2026   Ian   V1.16     Add toggle mode with latch bitmap
+*               9    18/Oct/2026   Ian   V1.17     Add pressed, holding and event bitmaps
+*               10   18/Oct/2026   Ian   V1.18     Add structure-of-arrays scan output
+*               11   18/Oct/2026   Ian   V1.19     Add hold progress of long-press
+*               12   18/Oct/2026   Ian   V1.20     Add scan of channels grouped by mode
+*               13   18/Oct/2026   Ian   V1.21     Sample the time at most once per scan
+*               14   18/Oct/2026   Ian   V1.22     Add sleep and wake-on-press detection
+*               15   18/Oct/2026   Ian   V1.23     Add speculative press events with retraction
+*               16   18/Oct/2026   Ian   V1.24     Add interlock rules of channels
+*               17   18/Oct/2026   Ian   V1.25     Add logical channels of one input
+*               18   18/Oct/2026   Ian   V1.26     Add adaptive long-press time
+*               19   18/Oct/2026   Ian   V1.27     Add replication of states to a standby
+*               20   18/Oct/2026   Ian   V1.28     Add rolling state digest for lockstep check
+*               21   18/Oct/2026   Ian   V1.29     Metrics of all scans, final events and checked copy
+*               22   18/Oct/2026   Ian   V1.30     Check mode and options of channel, time of pulse init
+*               23   18/Oct/2026   Ian   V1.31     Scan duration only with the fine tick
+*               24   18/Oct/2026   Ian   V1.32     Retract suppressed speculative press, tentative on wake
+*               25   18/Oct/2026   Ian   V1.33     End hold-off before the time wraps around
+*               26   18/Oct/2026   Ian   V1.34     Resync snapshot by the scan, default ring barrier
+*               27   18/Oct/2026   Ian   V1.35     Constant-time scan rejects features it does NOT run
+*               28   18/Oct/2026   Ian   V1.36     Interlock rules can NOT be bypassed by the constant-time scan
+*               29   18/Oct/2026   Ian   V1.37     Digest can NOT go stale by the constant-time scan
+*               30   18/Oct/2026   Ian   V1.38     Replication can NOT go stale by the constant-time scan
+*               31   18/Oct/2026   Ian   V1.39     Replicate the enable control of channels
+*               32   18/Oct/2026   Ian   V1.40     Replicate the adapted long-press time
+*               33   18/Oct/2026   Ian   V1.41     Mode and options of channel only with the MACRO using them
+*               34   18/Oct/2026   Ian   V1.42     Time once per pass of the channel process
+*               35   18/Oct/2026   Ian   V1.43     Map the sleep masks to the pins of the ports
+*               36   18/Oct/2026   Ian   V1.44     Count the replication and interlock metrics
+*               37   18/Oct/2026   Ian   V1.45     Reject groups with a source after its logical channel
 ******************************************************************************/
 
 #include "common.h"
@@ -73,143 +109,1478 @@ const uint8 cg_aau8StateMachine[BTN_STATE_NUM][BTN_TRG_NUM] =
     {BTN_L_RELEASE_EVT   , BTN_HOLDING_ST      , BTN_L_RELEASED_EVT   ,  BTN_HOLDING_ST      }     /* BTN_HOLDING          */
 };
 
+#ifdef __BTN_SM_CONST_TIME
+#define BTN_CT_DB_CHECK              (0x01)      /* Check debounce time in this state   */
+#define BTN_CT_LP_CHECK              (0x02)      /* Check long-press time in this state */
+#define BTN_CT_DB_START              (0x04)      /* Start debounce timing in this state */
+#define BTN_CT_LP_START              (0x08)      /* Start long-press timing             */
+
+/* Operations of each state for constant-time process */
+typedef struct _T_BTN_CT_ROW_
+{
+    uint8   u8Evt;                  /* Event output in this state         */
+    uint8   u8St;                   /* State output in this state         */
+    uint8   u8Flag;                 /* BTN_CT_XXX operations              */
+}T_BTN_CT_ROW;
+
+/* Same operations as Btn_Channel_Process(), one row per state */
+static const T_BTN_CT_ROW cg_atCtRow[BTN_STATE_NUM] =
+{
+    {BTN_NONE_EVT        , BTN_PRESS_PRE_ST    , BTN_CT_DB_START},    /* BTN_PRESS_EVT        */
+    {BTN_NONE_EVT        , BTN_SHORT_RELEASE_ST, BTN_CT_DB_START},    /* BTN_S_RELEASE_EVT    */
+    {BTN_NONE_EVT        , BTN_LONG_RELEASE_ST , BTN_CT_DB_START},    /* BTN_L_RELEASE_EVT    */
+    {BTN_PRESSED_EVT     , BTN_PRESS_AFT_ST    , BTN_CT_LP_START},    /* BTN_PRESSED_EVT      */
+    {BTN_LONG_PRESSED_EVT, BTN_HOLDING_ST      , 0              },    /* BTN_LONG_PRESSED_EVT */
+    {BTN_S_RELEASED_EVT  , BTN_IDLE_ST         , 0              },    /* BTN_S_RELEASED_EVT   */
+    {BTN_L_RELEASED_EVT  , BTN_IDLE_ST         , 0              },    /* BTN_L_RELEASED_EVT   */
+    {BTN_NONE_EVT        , BTN_IDLE_ST         , BTN_CT_DB_CHECK},    /* BTN_PRESS_PRE        */
+    {BTN_NONE_EVT        , BTN_PRESS_AFT_ST    , BTN_CT_DB_CHECK},    /* BTN_SHORT_RELEASE    */
+    {BTN_NONE_EVT        , BTN_HOLDING_ST      , BTN_CT_DB_CHECK},    /* BTN_LONG_RELEASE     */
+    {BTN_NONE_EVT        , BTN_IDLE_ST         , 0              },    /* BTN_IDLE             */
+    {BTN_NONE_EVT        , BTN_PRESS_AFT_ST    , BTN_CT_LP_CHECK},    /* BTN_PRESS_AFT        */
+    {BTN_NONE_EVT        , BTN_HOLDING_ST      , 0              }     /* BTN_HOLDING          */
+};
+#endif
+
 static T_BTN_PARA *sg_aptBtnPara[MAX_BTN_CH] = {0};          /* Parameter interface          */
 static T_BTN_ST    sg_atBtnSt[MAX_BTN_CH]    = {0};          /* Running status               */
 static PF_GET_TM   sg_pfGetTm                = NULL;         /* Function to get general time */
+static uint16      sg_u16ScanTm              = 0;            /* Time of the current scan     */
+static uint8       sg_u8TmValid              = 0;            /* sg_u16ScanTm is got          */
+static uint8       sg_u8TmSet                = 0;            /* Time is given by the caller  */
+static uint8       sg_u8TmCh                 = 0xFF;         /* Last channel of the pass     */
 
 #ifndef __BTN_SM_SPECIFIED_BTN_ST_FN
 static PF_GET_BTN  sg_pfGetBtnSt             = NULL;         /* Function to get button state */
 #endif
 
+#ifdef __BTN_SM_FLIGHT_RECORDER
+static T_BTN_REC     *sg_aptBtnRec[MAX_BTN_CH] = {0};        /* Flight recorder of channels  */
+static PF_BTN_REC_OUT sg_pfRecFault            = NULL;       /* Function to dump on fault    */
+#endif
+
+#ifdef __BTN_SM_TRACE
+static PF_BTN_TRACE   sg_pfTrace               = NULL;       /* Trace hook                   */
+#endif
+
+#ifdef __BTN_SM_PULSE_CNT
+static T_BTN_PULSE   *sg_aptBtnPulse[MAX_BTN_CH] = {0};      /* Pulse counter of channels    */
+#endif
+
+#ifdef __BTN_SM_TOGGLE
+static uint32         sg_au32BtnLatch[BTN_MAP_WORDS] = {0};  /* Latch of toggle channels     */
+#endif
+
+#ifdef __BTN_SM_LOGICAL
+#define BTN_SRC_CH(ptBtnPara)        ((ptBtnPara)->u8SrcCh)  /* Source of logical channel    */
+#else
+#define BTN_SRC_CH(ptBtnPara)        (0)                     /* All channels are physical    */
+#endif
+
+#ifdef __BTN_SM_CH_MODE
+#define BTN_CH_MODE(ptBtnPara)       ((ptBtnPara)->u8Mode)   /* Mode of the channel          */
+#else
+#define BTN_CH_MODE(ptBtnPara)       (BTN_MODE_NORMAL)       /* All channels are normal      */
+#endif
+
+#if defined(__BTN_SM_BITMAP) || defined(__BTN_SM_LOGICAL)
+/* States in which the channel is debounced pressed, bit N is state N */
+#define BTN_MAP_PRESSED_ST           ((1 << BTN_S_RELEASE_EVT)    | (1 << BTN_L_RELEASE_EVT)    | \
+                                      (1 << BTN_PRESSED_EVT)      | (1 << BTN_LONG_PRESSED_EVT) | \
+                                      (1 << BTN_SHORT_RELEASE_ST) | (1 << BTN_LONG_RELEASE_ST)  | \
+                                      (1 << BTN_PRESS_AFT_ST)     | (1 << BTN_HOLDING_ST))
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+#define BTN_LP_FRAC                  (4)         /* Fraction bits of the estimate        */
+#define BTN_LP_STEP_MAX              (64 << BTN_LP_FRAC)  /* Max step of the estimate    */
+#define BTN_LP_DIR_UP                (1)         /* The last step is up                  */
+#define BTN_LP_DIR_DOWN              (2)         /* The last step is down                */
+#endif
+
+#ifdef __BTN_SM_REPLICA
+#if BTN_REPL_LEN < MAX_BTN_CH
+#error "BTN_REPL_LEN must hold a snapshot of all channels"
+#endif
+#endif
+
+#ifdef __BTN_SM_CONST_TIME
+#if defined(__BTN_SM_PULSE_CNT) || defined(__BTN_SM_TOGGLE) || defined(__BTN_SM_SPECULATIVE) || \
+    defined(__BTN_SM_LOGICAL)   || defined(__BTN_SM_LP_ADAPT)
+#error "Btn_Scan_Process_CT() runs normal channels only, NOT modes, options, logical channels or calibration"
+#endif
+#ifdef __BTN_SM_INTERLOCK
+#error "Btn_Scan_Process_CT() does NOT check the interlock rules, they would be bypassed"
+#endif
+#ifdef __BTN_SM_DIGEST
+#error "Btn_Scan_Process_CT() does NOT update the digest, it would go stale"
+#endif
+#ifdef __BTN_SM_REPLICA
+#error "Btn_Scan_Process_CT() does NOT replicate, the standby would go stale"
+#endif
+#endif
+
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+/* States in which the timers are running, bit N is state N */
+#define BTN_DIG_DB_ST                ((1 << BTN_PRESS_PRE_ST)     | (1 << BTN_SHORT_RELEASE_ST) | \
+                                      (1 << BTN_LONG_RELEASE_ST))
+#define BTN_DIG_LP_ST                ((1 << BTN_PRESS_AFT_ST)     | (1 << BTN_SHORT_RELEASE_ST))
+#endif
+
+/* Options enabled by their MACRO */
+#ifdef __BTN_SM_SPECULATIVE
+#define BTN_OPT_EN                   (BTN_OPT_SPECULATIVE)
+#else
+#define BTN_OPT_EN                   (0)
+#endif
+
+#ifdef __BTN_SM_METRICS
+#define BTN_METRICS_TRY              (16)        /* Tries of Btn_Metrics_Get()           */
+#endif
+
+#ifdef __BTN_SM_BITMAP
+/* States in which the channel is long pressed, bit N is state N */
+#define BTN_MAP_HOLDING_ST           ((1 << BTN_L_RELEASE_EVT)    | (1 << BTN_LONG_PRESSED_EVT) | \
+                                      (1 << BTN_LONG_RELEASE_ST)  | (1 << BTN_HOLDING_ST))
+
+/* Put the value(0/1) of one channel into a bitmap without branch */
+#define BTN_MAP_PUT(u8Map, u8Word, u32Bit, u8Val)                                   \
+    (sg_aau32BtnMap[u8Map][u8Word] = (sg_aau32BtnMap[u8Map][u8Word] & ~(u32Bit))    \
+                                   | ((uint32)(0 - (uint32)(u8Val)) & (u32Bit)))
+
+static uint32         sg_aau32BtnMap[BTN_MAP_NUM][BTN_MAP_WORDS] = {{0}};  /* Channel bitmaps  */
+#endif
+
+#ifdef __BTN_SM_HOLD_PROGRESS
+static uint16         sg_u16HoldTm             = 0;          /* Last time got for long-press */
+#endif
+
+#ifdef __BTN_SM_GROUP
+static uint8          sg_au8GrpCh[MAX_BTN_CH];               /* Channels sorted by mode      */
+static uint8          sg_au8GrpEnd[BTN_MODE_NUM];            /* End of each mode in the list */
+static uint8          sg_u8GrpOk               = 0;          /* Groups are built             */
+#endif
+
+#ifdef __BTN_SM_SPECULATIVE
+static uint16         sg_au16SpecTent[MAX_BTN_CH]    = {0};  /* Tentative press counters     */
+static uint16         sg_au16SpecRetract[MAX_BTN_CH] = {0};  /* Retracted press counters     */
+#ifdef __BTN_SM_SLEEP
+static uint32         sg_au32SpecWake[BTN_MAP_WORDS] = {0};  /* Pressed in sleep, NOT reported */
+#endif
+#endif
+
+#ifdef __BTN_SM_INTERLOCK
+static T_BTN_RULE    *sg_ptRule                = NULL;       /* Interlock rules              */
+static uint8          sg_u8RuleNum             = 0;          /* Number of rules              */
+static uint8          sg_u8RuleArmed           = 0;          /* Some hold-off is being timed */
+static uint32         sg_au32RuleSupp[BTN_MAP_WORDS] = {0};  /* Channels with suppressed press */
+static uint32         sg_u32RuleSuppCnt        = 0;          /* Suppressed events            */
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+static T_BTN_LP_CAL  *sg_aptLpCal[MAX_BTN_CH] = {0};         /* Long-press calibration       */
+#endif
+
+#ifdef __BTN_SM_REPLICA
+static T_BTN_REPL_RING *sg_ptReplRing          = NULL;       /* Ring of the primary          */
+static uint8          sg_u8ReplSnap            = 0;          /* A snapshot is to be written  */
+static uint8          sg_u8ReplOk              = SUCCESS;    /* Standby is in sync           */
+#endif
+
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+static uint32         sg_u32Digest             = 0;          /* Digest of all channels       */
+static uint32         sg_au32DigHash[MAX_BTN_CH] = {0};      /* Hash of each channel         */
+#endif
+
+#ifdef __BTN_SM_DIGEST
+static uint32         sg_au32DigGrp[BTN_MAP_WORDS] = {0};    /* Digest of each 32 channels   */
+#endif
+
+#ifdef __BTN_SM_METRICS
+static T_BTN_METRICS  sg_tMetrics              = {0};        /* Metrics counters and gauges  */
+static volatile uint32 sg_u32MetricsSeq        = 0;          /* Odd while metrics are written*/
+static uint32         sg_u32MetricsEvt         = 0;          /* Events NOT published yet     */
+static uint32         sg_u32MetricsErr         = 0;          /* Errors NOT published yet     */
+static uint8          sg_u8MetricsActive       = 0;          /* Channels NOT idle in the scan*/
+static PF_GET_TM      sg_pfGetTick             = NULL;       /* Clock for scan duration      */
+#endif
+
 /******************************************************************************
-* Name       : void Btn_Func_En_Dis(uint8 u8Ch, uint8 u8EnDis)
-* Function   : Enable or disable button function
-* Input      : uint8 u8Ch       1~255               The number of setting button channel
-*              uint8 u8EnDis    BTN_FUNC_ENABLE     Enable the button function
-*                               BTN_FUNC_DISABLE    Disable the button function
+* Name       : static uint16 Btn_Tm_Get(void)
+* Function   : Get the general time of the current scan
+* Input      : None
 * Output:    : None
-* Return     : None
-* description: If the button function is enabled, the button events and states could
-*              be returned according to the button operation; If the button function 
-*              is disabled, the returned event and state will be BTN_NONE_EVT and 
-*              BTN_DIS_STeven button is operated. 
+* Return     : 0~65535     The general time
+* description: "pfGetTm()" is called at the first use in a scan only, so a scan with
+*              no channel in timing calls it never.
 * Version    : V1.00
 * Author     : Ian
-* Date       : 27th Jan 2016
+* Date       : 18th Oct 2026
 ******************************************************************************/
-void Btn_Func_En_Dis(uint8 u8Ch, uint8 u8EnDis)
-{   
-    sg_aptBtnPara[u8Ch - 1]->u8BtnEn = u8EnDis;      /* Enable or Disable the button functions */
-    sg_atBtnSt[u8Ch - 1].u8BtnSt     = BTN_IDLE_ST;  /* Reset the state machine of button      */
+static uint16 Btn_Tm_Get(void)
+{
+    if(0 == sg_u8TmValid)
+    {
+        sg_u16ScanTm = sg_pfGetTm();
+        sg_u8TmValid = 1;
+    }
+    return sg_u16ScanTm;
 }
 
+#ifdef __BTN_SM_INTERLOCK
 /******************************************************************************
-* Name       : uint8 Btn_General_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
-* Function   : General init operation of button state machine.
-* Input      : PF_GET_TM pfGetTm       Function to get gengeral time
-*              PF_GET_BTN pfGetBtnSt   Function to get button state(0/1)
+* Name       : static void Btn_Rule_Expire(void)
+* Function   : End the hold-off of the rules whose time is out
+* Input      : None
 * Output:    : None
-* Return     : BTN_ERROR               Input parameter is invalid
-*              SUCCESS                 Init operation is successed
-* description: This function should be called once before use button checking.
-*              This function get two necessary interface function: 
-*              "pfGetTm()":Function to get gengeral time;
-*              "pfGetBtnSt":Function to get button state(0/1). (if the MACRO 
-*              __BTN_SM_SPECIFIED_BTN_ST_FN is NOT defined)
-*
-*              NOTE:If the general init is failed, DO NOT continue!!
+* Return     : None
+* description: The time of the source press is only 16 bits, so the hold-off
+*              must end before the general time wraps around (65536 units), or
+*              a press long after would be suppressed again.
 * Version    : V1.00
 * Author     : Ian
-* Date       : 27th Jan 2016
+* Date       : 18th Oct 2026
 ******************************************************************************/
-uint8 Btn_General_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+static void Btn_Rule_Expire(void)
 {
-    /* Check if the input parameter is valid or NOT */
-    if(NULL == pfGetTm) 
-    {   /* Return if the parameter is invalid */
-        return BTN_ERROR;
+    T_BTN_RULE *ptRule;
+    uint8       u8Rule, u8Armed = 0;
+
+    for(u8Rule = 0; u8Rule < sg_u8RuleNum; u8Rule++)
+    {
+        ptRule = &(sg_ptRule[u8Rule]);
+        if(ptRule->u8Armed && ((uint16)(Btn_Tm_Get() - ptRule->u16SrcTm) >= ptRule->u16HoldTm))
+        {   /* The hold-off is over */
+            ptRule->u8Armed = 0;
+        }
+        u8Armed |= ptRule->u8Armed;
     }
-    
-    /* If the "Get time" function has NOT registered yet */
-    if(NULL == sg_pfGetTm)
-    {   /* Register the function */
-        sg_pfGetTm = pfGetTm;
+    sg_u8RuleArmed = u8Armed;
+}
+#endif
+
+
+#ifdef __BTN_SM_PULSE_CNT
+/******************************************************************************
+* Name       : static void Btn_Pulse_Count(T_BTN_PULSE *ptPulse, T_BTN_RESULT* ptBtnRes)
+* Function   : Count the edge and close the measure window of a pulse counter
+* Input      : T_BTN_PULSE  *ptPulse    Pulse counter of the channel, may be NULL
+* Output:    : T_BTN_RESULT *ptBtnRes   Event is consumed here
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Pulse_Count(T_BTN_PULSE *ptPulse, T_BTN_RESULT* ptBtnRes)
+{
+    uint16 u16Tm;
+    uint8  u8Evt = ptBtnRes->u8Evt;
+
+    ptBtnRes->u8Evt = BTN_NONE_EVT;           /* Events of pulse counter are NOT output */
+    if(NULL == ptPulse)
+    {   /* Counter is NOT attached yet */
+        return;
     }
-    /* If the "Get time" function has already registered, Do NOT re-register */
 
+    u16Tm = Btn_Tm_Get();
+    if(BTN_PRESSED_EVT == u8Evt)
+    {   /* One debounced edge */
+        ptPulse->u32Cnt++;
+        ptPulse->u32WinCnt++;
+        ptPulse->u16Period = u16Tm - ptPulse->u16EdgeTm;
+        ptPulse->u16EdgeTm = u16Tm;
+    }
 
-#ifndef __BTN_SM_SPECIFIED_BTN_ST_FN
-    /* Check if the input parameter is valid or NOT */
-    if(NULL == pfGetBtnSt) 
-    {   /* Return if the parameter is invalid */
-        return BTN_ERROR;
-    }   
+    /* If the measure window is over */
+    if((uint16)(u16Tm - ptPulse->u16WinStartTm) >= ptPulse->u16WinTm)
+    {
+        ptPulse->u16Freq       = (uint16)((ptPulse->u32WinCnt * 1000) / ptPulse->u16WinTm);
+        ptPulse->u32WinCnt     = 0;
+        ptPulse->u16WinStartTm = u16Tm;
+    }
+}
+#endif
 
-    /* If the "Get button state" function has NOT registered yet */
-    if(NULL == sg_pfGetBtnSt)
-    {   /* Register the function */
-        sg_pfGetBtnSt = pfGetBtnSt;
+#ifdef __BTN_SM_BITMAP
+/******************************************************************************
+* Name       : static void Btn_Map_Update(uint8 u8Idx, uint8 u8OldSt, uint8 u8NewSt,
+*                                         uint8 u8Evt)
+* Function   : Update the bitmaps of one channel after its process
+* Input      : uint8 u8Idx     0~MAX_BTN_CH-1   Index of the channel
+*              uint8 u8OldSt                    State before the process
+*              uint8 u8NewSt                    State after the process
+*              uint8 u8Evt                      Event of the process
+* Output:    : None
+* Return     : None
+* description: The words are written only if the state or the event changes.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Map_Update(uint8 u8Idx, uint8 u8OldSt, uint8 u8NewSt, uint8 u8Evt)
+{
+    uint32 u32Bit = (uint32)1 << (u8Idx & 31);
+    uint8  u8Word = u8Idx >> 5;
+    uint8  u8EvtBit;
+
+    if(u8OldSt != u8NewSt)
+    {
+        BTN_MAP_PUT(BTN_MAP_PRESSED, u8Word, u32Bit, (BTN_MAP_PRESSED_ST >> u8NewSt) & 1);
+        BTN_MAP_PUT(BTN_MAP_HOLDING, u8Word, u32Bit, (BTN_MAP_HOLDING_ST >> u8NewSt) & 1);
     }
-    /* If the "Get button state" function has already registered, Do NOT re-regiter */
+
+    u8EvtBit = (BTN_NONE_EVT != u8Evt);
+    if(u8EvtBit != (0 != (sg_aau32BtnMap[BTN_MAP_EVT][u8Word] & u32Bit)))
+    {
+        sg_aau32BtnMap[BTN_MAP_EVT][u8Word] ^= u32Bit;
+    }
+}
+
+/******************************************************************************
+* Name       : static void Btn_Map_Clear(uint8 u8Idx)
+* Function   : Clear one channel in all bitmaps kept by process
+* Input      : uint8 u8Idx     0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Map_Clear(uint8 u8Idx)
+{
+    uint8 u8Map;
+
+    for(u8Map = 0; u8Map < BTN_MAP_NUM; u8Map++)
+    {
+        sg_aau32BtnMap[u8Map][u8Idx >> 5] &= ~((uint32)1 << (u8Idx & 31));
+    }
+#ifdef __BTN_SM_INTERLOCK
+    sg_au32RuleSupp[u8Idx >> 5] &= ~((uint32)1 << (u8Idx & 31));
+#endif
+}
+
+/******************************************************************************
+* Name       : static uint8 Btn_Bit_Cnt(uint32 u32Word)
+* Function   : Count the bits set in a word (popcount)
+* Input      : uint32 u32Word   The word, only lower 32 bits are used
+* Output:    : None
+* Return     : 0~32             Number of bits set
+* description: Use the compiler builtin if there is one.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Bit_Cnt(uint32 u32Word)
+{
+#ifdef __GNUC__
+    return (uint8)__builtin_popcountl((unsigned long)u32Word);
 #else
-    /* If each button use specified button state getting function*/
-    /* pfGetBtnSt will be useless                                */
-    (void)pfGetBtnSt;             /* Avoid warning from complier */
+    u32Word = u32Word - ((u32Word >> 1) & 0x55555555);
+    u32Word = (u32Word & 0x33333333) + ((u32Word >> 2) & 0x33333333);
+    u32Word = (u32Word + (u32Word >> 4)) & 0x0F0F0F0F;
+    return (uint8)(((u32Word * 0x01010101) & 0xFFFFFFFF) >> 24);
 #endif
+}
 
-    return SUCCESS;
+/******************************************************************************
+* Name       : static uint8 Btn_Bit_First(uint32 u32Word)
+* Function   : Find the lowest bit set in a word (count trailing zeros)
+* Input      : uint32 u32Word   The word, must NOT be 0
+* Output:    : None
+* Return     : 0~31             Index of the lowest bit set
+* description: Use the compiler builtin if there is one.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Bit_First(uint32 u32Word)
+{
+#ifdef __GNUC__
+    return (uint8)__builtin_ctzl((unsigned long)u32Word);
+#else
+    uint8 u8Bit = 0;
+
+    if(0 == (u32Word & 0xFFFF)) { u32Word >>= 16; u8Bit += 16; }
+    if(0 == (u32Word & 0x00FF)) { u32Word >>= 8;  u8Bit += 8;  }
+    if(0 == (u32Word & 0x000F)) { u32Word >>= 4;  u8Bit += 4;  }
+    if(0 == (u32Word & 0x0003)) { u32Word >>= 2;  u8Bit += 2;  }
+    if(0 == (u32Word & 0x0001)) {                 u8Bit += 1;  }
+    return u8Bit;
+#endif
 }
 
 /******************************************************************************
-* Name       : uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara)
-* Function   : Init operation for each button channel
-* Input      : uint8       u8Ch      1~255      The number of setting button channel
-*              T_BTN_PARA *ptBtnPara             Parameter of each button channel
+* Name       : static const uint32* Btn_Map_Ptr(uint8 u8Map)
+* Function   : Get the words of one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
 * Output:    : None
-* Return     : BTN_ERROR        Input parameter is invalid
-*              SUCCESS          Init operation is successed
-* description: After general init operation, call this function for each channel
-*              before button checking.  
-*              This function save the parameter structure pointer for further 
-*              operation, and init running state of such channel.
-*
-*              NOTE:If the channel init is failed, DO NOT continue!!
+* Return     : Words of the bitmap, NULL if u8Map is invalid
+* description: None.
 * Version    : V1.00
 * Author     : Ian
-* Date       : 27th Jan 2016
+* Date       : 18th Oct 2026
 ******************************************************************************/
-uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara)
-{   
-    /* Check if the channel number is invalid */
-    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
-    {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
-        return BTN_ERROR;
+static const uint32* Btn_Map_Ptr(uint8 u8Map)
+{
+#ifdef __BTN_SM_TOGGLE
+    if(BTN_MAP_LATCH == u8Map)
+    {
+        return sg_au32BtnLatch;
     }
+#endif
+    if(u8Map >= BTN_MAP_NUM)
+    {
+        return NULL;
+    }
+    return sg_aau32BtnMap[u8Map];
+}
+#endif
 
-    /* Check if the input parameter is invalid */
-    if(NULL == ptBtnPara)
-    {   /* Return error if parameter is invalid */
-        return BTN_ERROR;
+#ifdef __BTN_SM_HOLD_PROGRESS
+/******************************************************************************
+* Name       : static uint16 Btn_Hold_Progress(uint8 u8Idx)
+* Function   : Compute the progress of one channel in BTN_PRESS_AFT_ST
+* Input      : uint8 u8Idx   0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : 0~0xFFFF      Elapsed / u16LongPressTm in Q0.16
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint16 Btn_Hold_Progress(uint8 u8Idx)
+{
+    uint16 u16Elapse = sg_u16HoldTm - sg_atBtnSt[u8Idx].u16LongPressOldTm;
+    uint16 u16LpTm   = sg_aptBtnPara[u8Idx]->u16LongPressTm;
+
+    if(u16Elapse >= u16LpTm)
+    {   /* Long-press time is reached */
+        return 0xFFFF;
     }
+    return (uint16)(((uint32)u16Elapse << 16) / u16LpTm);
+}
+#endif
 
-#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN
-    /* Check if the input parameter is invalid */
-    if(NULL == ptBtnPara->pfGetBtnSt)
-    {   /* Return error if parameter is invalid */
-        return BTN_ERROR;
+#ifdef __BTN_SM_GROUP
+/******************************************************************************
+* Name       : static uint8 Btn_Group_Mode(uint8 u8Mode)
+* Function   : Get the group of a channel mode
+* Input      : uint8 u8Mode    Mode of the channel
+* Output:    : None
+* Return     : BTN_MODE_XXX    Group of the mode
+* description: Modes NOT enabled by their MACRO are handled as BTN_MODE_NORMAL.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Group_Mode(uint8 u8Mode)
+{
+#ifdef __BTN_SM_PULSE_CNT
+    if(BTN_MODE_PULSE == u8Mode)
+    {
+        return BTN_MODE_PULSE;
+    }
+#endif
+#ifdef __BTN_SM_TOGGLE
+    if(BTN_MODE_TOGGLE == u8Mode)
+    {
+        return BTN_MODE_TOGGLE;
     }
+#endif
+    (void)u8Mode;
+    return BTN_MODE_NORMAL;
+}
 #endif
 
-    sg_aptBtnPara[u8Ch - 1]      = ptBtnPara;   /* Get the parameters              */
-    sg_atBtnSt[u8Ch - 1].u8BtnSt = BTN_IDLE_ST; /* Init the state of state machine */    
+#ifdef __BTN_SM_INTERLOCK
+/******************************************************************************
+* Name       : static uint8 Btn_Rule_Active(const T_BTN_RULE *ptRule, uint8 u8Word,
+*                                           uint32 u32Self)
+* Function   : Check if any source of a rule is active
+* Input      : const T_BTN_RULE *ptRule    The rule
+*              uint8             u8Word    Word of the checking channel
+*              uint32            u32Self   Bit of the checking channel, excluded
+* Output:    : None
+* Return     : 1: Some source is active, 0: NOT
+* description: Only the words between the first and last source are checked.
+*              Suppressed channels are NOT active.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Rule_Active(const T_BTN_RULE *ptRule, uint8 u8Word, uint32 u32Self)
+{
+    const uint32 *pu32Map = Btn_Map_Ptr(ptRule->u8Map);
+    uint32        u32Any  = 0;
+    uint8         u8Idx;
 
-    return SUCCESS;
+    for(u8Idx = ptRule->u8First; u8Idx <= ptRule->u8Last; u8Idx++)
+    {
+        u32Any |= pu32Map[u8Idx] & ptRule->au32Src[u8Idx] & ~sg_au32RuleSupp[u8Idx]
+                & ~((u8Idx == u8Word) ? u32Self : 0);
+    }
+    return (uint8)(0 != u32Any);
 }
 
 /******************************************************************************
-* Name       : uint8 Btn_Channel_Process(uint8 u8Ch, T_BTN_RESULT* ptBtnRes)
-* Function   : Main process of button checking
-* Input      : uint8         u8Ch       1~255                 The number of setting button channel
+* Name       : static void Btn_Rule_Check(uint8 u8Idx, T_BTN_RESULT* ptBtnRes)
+* Function   : Check the interlock rules on one event
+* Input      : uint8         u8Idx      0~MAX_BTN_CH-1   Index of the channel
+* Output:    : T_BTN_RESULT* ptBtnRes                    Event is set to
+*                                                        BTN_NONE_EVT if suppressed
+* Return     : None
+* description: Please refer to Btn_Rule_Init().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Rule_Check(uint8 u8Idx, T_BTN_RESULT* ptBtnRes)
+{
+    T_BTN_RULE *ptRule;
+    uint8       u8Word = u8Idx >> 5;
+    uint32      u32Bit = (uint32)1 << (u8Idx & 31);
+    uint32      u32Dst;
+    uint8       u8Rule, u8Supp = 0;
+
+    /* The press of the channel was suppressed, until it is released */
+    if(sg_au32RuleSupp[u8Word] & u32Bit)
+    {
+        if((BTN_S_RELEASED_EVT == ptBtnRes->u8Evt) || (BTN_L_RELEASED_EVT == ptBtnRes->u8Evt))
+        {
+            sg_au32RuleSupp[u8Word] &= ~u32Bit;
+        }
+        ptBtnRes->u8Evt = BTN_NONE_EVT;
+        sg_u32RuleSuppCnt++;
+        return;
+    }
+
+    /* Only a press is checked */
+    if(BTN_PRESSED_EVT != ptBtnRes->u8Evt)
+    {
+        return;
+    }
+
+    for(u8Rule = 0; (u8Rule < sg_u8RuleNum) && (0 == u8Supp); u8Rule++)
+    {
+        ptRule = &(sg_ptRule[u8Rule]);
+        u32Dst = (BTN_RULE_EXCLUSIVE == ptRule->u8Type) ? ptRule->au32Src[u8Word] : ptRule->au32Dst[u8Word];
+        if(0 == (u32Dst & u32Bit))
+        {   /* NOT a target of the rule */
+            continue;
+        }
+        if(BTN_RULE_HOLDOFF == ptRule->u8Type)
+        {
+            u8Supp = (uint8)(ptRule->u8Armed && ((uint16)(Btn_Tm_Get() - ptRule->u16SrcTm) < ptRule->u16HoldTm));
+        }
+        else
+        {
+            u8Supp = Btn_Rule_Active(ptRule, u8Word, u32Bit);
+        }
+        if(u8Supp)
+        {
+            ptRule->u32SuppCnt++;
+        }
+    }
+
+    if(u8Supp)
+    {   /* Suppress the press and the events until release */
+        sg_au32RuleSupp[u8Word] |= u32Bit;
+        ptBtnRes->u8Evt = BTN_NONE_EVT;
+        sg_u32RuleSuppCnt++;
+        return;
+    }
+
+    /* The press is delivered, start the hold-off of the rules it is a source of */
+    for(u8Rule = 0; u8Rule < sg_u8RuleNum; u8Rule++)
+    {
+        ptRule = &(sg_ptRule[u8Rule]);
+        if((BTN_RULE_HOLDOFF == ptRule->u8Type) && (ptRule->au32Src[u8Word] & u32Bit))
+        {
+            ptRule->u16SrcTm = Btn_Tm_Get();
+            ptRule->u8Armed  = 1;
+            sg_u8RuleArmed   = 1;
+        }
+    }
+}
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+/******************************************************************************
+* Name       : static void Btn_Lp_Cal_Start(T_BTN_LP_CAL *ptCal, uint16 u16LongTm)
+* Function   : Start the quantile estimate from a long-press time
+* Input      : uint16        u16LongTm   Long-press time to start from
+* Output:    : T_BTN_LP_CAL *ptCal       The estimate and the long-press time
+* Return     : None
+* description: The time is limited to u16MinTm~u16MaxTm. u32Cnt is NOT changed.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Lp_Cal_Start(T_BTN_LP_CAL *ptCal, uint16 u16LongTm)
+{
+    u16LongTm = (u16LongTm < ptCal->u16MinTm) ? ptCal->u16MinTm : u16LongTm;
+    u16LongTm = (u16LongTm > ptCal->u16MaxTm) ? ptCal->u16MaxTm : u16LongTm;
+    ptCal->u16LongTm = u16LongTm;
+    ptCal->u32Est    = (u16LongTm > ptCal->u16Margin) ? ((uint32)(u16LongTm - ptCal->u16Margin) << BTN_LP_FRAC) : 0;
+    ptCal->u16Step   = 1 << BTN_LP_FRAC;
+    ptCal->u8Dir     = 0;
+}
+
+/******************************************************************************
+* Name       : static void Btn_Lp_Cal_Put(T_BTN_LP_CAL *ptCal, uint16 u16Hold)
+* Function   : Put one hold time of short press into the quantile estimate
+* Input      : uint16        u16Hold   Hold time of the short press
+* Output:    : T_BTN_LP_CAL *ptCal     The estimate and the long-press time
+* Return     : None
+* description: Please refer to Btn_Lp_Cal_Init().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Lp_Cal_Put(T_BTN_LP_CAL *ptCal, uint16 u16Hold)
+{
+    uint32 u32Hold = (uint32)u16Hold << BTN_LP_FRAC;
+    uint32 u32Delta;
+    uint8  u8Dir;
+
+    if(u32Hold == ptCal->u32Est)
+    {
+        ptCal->u32Cnt++;
+        return;
+    }
+    u8Dir = (u32Hold > ptCal->u32Est) ? BTN_LP_DIR_UP : BTN_LP_DIR_DOWN;
+
+    /* Grow the step while it moves the same way, halve it when it turns */
+    if(u8Dir == ptCal->u8Dir)
+    {
+        ptCal->u16Step = (ptCal->u16Step >= (BTN_LP_STEP_MAX >> 1)) ? BTN_LP_STEP_MAX : (ptCal->u16Step << 1);
+    }
+    else
+    {
+        ptCal->u16Step = (ptCal->u16Step > (1 << BTN_LP_FRAC)) ? (ptCal->u16Step >> 1) : (1 << BTN_LP_FRAC);
+    }
+    ptCal->u8Dir = u8Dir;
+
+    /* Up and down steps in the ratio of the quantile, NOT beyond the sample */
+    if(BTN_LP_DIR_UP == u8Dir)
+    {
+        u32Delta       = ((uint32)ptCal->u16Step * ptCal->u8Quantile + 50) / 100;
+        ptCal->u32Est += u32Delta;
+        ptCal->u32Est  = (ptCal->u32Est > u32Hold) ? u32Hold : ptCal->u32Est;
+    }
+    else
+    {
+        u32Delta       = ((uint32)ptCal->u16Step * (100 - ptCal->u8Quantile) + 50) / 100;
+        ptCal->u32Est  = (ptCal->u32Est > u32Hold + u32Delta) ? (ptCal->u32Est - u32Delta) : u32Hold;
+    }
+    ptCal->u32Cnt++;
+
+    /* The long-press time sits the margin above the quantile, within bounds */
+    u32Delta = (ptCal->u32Est >> BTN_LP_FRAC) + ptCal->u16Margin;
+    u32Delta = (u32Delta < ptCal->u16MinTm) ? ptCal->u16MinTm : u32Delta;
+    ptCal->u16LongTm = (uint16)((u32Delta > ptCal->u16MaxTm) ? ptCal->u16MaxTm : u32Delta);
+}
+
+/******************************************************************************
+* Name       : static void Btn_Lp_Cal_Evt(T_BTN_LP_CAL *ptCal, T_BTN_PARA *ptBtnPara,
+*                                         const T_BTN_ST *ptBtnSt)
+* Function   : Calibrate the long-press time on one event of a channel
+* Input      : const T_BTN_ST *ptBtnSt    Running status, u8BtnSt is the event
+* Output:    : T_BTN_LP_CAL   *ptCal      The calibration
+*              T_BTN_PARA     *ptBtnPara  u16LongPressTm is set on BTN_PRESSED_EVT
+* Return     : None
+* description: The hold time is from BTN_PRESSED_EVT to the start of the release
+*              debounce, the same time the long-press time is checked against.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Lp_Cal_Evt(T_BTN_LP_CAL *ptCal, T_BTN_PARA *ptBtnPara, const T_BTN_ST *ptBtnSt)
+{
+    uint16 u16Hold = ptBtnSt->u16DebounceOldTm - ptBtnSt->u16LongPressOldTm;
+
+    if(BTN_PRESSED_EVT == ptBtnSt->u8BtnSt)
+    {   /* The new press uses the time in use */
+        ptBtnPara->u16LongPressTm = ptCal->u16LongTm;
+    }
+    else if(BTN_S_RELEASED_EVT == ptBtnSt->u8BtnSt)
+    {
+        Btn_Lp_Cal_Put(ptCal, u16Hold);
+    }
+    else if((BTN_L_RELEASED_EVT == ptBtnSt->u8BtnSt)
+         && ((uint16)(u16Hold - ptBtnPara->u16LongPressTm) < ptCal->u16UndoTm))
+    {   /* Accidental long press, it was meant to be a short one */
+        Btn_Lp_Cal_Put(ptCal, ptBtnPara->u16LongPressTm);
+    }
+}
+#endif
+
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+/******************************************************************************
+* Name       : static void Btn_Dig_Update(uint8 u8Idx)
+* Function   : Update the digest with the running status of one channel
+* Input      : uint8 u8Idx   0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : None
+* description: The old hash of the channel is XORed out and the new one in, so the
+*              digest is kept in O(1). The hash is done in 32 bits on any target.
+*              The start time of a timer is hashed only while the timer is running,
+*              so a stale start time does NOT make two instances differ.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Dig_Update(uint8 u8Idx)
+{
+    const T_BTN_ST *ptBtnSt = &(sg_atBtnSt[u8Idx]);
+    uint32 u32Hash;
+    uint32 u32StBit = (uint32)1 << ptBtnSt->u8BtnSt;
+    uint32 u32DbTm  = (u32StBit & BTN_DIG_DB_ST) ? ptBtnSt->u16DebounceOldTm  : 0;
+    uint32 u32LpTm  = (u32StBit & BTN_DIG_LP_ST) ? ptBtnSt->u16LongPressOldTm : 0;
+    uint32 u32Latch = 0;
+
+#ifdef __BTN_SM_TOGGLE
+    u32Latch = (sg_au32BtnLatch[u8Idx >> 5] >> (u8Idx & 31)) & 1;
+#endif
+    u32Hash  = ((uint32)(u8Idx + 1) << 24) | ((uint32)ptBtnSt->u8BtnSt << 16) | u32DbTm;
+    u32Hash  = (u32Hash * 0x9E3779B1) & 0xFFFFFFFF;
+    u32Hash ^= (u32Latch << 16) | u32LpTm;
+    u32Hash  = (u32Hash ^ (u32Hash >> 15)) * 0x85EBCA77 & 0xFFFFFFFF;
+    u32Hash  = (u32Hash ^ (u32Hash >> 13)) * 0xC2B2AE3D & 0xFFFFFFFF;
+    u32Hash ^= u32Hash >> 16;
+
+    sg_u32Digest          ^= sg_au32DigHash[u8Idx] ^ u32Hash;
+#ifdef __BTN_SM_DIGEST
+    sg_au32DigGrp[u8Idx >> 5] ^= sg_au32DigHash[u8Idx] ^ u32Hash;
+#endif
+    sg_au32DigHash[u8Idx]  = u32Hash;
+}
+#endif
+
+#ifdef __BTN_SM_REPLICA
+
+/******************************************************************************
+* Name       : static void Btn_Repl_Item_Put(uint32 u32Pos, uint8 u8Idx)
+* Function   : Write the running status of one channel into the ring
+* Input      : uint32 u32Pos  0~               Position in the ring
+*              uint8  u8Idx   0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : None
+* description: The item is NOT published, the caller moves u32Head.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Repl_Item_Put(uint32 u32Pos, uint8 u8Idx)
+{
+    T_BTN_REPL_ITEM *ptItem = &(sg_ptReplRing->atItem[u32Pos & (BTN_REPL_LEN - 1)]);
+
+    ptItem->u32Digest = sg_u32Digest;
+    ptItem->u16DbTm   = sg_atBtnSt[u8Idx].u16DebounceOldTm;
+    ptItem->u16LpTm   = sg_atBtnSt[u8Idx].u16LongPressOldTm;
+    ptItem->u8Ch      = u8Idx + 1;
+    ptItem->u8St      = sg_atBtnSt[u8Idx].u8BtnSt;
+#ifdef __BTN_SM_TOGGLE
+    ptItem->u8Latch   = (uint8)((sg_au32BtnLatch[u8Idx >> 5] >> (u8Idx & 31)) & 1);
+#else
+    ptItem->u8Latch   = 0;
+#endif
+    ptItem->u8En      = sg_aptBtnPara[u8Idx]->u8BtnEn;
+#ifdef __BTN_SM_LP_ADAPT
+    ptItem->u16LongTm = sg_aptBtnPara[u8Idx]->u16LongPressTm;
+    ptItem->u16CalTm  = (NULL != sg_aptLpCal[u8Idx]) ? sg_aptLpCal[u8Idx]->u16LongTm : 0;
+#endif
+}
+
+/******************************************************************************
+* Name       : static uint8 Btn_Repl_Snap(void)
+* Function   : Write a snapshot of all channels into the ring
+* Input      : None
+* Output:    : None
+* Return     : BTN_ERROR     The ring has NO room for it, or NOT replicated
+*              SUCCESS       The snapshot is written
+* description: Written after a change is lost, so the standby is in sync again.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Repl_Snap(void)
+{
+    T_BTN_REPL_RING *ptRing = sg_ptReplRing;
+    uint32 u32Head;
+    uint8  u8Ch;
+
+    if((NULL == ptRing) || ((BTN_REPL_LEN - (ptRing->u32Head - ptRing->u32Tail)) < MAX_BTN_CH))
+    {
+        return BTN_ERROR;
+    }
+
+    u32Head = ptRing->u32Head;
+    for(u8Ch = 0; u8Ch < MAX_BTN_CH; u8Ch++)
+    {
+        Btn_Repl_Item_Put(u32Head++, u8Ch);
+    }
+    sg_u8ReplSnap = 0;
+    BTN_REPL_BARRIER();
+    ptRing->u32Head = u32Head;                  /* Publish the items after they are written */
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : static void Btn_Repl_Put(uint8 u8Idx)
+* Function   : Replicate the change of one channel
+* Input      : uint8 u8Idx   0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : None
+* description: The digest is updated before. Please refer to Btn_Repl_Primary().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Repl_Put(uint8 u8Idx)
+{
+    T_BTN_REPL_RING *ptRing = sg_ptReplRing;
+    uint32 u32Head;
+
+    if(NULL == ptRing)
+    {   /* Standby, or NOT replicated */
+        return;
+    }
+
+    u32Head = ptRing->u32Head;
+    if(0 != sg_u8ReplSnap)
+    {   /* Some change was lost, the snapshot has this change too */
+        if(SUCCESS != Btn_Repl_Snap())
+        {
+            ptRing->u32Lost++;
+        }
+        return;
+    }
+    if(BTN_REPL_LEN == (u32Head - ptRing->u32Tail))
+    {   /* Full, do NOT wait for the standby */
+        ptRing->u32Lost++;
+        sg_u8ReplSnap = 1;
+        return;
+    }
+    Btn_Repl_Item_Put(u32Head++, u8Idx);
+    BTN_REPL_BARRIER();
+    ptRing->u32Head = u32Head;                  /* Publish the item after it is written */
+}
+#endif
+
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+/******************************************************************************
+* Name       : static void Btn_Dig_Put(uint8 u8Idx)
+* Function   : Keep the digest and replicate the change of one channel
+* Input      : uint8 u8Idx   0~MAX_BTN_CH-1   Index of the channel
+* Output:    : None
+* Return     : None
+* description: Called on each change of the running status of a channel.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Dig_Put(uint8 u8Idx)
+{
+    Btn_Dig_Update(u8Idx);
+#ifdef __BTN_SM_REPLICA
+    Btn_Repl_Put(u8Idx);
+#endif
+}
+#endif
+
+/******************************************************************************
+* Name       : static void Btn_Tm_Start(void)
+* Function   : Start a new scan for the time cache
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: The time got in the last scan is dropped, unless the time of this
+*              scan is given by Btn_Scan_Time_Set().
+*              While a hold-off rule is being timed, the time is got here, so the
+*              hold-off ends even if no channel is in timing. A pending snapshot
+*              of the replication is written here as soon as the ring has room.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Tm_Start(void)
+{
+    sg_u8TmValid = sg_u8TmSet;
+    sg_u8TmSet   = 0;
+    sg_u8TmCh    = 0xFF;                         /* The next channel call starts a new pass */
+#ifdef __BTN_SM_INTERLOCK
+    if(0 != sg_u8RuleArmed)
+    {   /* End the hold-offs before the time wraps around */
+        Btn_Rule_Expire();
+    }
+#endif
+#ifdef __BTN_SM_REPLICA
+    if(0 != sg_u8ReplSnap)
+    {   /* Resync the standby even if no channel changes */
+        (void)Btn_Repl_Snap();
+    }
+#endif
+}
+
+#ifdef __BTN_SM_METRICS
+/******************************************************************************
+* Name       : static uint16 Btn_Metrics_Begin(void)
+* Function   : Start the metrics of a scan
+* Input      : None
+* Output:    : None
+* Return     : Tick at the start of the scan, 0 if no tick is set
+* description: Only the clock of Btn_Metrics_Tick_Set() is used. The general time
+*              is NOT read here, so the scan still reads it at most once, and NOT
+*              at all when idle.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint16 Btn_Metrics_Begin(void)
+{
+    sg_u8MetricsActive = 0;
+    return (NULL != sg_pfGetTick) ? sg_pfGetTick() : 0;
+}
+
+/******************************************************************************
+* Name       : static void Btn_Metrics_End(uint8 u8Scan, uint16 u16Tm)
+* Function   : Publish the metrics counted since the last call
+* Input      : uint8  u8Scan    0       NOT a scan, only events and errors are added
+*                               1       End of a scan of all channels
+*              uint16 u16Tm     Tick got by Btn_Metrics_Begin() (u8Scan is 1)
+* Output:    : None
+* Return     : None
+* description: sg_u32MetricsSeq is odd while the metrics are written, so that
+*              Btn_Metrics_Get() never returns values of two scans.
+*              Without the tick, the scan duration is left 0.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Metrics_End(uint8 u8Scan, uint16 u16Tm)
+{
+    if(u8Scan && (NULL != sg_pfGetTick))
+    {
+        u16Tm = sg_pfGetTick() - u16Tm;
+    }
+    else
+    {   /* Duration is NOT measured */
+        u16Tm = 0;
+    }
+
+    sg_u32MetricsSeq++;
+    BTN_BARRIER();
+    sg_tMetrics.u32EvtCnt += sg_u32MetricsEvt;
+    sg_tMetrics.u32ErrCnt += sg_u32MetricsErr;
+#ifdef __BTN_SM_REPLICA
+    if(NULL != sg_ptReplRing)
+    {   /* Only the primary has a ring */
+        sg_tMetrics.u32ReplDepth = sg_ptReplRing->u32Head - sg_ptReplRing->u32Tail;
+        sg_tMetrics.u32ReplLost  = sg_ptReplRing->u32Lost;
+    }
+#endif
+#ifdef __BTN_SM_INTERLOCK
+    sg_tMetrics.u32SuppCnt = sg_u32RuleSuppCnt;
+#endif
+    if(u8Scan)
+    {
+        sg_tMetrics.u32ScanCnt++;
+        sg_tMetrics.u32ScanTmSum += u16Tm;
+        sg_tMetrics.u16ScanTm     = u16Tm;
+        if(u16Tm > sg_tMetrics.u16ScanTmMax)
+        {
+            sg_tMetrics.u16ScanTmMax = u16Tm;
+        }
+        sg_tMetrics.u8ActiveCh    = sg_u8MetricsActive;
+    }
+    BTN_BARRIER();
+    sg_u32MetricsSeq++;
+
+    sg_u32MetricsEvt   = 0;
+    sg_u32MetricsErr   = 0;
+    sg_u8MetricsActive = 0;
+}
+#endif
+
+/******************************************************************************
+* Name       : void Btn_Func_En_Dis(uint8 u8Ch, uint8 u8EnDis)
+* Function   : Enable or disable button function
+* Input      : uint8 u8Ch       1~255               The number of setting button channel
+*              uint8 u8EnDis    BTN_FUNC_ENABLE     Enable the button function
+*                               BTN_FUNC_DISABLE    Disable the button function
+* Output:    : None
+* Return     : None
+* description: If the button function is enabled, the button events and states could
+*              be returned according to the button operation; If the button function 
+*              is disabled, the returned event and state will be BTN_NONE_EVT and 
+*              BTN_DIS_STeven button is operated. 
+* Version    : V1.00
+* Author     : Ian
+* Date       : 27th Jan 2016
+******************************************************************************/
+void Btn_Func_En_Dis(uint8 u8Ch, uint8 u8EnDis)
+{   
+    sg_aptBtnPara[u8Ch - 1]->u8BtnEn = u8EnDis;      /* Enable or Disable the button functions */
+    sg_atBtnSt[u8Ch - 1].u8BtnSt     = BTN_IDLE_ST;  /* Reset the state machine of button      */
+#ifdef __BTN_SM_BITMAP
+    Btn_Map_Clear(u8Ch - 1);
+#endif
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    Btn_Dig_Put(u8Ch - 1);
+#endif
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_General_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+* Function   : General init operation of button state machine.
+* Input      : PF_GET_TM pfGetTm       Function to get gengeral time
+*              PF_GET_BTN pfGetBtnSt   Function to get button state(0/1)
+* Output:    : None
+* Return     : BTN_ERROR               Input parameter is invalid
+*              SUCCESS                 Init operation is successed
+* description: This function should be called once before use button checking.
+*              This function get two necessary interface function: 
+*              "pfGetTm()":Function to get gengeral time;
+*              "pfGetBtnSt":Function to get button state(0/1). (if the MACRO 
+*              __BTN_SM_SPECIFIED_BTN_ST_FN is NOT defined)
+*
+*              NOTE:If the general init is failed, DO NOT continue!!
+* Version    : V1.00
+* Author     : Ian
+* Date       : 27th Jan 2016
+******************************************************************************/
+uint8 Btn_General_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+{
+    /* Check if the input parameter is valid or NOT */
+    if(NULL == pfGetTm) 
+    {   /* Return if the parameter is invalid */
+        return BTN_ERROR;
+    }
+    
+    /* If the "Get time" function has NOT registered yet */
+    if(NULL == sg_pfGetTm)
+    {   /* Register the function */
+        sg_pfGetTm = pfGetTm;
+    }
+    /* If the "Get time" function has already registered, Do NOT re-register */
+
+
+#ifndef __BTN_SM_SPECIFIED_BTN_ST_FN
+    /* Check if the input parameter is valid or NOT */
+    if(NULL == pfGetBtnSt) 
+    {   /* Return if the parameter is invalid */
+        return BTN_ERROR;
+    }   
+
+    /* If the "Get button state" function has NOT registered yet */
+    if(NULL == sg_pfGetBtnSt)
+    {   /* Register the function */
+        sg_pfGetBtnSt = pfGetBtnSt;
+    }
+    /* If the "Get button state" function has already registered, Do NOT re-regiter */
+#else
+    /* If each button use specified button state getting function*/
+    /* pfGetBtnSt will be useless                                */
+    (void)pfGetBtnSt;             /* Avoid warning from complier */
+#endif
+
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara)
+* Function   : Init operation for each button channel
+* Input      : uint8       u8Ch      1~255      The number of setting button channel
+*              T_BTN_PARA *ptBtnPara             Parameter of each button channel
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: After general init operation, call this function for each channel
+*              before button checking.  
+*              This function save the parameter structure pointer for further 
+*              operation, and init running state of such channel.
+*              With __BTN_SM_LOGICAL, a channel with u8SrcCh is a logical channel:
+*              it does NOT read any input, but takes the debounced pressed state
+*              of channel u8SrcCh (pressed, long pressed, or released but NOT yet
+*              debounced) as its input, so one input read and one debounce feed
+*              several channels with their own long-press time, mode and options.
+*              u8SrcCh must be less than u8Ch, so the source is processed first in
+*              a scan; set u16DebounceTm of the logical channel to 0, its events
+*              then follow the ones of the source by 2 process calls.
+*              u8Mode and u8Opt (if they are members) must be known and enabled
+*              by their MACRO (e.g. BTN_MODE_TOGGLE needs __BTN_SM_TOGGLE),
+*              otherwise BTN_ERROR is returned.
+*
+*              NOTE:If the channel init is failed, DO NOT continue!!
+* Version    : V1.00
+* Author     : Ian
+* Date       : 27th Jan 2016
+******************************************************************************/
+uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara)
+{   
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
+        return BTN_ERROR;
+    }
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptBtnPara)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+#ifdef __BTN_SM_CH_MODE
+    /* Check if the mode or the options are unknown or NOT enabled */
+    if((BTN_MODE_NORMAL != ptBtnPara->u8Mode)
+#ifdef __BTN_SM_PULSE_CNT
+    && (BTN_MODE_PULSE  != ptBtnPara->u8Mode)
+#endif
+#ifdef __BTN_SM_TOGGLE
+    && (BTN_MODE_TOGGLE != ptBtnPara->u8Mode)
+#endif
+    )
+    {   /* Return error if the mode is invalid */
+        return BTN_ERROR;
+    }
+    if(0 != (ptBtnPara->u8Opt & ~BTN_OPT_EN))
+    {   /* Return error if any option is invalid */
+        return BTN_ERROR;
+    }
+#endif
+
+#ifdef __BTN_SM_LOGICAL
+    /* Check if the source of logical channel is invalid */
+    if(ptBtnPara->u8SrcCh >= u8Ch)
+    {   /* Return error if the source is NOT processed before the channel */
+        return BTN_ERROR;
+    }
+#endif
+
+#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN
+    /* Check if the input parameter is invalid */
+    if((NULL == ptBtnPara->pfGetBtnSt) && (0 == BTN_SRC_CH(ptBtnPara)))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+#endif
+
+    sg_aptBtnPara[u8Ch - 1]      = ptBtnPara;   /* Get the parameters              */
+    sg_atBtnSt[u8Ch - 1].u8BtnSt = BTN_IDLE_ST; /* Init the state of state machine */    
+#ifdef __BTN_SM_BITMAP
+    Btn_Map_Clear(u8Ch - 1);
+#endif
+#ifdef __BTN_SM_TOGGLE
+    sg_au32BtnLatch[(u8Ch - 1) >> 5] &= ~((uint32)1 << ((u8Ch - 1) & 31));  /* Clear the latch */
+#endif
+#ifdef __BTN_SM_SPECULATIVE
+    sg_au16SpecTent[u8Ch - 1]    = 0;           /* Clear the speculative counters  */
+    sg_au16SpecRetract[u8Ch - 1] = 0;
+#ifdef __BTN_SM_SLEEP
+    sg_au32SpecWake[(u8Ch - 1) >> 5] &= ~((uint32)1 << ((u8Ch - 1) & 31));
+#endif
+#endif
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    Btn_Dig_Put(u8Ch - 1);
+#endif
+
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : static uint8 Btn_Channel_Run(uint8 u8Ch, T_BTN_RESULT* ptBtnRes,
+*                                           uint8 u8Mode)
+* Function   : Process one button channel in the given mode
+* Input      : uint8         u8Ch       1~255             The number of button channel
+*              uint8         u8Mode     BTN_MODE_XXX      Mode of the channel
+* Output:    : T_BTN_RESULT* ptBtnRes                     Please refer to Btn_Channel_Process()
+* Return     : BTN_ERROR     Input parameter or button state is invalid
+*              SUCCESS       Process operation is successed
+* description: Body of Btn_Channel_Process(), the channel number is checked by the
+*              caller. The mode is a parameter, so the
+*              grouped scan calls it with a constant mode for each group and the
+*              mode check is the same for all channels of a loop.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Channel_Run(uint8 u8Ch, T_BTN_RESULT* ptBtnRes, uint8 u8Mode)
+{
+    uint8 u8TmOut  = 0;
+    uint8 u8NextSt = 0x00;  
+    uint8 u8BtnSt;
+#ifdef __BTN_SM_FLIGHT_RECORDER
+    uint8 u8Trg;
+#endif
+#if defined(__BTN_SM_BITMAP) || defined(__BTN_SM_SPECULATIVE) || defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    uint8 u8OldSt;
+#endif
+
+    T_BTN_PARA *ptBtnPara = sg_aptBtnPara[u8Ch - 1];
+    T_BTN_ST   *ptBtnSt   = &(sg_atBtnSt[u8Ch - 1]);
+
+    (void)u8Mode;                             /* Used by channel modes only */
+
+    ptBtnRes->u8Evt   = BTN_NONE_EVT;         /* Clear the old event */
+    ptBtnRes->u8State = ptBtnSt->u8BtnSt;     /* Fill current state  */
+
+    /* Check if the button function is enabled or NOT */
+    if(ptBtnPara->u8BtnEn != BTN_FUNC_ENABLE)
+    {   /* If the function is NOT enabled, return none event and disabled state */
+        ptBtnRes->u8State = BTN_DIS_ST;
+        return SUCCESS;
+    }
+    /* If the function is enabled, go on */
+            
+    /* Get the state of button first */
+#ifdef __BTN_SM_LOGICAL
+    if(0 != ptBtnPara->u8SrcCh)
+    {   /* Logical channel, use the debounced state of the source, NOT the input */
+        u8BtnSt = ptBtnPara->u8NormalSt ^ ((BTN_MAP_PRESSED_ST >> sg_atBtnSt[ptBtnPara->u8SrcCh - 1].u8BtnSt) & 1);
+    }
+    else
+#endif
+#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN    
+    u8BtnSt = ptBtnPara->pfGetBtnSt(u8Ch); /* Use the specified one */
+#else
+    u8BtnSt = sg_pfGetBtnSt(u8Ch);         /* Use common one        */
+#endif
+        
+    /* If the state invalid */
+    if(BTN_ERROR == u8BtnSt)
+    {   
+#ifdef __BTN_SM_FLIGHT_RECORDER
+        /* Dump the history of the channel on fault */
+        if(NULL != sg_pfRecFault)
+        {
+            Btn_Rec_Dump(u8Ch, sg_pfRecFault);
+        }
+#endif
+#ifdef __BTN_SM_METRICS
+        sg_u32MetricsErr++;
+#endif
+        /* Return error */
+        return BTN_ERROR;
+    }  
+
+    /************************ Do operations of state ***************************/    
+    /* If the current state is :           */
+    /* Button just pressed event           */
+    /* Button just short released event    */
+    /* Button just long released event     */
+    /* Button pressed totally event        */
+    /* Button is long pressed              */
+    /* Button short released totally event */
+    /* Button long released totally event  */
+    if(ptBtnSt->u8BtnSt < BTN_PRESS_PRE_ST)
+    {
+        ptBtnRes->u8State = cg_aau8StateMachine[ptBtnSt->u8BtnSt][0];    /* Use the next state as result */
+        
+        /* If the current state is :           */
+        /* Button just pressed event           */
+        /* Button just short released event    */
+        /* Button just long released event     */        
+        if(ptBtnSt->u8BtnSt < BTN_PRESSED_EVT)
+        {
+            ptBtnSt->u16DebounceOldTm = Btn_Tm_Get();        /* Start timing debounce time */
+        }
+
+        /* If the current state is :           */
+        /* Button pressed totally event        */
+        /* Button is long pressed              */
+        /* Button short released totally event */
+        /* Button long released totally event  */
+        else
+        {
+            ptBtnRes->u8Evt = ptBtnSt->u8BtnSt;              /* Update event of result */
+#ifdef __BTN_SM_LP_ADAPT
+            if(NULL != sg_aptLpCal[u8Ch - 1])
+            {   /* Calibrate the long-press time */
+                Btn_Lp_Cal_Evt(sg_aptLpCal[u8Ch - 1], ptBtnPara, ptBtnSt);
+            }
+#endif
+
+            /* If the current state is :       */
+            /* Button pressed totally event    */
+            if(ptBtnSt->u8BtnSt == BTN_PRESSED_EVT)
+            {
+                ptBtnSt->u16LongPressOldTm = Btn_Tm_Get();   /* Start timing long-press time */
+#ifdef __BTN_SM_HOLD_PROGRESS
+                sg_u16HoldTm = ptBtnSt->u16LongPressOldTm;   /* Keep the time for hold progress */
+#endif
+            }
+        }
+    }
+
+    /* If the current state is :           */
+    /* Button is pressed before debounce                   */
+    /* Button is released before debounce form short press */
+    /* Button is released before debounce form long press  */
+    else if(ptBtnSt->u8BtnSt < BTN_IDLE_ST)
+    {
+        ptBtnRes->u8State += BTN_GO_BACK_OFFSET;    /* Do not provide a debounce state with the result  */ 
+        /* Check if debounce time is out */                  
+        u8TmOut = ((uint16)(Btn_Tm_Get() - ptBtnSt->u16DebounceOldTm) >= ptBtnPara->u16DebounceTm);   
+    }
+
+    /* If the current state is :              */
+    /* Button is short pressed after debounce */
+    else if(ptBtnSt->u8BtnSt == BTN_PRESS_AFT_ST)
+    {   /* Check if long-press time is out */
+#ifdef __BTN_SM_HOLD_PROGRESS
+        sg_u16HoldTm = Btn_Tm_Get();                 /* Keep the time for hold progress */
+#endif
+        u8TmOut = ((uint16)(Btn_Tm_Get() - ptBtnSt->u16LongPressOldTm) >= ptBtnPara->u16LongPressTm);
+    }
+        
+    /* If the current state is :           */
+    /* Button is NOT pressed or released   */
+    /* Button is long pressed              */
+    /* ----------DO NOTHING!!------------- */
+
+
+    /*************************** Find the Next state ***************************/
+    /* Check if button is press or NOT */
+    if(u8BtnSt != ptBtnPara->u8NormalSt)
+    {   /* If button is pressed, update index number  */
+        u8NextSt++;
+    }
+    
+    /* Check if the debounce or long-press time is out or NOT */
+    if(u8TmOut)
+    {   /* If time is out, update index number */
+        u8NextSt += BTN_TM_TRG_EVT_OFFSET;
+    }
+    
+    /************************* Do the state transition *************************/  
+#ifdef __BTN_SM_FLIGHT_RECORDER
+    u8Trg = u8NextSt;                                     /* Keep the trigger for recorder  */
+#endif
+    u8NextSt = cg_aau8StateMachine[ptBtnSt->u8BtnSt][u8NextSt];
+
+#ifdef __BTN_SM_FLIGHT_RECORDER
+    /* Record the transition if the channel has a recorder */
+    if((u8NextSt != ptBtnSt->u8BtnSt) && (NULL != sg_aptBtnRec[u8Ch - 1]))
+    {
+        T_BTN_REC      *ptRec  = sg_aptBtnRec[u8Ch - 1];
+        T_BTN_REC_ITEM *ptItem = &(ptRec->ptItem[ptRec->u8Idx]);
+
+        ptItem->u16Tm = Btn_Tm_Get();
+        ptItem->u8St  = u8NextSt;
+        ptItem->u8Trg = u8Trg;
+        if(++(ptRec->u8Idx) >= ptRec->u8Depth)
+        {   /* Wrap around, overwrite the oldest one */
+            ptRec->u8Idx = 0;
+        }
+    }
+#endif
+#if defined(__BTN_SM_BITMAP) || defined(__BTN_SM_SPECULATIVE) || defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    u8OldSt = ptBtnSt->u8BtnSt;                           /* Keep the old state             */
+#endif
+    ptBtnSt->u8BtnSt = u8NextSt;
+
+#ifdef __BTN_SM_SPECULATIVE
+    /* Report the first edge at once, and retract it if debounce falls back */
+    if(ptBtnPara->u8Opt & BTN_OPT_SPECULATIVE)
+    {
+#ifdef __BTN_SM_SLEEP
+        uint32 u32Bit = (uint32)1 << ((u8Ch - 1) & 31);
+
+        if(sg_au32SpecWake[(u8Ch - 1) >> 5] & u32Bit)
+        {   /* Pressed in sleep, this is the first process of the edge */
+            sg_au32SpecWake[(u8Ch - 1) >> 5] &= ~u32Bit;
+            if(BTN_IDLE_ST != u8NextSt)
+            {
+                ptBtnRes->u8Evt = BTN_PRESS_TENTATIVE_EVT;
+                sg_au16SpecTent[u8Ch - 1]++;
+            }
+            /* If it falls back at once, it is never reported, nor retracted */
+        }
+        else
+#endif
+        if((BTN_PRESS_EVT == u8NextSt) && (BTN_IDLE_ST == u8OldSt))
+        {
+            ptBtnRes->u8Evt = BTN_PRESS_TENTATIVE_EVT;
+            sg_au16SpecTent[u8Ch - 1]++;
+        }
+        else if((BTN_IDLE_ST == u8NextSt) && (BTN_PRESS_PRE_ST == u8OldSt))
+        {
+            ptBtnRes->u8Evt = BTN_PRESS_RETRACT_EVT;
+            sg_au16SpecRetract[u8Ch - 1]++;
+        }
+    }
+#endif
+
+#ifdef __BTN_SM_INTERLOCK
+    /* Check the interlock rules on events */
+    if((0 != sg_u8RuleNum) && (BTN_NONE_EVT != ptBtnRes->u8Evt))
+    {
+        Btn_Rule_Check(u8Ch - 1, ptBtnRes);
+#ifdef __BTN_SM_SPECULATIVE
+        if((ptBtnPara->u8Opt & BTN_OPT_SPECULATIVE) && (BTN_PRESSED_EVT == u8OldSt)
+        && (BTN_NONE_EVT == ptBtnRes->u8Evt))
+        {   /* The press is suppressed, so the tentative press is NOT confirmed */
+            ptBtnRes->u8Evt = BTN_PRESS_RETRACT_EVT;
+            sg_au16SpecRetract[u8Ch - 1]++;
+        }
+#endif
+    }
+#endif
+
+#ifdef __BTN_SM_PULSE_CNT
+    /* If the channel is a pulse counter */
+    if(BTN_MODE_PULSE == u8Mode)
+    {
+        Btn_Pulse_Count(sg_aptBtnPulse[u8Ch - 1], ptBtnRes);
+    }
+#endif
+
+#ifdef __BTN_SM_TOGGLE
+    /* If the toggle button is just pressed, flip the latch */
+    if((BTN_MODE_TOGGLE == u8Mode) && (BTN_PRESSED_EVT == ptBtnRes->u8Evt))
+    {
+        uint32 u32Bit = (uint32)1 << ((u8Ch - 1) & 31);
+
+        sg_au32BtnLatch[(u8Ch - 1) >> 5] ^= u32Bit;
+        ptBtnRes->u8Evt = (sg_au32BtnLatch[(u8Ch - 1) >> 5] & u32Bit) ? BTN_TOGGLE_ON_EVT : BTN_TOGGLE_OFF_EVT;
+    }
+#endif
+
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    /* Timers are started and latches flipped only with transitions */
+    if(u8NextSt != u8OldSt)
+    {
+        Btn_Dig_Put(u8Ch - 1);
+    }
+#endif
+
+#ifdef __BTN_SM_BITMAP
+    Btn_Map_Update(u8Ch - 1, u8OldSt, u8NextSt, ptBtnRes->u8Evt);
+#endif
+
+#ifdef __BTN_SM_TRACE
+    if(NULL != sg_pfTrace)
+    {   /* Trace the input, the internal state and the event */
+        sg_pfTrace(u8Ch, u8BtnSt, u8NextSt, ptBtnRes->u8Evt);
+    }
+#endif
+
+#ifdef __BTN_SM_METRICS
+    /* Count the final event, after the rewrites of options, rules and modes */
+    sg_u32MetricsEvt   += (BTN_NONE_EVT != ptBtnRes->u8Evt);
+    sg_u8MetricsActive += ((ptBtnRes->u8State != BTN_IDLE_ST) && (ptBtnRes->u8State != BTN_DIS_ST));
+#endif
+    
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Channel_Process(uint8 u8Ch, T_BTN_RESULT* ptBtnRes)
+* Function   : Main process of button checking
+* Input      : uint8         u8Ch       1~255                 The number of setting button channel
 * Output:    : T_BTN_RESULT* ptBtnRes
 *                             ->u8Evt   BTN_PRESSED_EVT       Button is just short pressed
 *                                       BTN_LONG_PRESSED_EVT  Button is just long pressed
@@ -221,271 +1592,1757 @@ uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara)
 *                                       BTN_DIS_ST            Butoon is disabled
 * Return     : BTN_ERROR     Input parameter or button state is invalid
 *              SUCCESS       Process operation is successed
-* description: This function should be called after general init and channel init.
-*              This function should be polled to check button event and state.
-*              ------------------------------------------------------------------------------
-*             | No.1 Demo of long press and release with debounce check
-*             |  ________                                                ______________ ________
-*             |          |  Debounce |               |                  |   Debounce   |
-*             |    Idle  | Press PRE |  Press AFT    |    Holding       |   Long Rls   |  Idle   
-*             |  (output)|           |   (output)    |   (output)       |              | (output)     
-*             |          |___________|_______________|__________________|              |
-*             |          |           |               |                  |              |
-*             |          V           V               V                  V              V
-*             |     Press Evt    Pressed Evt   Long pressed Evt   Long release Evt   Long released Evt
-*             |                   (output)        (output)                             (output)
-*             |
-*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
-*             |       it will switch to "Press Evt" and start timing for debounce check, then
-*             |       switch to "Press PRE". If the button is release at this time, it will 
-*             |       switch back to "Idle". If the button is still pressed and debounce check
-*             |       time is out, switch to "Pressed Evt", start long-pressed timing and output
-*             |       event to caller, then switch to "Press AFT". If button is released now,
-*             |       please refer to No.2 demo. when long-pressed time is out in "Press AFT",
-*             |       switch to "Long pressed Evt" and output event to caller. Then switch to
-*             |       "Holding". If button is released at this moment, switch to "Long release 
-*             |       Evt" and start timing for debounce check. Then switch to "Long Rls". If 
-*             |       button is pressed again, swtich back to "Holding". If button is still
-*             |       released and debounce time is out, siwtch to "Long released Evt" and 
-*             |       output event to caller. At the last, switch to "Idle" for next checking.
-*              ------------------------------------------------------------------------------
-*             | No.2 Demo of short press and release with debounce check
-*             |  ________                             _____________ ________ 
-*             |          |  Debounce |               |  Debounce   |
-*             |    Idle  | Press PRE |   Press AFT   |  Short Rls  |  Idle         
-*             |  (output)|           |   (output)    |             | (output)
-*             |          |___________|_______________|             |
-*             |          |           |               |             |
-*             |          V           V               V             V
-*             |     Press Evt    Pressed Evt   Short release Evt   Short release Evt
-*             |                   (output)                            (output)
-*             |
-*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
-*             |       it will switch to "Press Evt" and start timing for debounce check, then
-*             |       switch to "Press PRE". If the button is release at this time, it will 
-*             |       switch back to "Idle". If the button is still pressed and debounce check
-*             |       time is out, switch to "Pressed Evt", start long-pressed timing and output
-*             |       event to caller, then switch to "Press AFT". If button is still pressed,
-*             |       and long-press time is out, please refer to No.1 demo. If the button is 
-*             |       released in "Press AFT", switch to "Short release Evt" and start timing
-*             |       for debounce check. Then switch to "Short Rls". If button is pressed again,
-*             |       swtich back to "Press AFT". If button is still released and debounce time
-*             |       is out, siwtch to "Short released Evt" and output event to caller. At the
-*             |       last, switch to "Idle" for next checking.
-*              ------------------------------------------------------------------------------
-*             | No.3 Demo of long press and release without debounce check
-*             |  ________                                    ________
-*             |          |               |                  |
-*             |    Idle  |  Press AFT    |    Holding       |  Idle   
-*             |  (output)|   (output)    |   (output)       | (output)     
-*             |          |_______________|__________________|
-*             |          |               |                  |
-*             |          V               V                  V
-*             |     Pressed Evt   Long pressed Evt   Long released Evt
-*             |       (output)        (output)             (output)
-*             |
-*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
-*             |       it will switch to "Pressed Evt", start long-pressed timing and output
-*             |       event to caller, then switch to "Press AFT". If button is released now,
-*             |       please refer to No.4 demo. when long-pressed time is out in "Press AFT",
-*             |       switch to "Long pressed Evt" and output event to caller. Then switch to
-*             |       "Holding". If button is released at this moment, switch to "Long released
-*             |       Evt" and output event to caller. At the last, switch to "Idle" for next 
-*             |       checking.
-*              ------------------------------------------------------------------------------
-*             | No.4 Demo of short press and release without debounce check
-*             |  ________                 ________
-*             |          |               |
-*             |    Idle  |   Press AFT   |  Idle         
-*             |  (output)|   (output)    | (output)
-*             |          |_______________|
-*             |          |               |
-*             |          V               V
-*             |     Pressed Evt    Short release Evt
-*             |      (output)          (output)
-*             |
-*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
-*             |       it will switch to "Pressed Evt", start long-pressed timing and output
-*             |       event to caller, then switch to "Press AFT". If button is still pressed,
-*             |       and long-press time is out, please refer to No.3 demo. If the button is 
-*             |       released in "Press AFT", switch to "Short released Evt" and output event
-*             |       to caller. At the last, switch to "Idle" for next checking.
-*              -----------------------------------------------------------------------------
-* Version    : V1.10
+* description: This function should be called after general init and channel init.
+*              This function should be polled to check button event and state.
+*              Poll the channels in ascending order, the general time is then got
+*              once per pass (please refer to Btn_Scan_Time_Set()).
+*              ------------------------------------------------------------------------------
+*             | No.1 Demo of long press and release with debounce check
+*             |  ________                                                ______________ ________
+*             |          |  Debounce |               |                  |   Debounce   |
+*             |    Idle  | Press PRE |  Press AFT    |    Holding       |   Long Rls   |  Idle   
+*             |  (output)|           |   (output)    |   (output)       |              | (output)     
+*             |          |___________|_______________|__________________|              |
+*             |          |           |               |                  |              |
+*             |          V           V               V                  V              V
+*             |     Press Evt    Pressed Evt   Long pressed Evt   Long release Evt   Long released Evt
+*             |                   (output)        (output)                             (output)
+*             |
+*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
+*             |       it will switch to "Press Evt" and start timing for debounce check, then
+*             |       switch to "Press PRE". If the button is release at this time, it will 
+*             |       switch back to "Idle". If the button is still pressed and debounce check
+*             |       time is out, switch to "Pressed Evt", start long-pressed timing and output
+*             |       event to caller, then switch to "Press AFT". If button is released now,
+*             |       please refer to No.2 demo. when long-pressed time is out in "Press AFT",
+*             |       switch to "Long pressed Evt" and output event to caller. Then switch to
+*             |       "Holding". If button is released at this moment, switch to "Long release 
+*             |       Evt" and start timing for debounce check. Then switch to "Long Rls". If 
+*             |       button is pressed again, swtich back to "Holding". If button is still
+*             |       released and debounce time is out, siwtch to "Long released Evt" and 
+*             |       output event to caller. At the last, switch to "Idle" for next checking.
+*              ------------------------------------------------------------------------------
+*             | No.2 Demo of short press and release with debounce check
+*             |  ________                             _____________ ________ 
+*             |          |  Debounce |               |  Debounce   |
+*             |    Idle  | Press PRE |   Press AFT   |  Short Rls  |  Idle         
+*             |  (output)|           |   (output)    |             | (output)
+*             |          |___________|_______________|             |
+*             |          |           |               |             |
+*             |          V           V               V             V
+*             |     Press Evt    Pressed Evt   Short release Evt   Short release Evt
+*             |                   (output)                            (output)
+*             |
+*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
+*             |       it will switch to "Press Evt" and start timing for debounce check, then
+*             |       switch to "Press PRE". If the button is release at this time, it will 
+*             |       switch back to "Idle". If the button is still pressed and debounce check
+*             |       time is out, switch to "Pressed Evt", start long-pressed timing and output
+*             |       event to caller, then switch to "Press AFT". If button is still pressed,
+*             |       and long-press time is out, please refer to No.1 demo. If the button is 
+*             |       released in "Press AFT", switch to "Short release Evt" and start timing
+*             |       for debounce check. Then switch to "Short Rls". If button is pressed again,
+*             |       swtich back to "Press AFT". If button is still released and debounce time
+*             |       is out, siwtch to "Short released Evt" and output event to caller. At the
+*             |       last, switch to "Idle" for next checking.
+*              ------------------------------------------------------------------------------
+*             | No.3 Demo of long press and release without debounce check
+*             |  ________                                    ________
+*             |          |               |                  |
+*             |    Idle  |  Press AFT    |    Holding       |  Idle   
+*             |  (output)|   (output)    |   (output)       | (output)     
+*             |          |_______________|__________________|
+*             |          |               |                  |
+*             |          V               V                  V
+*             |     Pressed Evt   Long pressed Evt   Long released Evt
+*             |       (output)        (output)             (output)
+*             |
+*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
+*             |       it will switch to "Pressed Evt", start long-pressed timing and output
+*             |       event to caller, then switch to "Press AFT". If button is released now,
+*             |       please refer to No.4 demo. when long-pressed time is out in "Press AFT",
+*             |       switch to "Long pressed Evt" and output event to caller. Then switch to
+*             |       "Holding". If button is released at this moment, switch to "Long released
+*             |       Evt" and output event to caller. At the last, switch to "Idle" for next 
+*             |       checking.
+*              ------------------------------------------------------------------------------
+*             | No.4 Demo of short press and release without debounce check
+*             |  ________                 ________
+*             |          |               |
+*             |    Idle  |   Press AFT   |  Idle         
+*             |  (output)|   (output)    | (output)
+*             |          |_______________|
+*             |          |               |
+*             |          V               V
+*             |     Pressed Evt    Short release Evt
+*             |      (output)          (output)
+*             |
+*             | Note: At the first stage, button is in "Idle" state, if the button is pressed,
+*             |       it will switch to "Pressed Evt", start long-pressed timing and output
+*             |       event to caller, then switch to "Press AFT". If button is still pressed,
+*             |       and long-press time is out, please refer to No.3 demo. If the button is 
+*             |       released in "Press AFT", switch to "Short released Evt" and output event
+*             |       to caller. At the last, switch to "Idle" for next checking.
+*              -----------------------------------------------------------------------------
+* Version    : V1.10
+* Author     : Ian
+* Date       : 15th Jun 2016
+******************************************************************************/
+uint8 Btn_Channel_Process(uint8 u8Ch, T_BTN_RESULT* ptBtnRes)
+{
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
+        return BTN_ERROR;
+    }
+
+    if((u8Ch <= sg_u8TmCh) || (0 != sg_u8TmSet))
+    {   /* A new pass over the channels, or the time of the next scan is given */
+        Btn_Tm_Start();
+    }
+    sg_u8TmCh = u8Ch;
+#ifdef __BTN_SM_METRICS
+    {
+        uint8 u8Ret = Btn_Channel_Run(u8Ch, ptBtnRes, BTN_CH_MODE(sg_aptBtnPara[u8Ch - 1]));
+
+        Btn_Metrics_End(0, 0);                   /* Publish events and errors, NOT a scan */
+        return u8Ret;
+    }
+#else
+    return Btn_Channel_Run(u8Ch, ptBtnRes, BTN_CH_MODE(sg_aptBtnPara[u8Ch - 1]));
+#endif
+}
+
+
+/******************************************************************************
+* Name       : uint8 Btn_SM_Easy_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+* Function   : Easy init operation of button state machine for quick start.
+* Input      : PF_GET_TM pfGetTm       Function to get gengeral time
+*              PF_GET_BTN pfGetBtnSt   Function to get button state(0/1)
+* Output:    : None
+* Return     : BTN_ERROR               Input parameter is invalid
+*              SUCCESS                 Init operation is successed
+* description: This function should be called once before use button checking.
+*              This function get two necessary interface function: 
+*              "pfGetTm()":Function to get gengeral time;
+*              "pfGetBtnSt":Function to get button state(0/1). (if the MACRO 
+*              __BTN_SM_SPECIFIED_BTN_ST_FN is NOT defined)
+*
+*              NOTE:If the esay init is failed, DO NOT continue!!
+* Version    : V1.00
+* Author     : Ian
+* Date       : 15th Jun 2016
+******************************************************************************/
+uint8 Btn_SM_Easy_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+{
+    static T_BTN_PARA s_atBtnPara[MAX_BTN_CH];
+    uint8 u8Idx,u8Temp;
+
+    /* Button general init */
+    u8Temp = Btn_General_Init(pfGetTm, pfGetBtnSt);
+    if(BTN_ERROR == u8Temp)
+    {
+        return BTN_ERROR;
+    }
+    
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {      
+        /* Configure the button parameters */
+        s_atBtnPara[u8Idx].u8Ch           = u8Idx + 1;       /* Channel number                  */
+        s_atBtnPara[u8Idx].u16DebounceTm  = 50;              /* Debounce time is 50 ms          */
+        s_atBtnPara[u8Idx].u16LongPressTm = 1000;            /* Long-press time is 1000ms       */
+        s_atBtnPara[u8Idx].u8NormalSt     = 0;               /* The normal state of button is 0 */
+        s_atBtnPara[u8Idx].u8BtnEn        = BTN_FUNC_ENABLE; /* Enable button at the beginning  */
+#ifdef __BTN_SM_CH_MODE
+        s_atBtnPara[u8Idx].u8Mode         = BTN_MODE_NORMAL; /* Normal button                   */
+        s_atBtnPara[u8Idx].u8Opt          = 0;               /* No option                       */
+#endif
+#ifdef __BTN_SM_LOGICAL
+        s_atBtnPara[u8Idx].u8SrcCh        = 0;               /* Physical channel                */
+#endif
+#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN
+        s_atBtnPara[u8Idx].pfGetBtnSt     = pfGetBtnSt;      /* Function to get button state    */
+#endif
+
+        /* Button channels init */
+        Btn_Channel_Init(u8Idx + 1 ,&(s_atBtnPara[u8Idx]));
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid
+*              SUCCESS       Process operation is successed
+* description: Same as calling Btn_Channel_Process() for channel 1~MAX_BTN_CH.
+*              All channels should be initialized. A failed channel does NOT stop
+*              the scan of the others.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process(T_BTN_RESULT* ptBtnRes)
+{
+    uint8 u8Idx;
+    uint8 u8Ret = SUCCESS;
+#ifdef __BTN_SM_METRICS
+    uint16 u16Tm;
+#endif
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptBtnRes)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+#ifdef __BTN_SM_METRICS
+    u16Tm = Btn_Metrics_Begin();                 /* Start timing the scan */
+#endif
+
+    Btn_Tm_Start();
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        if(BTN_ERROR == Btn_Channel_Run(u8Idx + 1, &(ptBtnRes[u8Idx]), BTN_CH_MODE(sg_aptBtnPara[u8Idx])))
+        {   /* Go on with other channels */
+            u8Ret = BTN_ERROR;
+        }
+    }
+
+#ifdef __BTN_SM_METRICS
+    Btn_Metrics_End(1, u16Tm);
+#endif
+
+    return u8Ret;
+}
+
+/******************************************************************************
+* Name       : void Btn_Scan_Time_Set(uint16 u16Tm)
+* Function   : Give the general time of the next scan
+* Input      : uint16 u16Tm    0~65535    The general time
+* Output:    : None
+* Return     : None
+* description: The process functions get the general time with "pfGetTm()" at most
+*              once per scan, and only when some channel needs it. A scan is one
+*              call of the scan functions, or one pass of Btn_Channel_Process()
+*              over the channels: a call for a channel NOT above the last one
+*              processed starts a new scan. If the caller already has the time,
+*              call this function before the scan, then "pfGetTm()" is NOT called
+*              in that scan at all.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Scan_Time_Set(uint16 u16Tm)
+{
+    sg_u16ScanTm = u16Tm;
+    sg_u8TmSet   = 1;
+}
+
+#ifdef __BTN_SM_CONST_TIME
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_CT(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once in constant time
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid
+*              SUCCESS       Process operation is successed
+* description: Same results as Btn_Scan_Process() for normal channels only, but
+*              every channel executes the same instruction path regardless of its
+*              state, input and enable control, so the scan time only depends on
+*              MAX_BTN_CH:
+*              - The general time is got once per scan, NOT per channel, even if
+*                no channel is in timing.
+*              - Both timers are always checked and the state table selects the
+*                one in use; state updates and timer starts are done with masks.
+*              - The button state getting function is called for disabled channels
+*                too (the result is masked). A channel whose state is BTN_ERROR
+*                keeps its state and the scan returns BTN_ERROR at the end.
+*              - Flight recorder and trace hook are NOT run here. Metrics are
+*                counted without branches.
+*              - Channel modes, options, logical channels, long-press calibration,
+*                interlock rules, the digest and the replication are NOT run here,
+*                so __BTN_SM_CONST_TIME can NOT be defined with their MACRO
+*                (checked at compile time).
+*              Data-dependent cost left in the path (must be bounded by the user):
+*              - The button state getting function "pfGetBtnSt()".
+*              - The general time getting function "pfGetTm()" (once per scan).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_CT(T_BTN_RESULT* ptBtnRes)
+{
+    uint16 u16Tm, u16DbMask, u16LpMask;
+    uint8  u8Idx, u8St, u8BtnSt, u8Flag, u8TmOut, u8NextSt;
+    uint8  u8En, u8Run, u8RunMask, u8EnMask;
+    uint8  u8Err = 0;
+#ifdef __BTN_SM_METRICS
+    uint16 u16ScanTm;
+#endif
+
+    T_BTN_PARA         *ptBtnPara;
+    T_BTN_ST           *ptBtnSt;
+    const T_BTN_CT_ROW *ptRow;
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptBtnRes)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+#ifdef __BTN_SM_METRICS
+    u16ScanTm = Btn_Metrics_Begin();             /* Start timing the scan */
+#endif
+    Btn_Tm_Start();
+    u16Tm = Btn_Tm_Get();                        /* One time sample for the whole scan */
+#ifdef __BTN_SM_HOLD_PROGRESS
+    sg_u16HoldTm = u16Tm;
+#endif
+
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        ptBtnPara = sg_aptBtnPara[u8Idx];
+        ptBtnSt   = &(sg_atBtnSt[u8Idx]);
+        u8St      = ptBtnSt->u8BtnSt;
+        ptRow     = &(cg_atCtRow[u8St]);
+        u8Flag    = ptRow->u8Flag;
+
+        /* Get the state of button, always */
+#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN    
+        u8BtnSt = ptBtnPara->pfGetBtnSt(u8Idx + 1);
+#else
+        u8BtnSt = sg_pfGetBtnSt(u8Idx + 1);
+#endif
+
+        /* Run the channel only if it is enabled and its state is valid */
+        u8En      = (ptBtnPara->u8BtnEn == BTN_FUNC_ENABLE);
+        u8Err    |= (u8BtnSt == BTN_ERROR);
+        u8Run     = u8En & (u8BtnSt != BTN_ERROR);
+        u8RunMask = (uint8)(0 - u8Run);
+        u8EnMask  = (uint8)(0 - u8En);
+
+        /* Check both timers, the state selects the one in use */
+        u8TmOut   = (((uint16)(u16Tm - ptBtnSt->u16DebounceOldTm)  >= ptBtnPara->u16DebounceTm)  & (u8Flag & BTN_CT_DB_CHECK))
+                  | (((uint16)(u16Tm - ptBtnSt->u16LongPressOldTm) >= ptBtnPara->u16LongPressTm) & ((u8Flag & BTN_CT_LP_CHECK) >> 1));
+
+        /* Find the next state: pressed is index 1, time out is index 2 */
+        u8NextSt  = cg_aau8StateMachine[u8St][(u8BtnSt != ptBtnPara->u8NormalSt) + (u8TmOut << 1)];
+
+        /* Do the state transition and start the timers with masks */
+        ptBtnSt->u8BtnSt = (uint8)(u8St ^ ((u8St ^ u8NextSt) & u8RunMask));
+        u16DbMask = (uint16)(0 - (u8Run & ((u8Flag & BTN_CT_DB_START) >> 2)));
+        u16LpMask = (uint16)(0 - (u8Run & ((u8Flag & BTN_CT_LP_START) >> 3)));
+        ptBtnSt->u16DebounceOldTm  ^= (ptBtnSt->u16DebounceOldTm  ^ u16Tm) & u16DbMask;
+        ptBtnSt->u16LongPressOldTm ^= (ptBtnSt->u16LongPressOldTm ^ u16Tm) & u16LpMask;
+
+        /* Fill the result */
+        ptBtnRes[u8Idx].u8Evt   = (uint8)(BTN_NONE_EVT ^ ((BTN_NONE_EVT ^ ptRow->u8Evt) & u8RunMask));
+        ptBtnRes[u8Idx].u8State = (uint8)(BTN_DIS_ST   ^ ((BTN_DIS_ST   ^ ptRow->u8St)  & u8EnMask));
+
+#ifdef __BTN_SM_METRICS
+        /* Count without branches */
+        sg_u32MetricsEvt   += (BTN_NONE_EVT != ptBtnRes[u8Idx].u8Evt);
+        sg_u32MetricsErr   += (u8BtnSt == BTN_ERROR);
+        sg_u8MetricsActive += (uint8)((ptBtnRes[u8Idx].u8State != BTN_IDLE_ST) & (ptBtnRes[u8Idx].u8State != BTN_DIS_ST));
+#endif
+
+#ifdef __BTN_SM_BITMAP
+        /* Put the bitmaps with masks */
+        u8St = ptBtnSt->u8BtnSt;
+        BTN_MAP_PUT(BTN_MAP_PRESSED, u8Idx >> 5, (uint32)1 << (u8Idx & 31), (BTN_MAP_PRESSED_ST >> u8St) & 1);
+        BTN_MAP_PUT(BTN_MAP_HOLDING, u8Idx >> 5, (uint32)1 << (u8Idx & 31), (BTN_MAP_HOLDING_ST >> u8St) & 1);
+        BTN_MAP_PUT(BTN_MAP_EVT,     u8Idx >> 5, (uint32)1 << (u8Idx & 31), BTN_NONE_EVT != ptBtnRes[u8Idx].u8Evt);
+#endif
+    }
+
+#ifdef __BTN_SM_METRICS
+    Btn_Metrics_End(1, u16ScanTm);
+#endif
+    return (uint8)(SUCCESS ^ ((SUCCESS ^ BTN_ERROR) & (0 - u8Err)));
+}
+#endif
+
+#ifdef __BTN_SM_SOA
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_SoA(T_BTN_SOA *ptOut)
+* Function   : Process all button channels at once, output in structure-of-arrays
+* Input      : None
+* Output:    : T_BTN_SOA *ptOut    State array, event bitmap and event list
+* Return     : BTN_ERROR           Input parameter or any button state is invalid
+*              SUCCESS             Process operation is successed
+* description: Same as Btn_Scan_Process(), but only the changes are written:
+*              - A state in au8State[] is written only if it differs.
+*              - The event bits of the last scan are cleared with its event list,
+*                then the events of this scan are put into the bitmap and the list.
+*              So an idle scan writes nothing but u8EvtNum.
+*              Clear the whole structure before the first scan, then the states of
+*              all channels are written at the first scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_SoA(T_BTN_SOA *ptOut)
+{
+    T_BTN_RESULT tRes;
+    uint8 u8Idx, u8Num;
+    uint8 u8Ret = SUCCESS;
+#ifdef __BTN_SM_METRICS
+    uint16 u16Tm;
+#endif
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptOut)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    /* Clear the event bits of the last scan */
+    for(u8Num = 0; u8Num < ptOut->u8EvtNum; u8Num++)
+    {
+        u8Idx = ptOut->atEvt[u8Num].u8Ch - 1;
+        ptOut->au32EvtMap[u8Idx >> 5] &= ~((uint32)1 << (u8Idx & 31));
+    }
+
+#ifdef __BTN_SM_METRICS
+    u16Tm = Btn_Metrics_Begin();                 /* Start timing the scan */
+#endif
+    u8Num = 0;
+    Btn_Tm_Start();
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        if(BTN_ERROR == Btn_Channel_Run(u8Idx + 1, &tRes, BTN_CH_MODE(sg_aptBtnPara[u8Idx])))
+        {   /* Go on with other channels */
+            u8Ret = BTN_ERROR;
+            continue;
+        }
+
+        /* Write the state only if it is changed */
+        if(tRes.u8State != ptOut->au8State[u8Idx])
+        {
+            ptOut->au8State[u8Idx] = tRes.u8State;
+        }
+
+        /* Put the event into the bitmap and the list */
+        if(BTN_NONE_EVT != tRes.u8Evt)
+        {
+            ptOut->au32EvtMap[u8Idx >> 5] |= (uint32)1 << (u8Idx & 31);
+            ptOut->atEvt[u8Num].u8Ch       = u8Idx + 1;
+            ptOut->atEvt[u8Num].u8Evt      = tRes.u8Evt;
+            u8Num++;
+        }
+    }
+    ptOut->u8EvtNum = u8Num;
+
+#ifdef __BTN_SM_METRICS
+    Btn_Metrics_End(1, u16Tm);
+#endif
+    return u8Ret;
+}
+#endif
+
+#ifdef __BTN_SM_GROUP
+/******************************************************************************
+* Name       : static uint8 Btn_Group_Kernel(uint8 u8Mode, uint8 u8Beg, uint8 u8End,
+*                                            T_BTN_RESULT* ptBtnRes)
+* Function   : Process the channels of one group
+* Input      : uint8 u8Mode    BTN_MODE_XXX   Mode of the group
+*              uint8 u8Beg                    Begin of the group in the list
+*              uint8 u8End                    End of the group in the list
+* Output:    : T_BTN_RESULT* ptBtnRes         Results in channel order
+* Return     : BTN_ERROR     Any button state is invalid
+*              SUCCESS       Process operation is successed
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Group_Kernel(uint8 u8Mode, uint8 u8Beg, uint8 u8End, T_BTN_RESULT* ptBtnRes)
+{
+    uint8 u8Ch;
+    uint8 u8Ret = SUCCESS;
+
+    for(; u8Beg < u8End; u8Beg++)
+    {
+        u8Ch = sg_au8GrpCh[u8Beg];
+        if(BTN_ERROR == Btn_Channel_Run(u8Ch, &(ptBtnRes[u8Ch - 1]), u8Mode))
+        {   /* Go on with other channels */
+            u8Ret = BTN_ERROR;
+        }
+    }
+    return u8Ret;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Group_Build(void)
+* Function   : Group the channels by channel mode for Btn_Scan_Process_Grp()
+* Input      : None
+* Output:    : None
+* Return     : BTN_ERROR     Some channel is NOT initialized, or the group of a
+*                            logical channel is before the group of its source
+*              SUCCESS       The groups are built
+* description: Call this function after all channels are initialized, and again
+*              after u8Mode of any channel is changed. Modes NOT enabled by their
+*              MACRO are grouped as BTN_MODE_NORMAL.
+*              The groups are processed in order of BTN_MODE_XXX, so a source must
+*              be in the group of its logical channel or in a group before it,
+*              otherwise the logical channel would see the state of the source of
+*              the last scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Group_Build(void)
+{
+    uint8 u8Mode, u8Idx;
+    uint8 u8Num = 0;
+
+    sg_u8GrpOk = 0;
+    for(u8Mode = 0; u8Mode < BTN_MODE_NUM; u8Mode++)
+    {
+        for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+        {
+            /* Check if the channel is initialized */
+            if(NULL == sg_aptBtnPara[u8Idx])
+            {
+                return BTN_ERROR;
+            }
+            if(u8Mode != Btn_Group_Mode(BTN_CH_MODE(sg_aptBtnPara[u8Idx])))
+            {
+                continue;
+            }
+#ifdef __BTN_SM_LOGICAL
+            if((0 != sg_aptBtnPara[u8Idx]->u8SrcCh)
+            && (Btn_Group_Mode(BTN_CH_MODE(sg_aptBtnPara[sg_aptBtnPara[u8Idx]->u8SrcCh - 1])) > u8Mode))
+            {   /* The source would be processed after the logical channel */
+                return BTN_ERROR;
+            }
+#endif
+            sg_au8GrpCh[u8Num++] = u8Idx + 1;
+        }
+        sg_au8GrpEnd[u8Mode] = u8Num;
+    }
+    sg_u8GrpOk = 1;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_Grp(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once, grouped by channel mode
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid, or
+*                            the groups are NOT built
+*              SUCCESS       Process operation is successed
+* description: Same results as Btn_Scan_Process(), but the channels of one mode are
+*              processed in one loop with the mode as a constant, so the mode
+*              checks do NOT change from channel to channel and a mixed scan costs
+*              the same as a scan of one mode. The results stay in channel order.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_Grp(T_BTN_RESULT* ptBtnRes)
+{
+    uint8 u8Ret = SUCCESS;
+#ifdef __BTN_SM_METRICS
+    uint16 u16Tm;
+#endif
+
+    /* Check if the input parameter is invalid */
+    if((NULL == ptBtnRes) || (0 == sg_u8GrpOk))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+#ifdef __BTN_SM_METRICS
+    u16Tm = Btn_Metrics_Begin();                 /* Start timing the scan */
+#endif
+    Btn_Tm_Start();
+
+    /* One loop per mode, with the mode as a constant */
+    u8Ret |= Btn_Group_Kernel(BTN_MODE_NORMAL, 0, sg_au8GrpEnd[BTN_MODE_NORMAL], ptBtnRes);
+#ifdef __BTN_SM_PULSE_CNT
+    u8Ret |= Btn_Group_Kernel(BTN_MODE_PULSE, sg_au8GrpEnd[BTN_MODE_NORMAL], sg_au8GrpEnd[BTN_MODE_PULSE], ptBtnRes);
+#endif
+#ifdef __BTN_SM_TOGGLE
+    u8Ret |= Btn_Group_Kernel(BTN_MODE_TOGGLE, sg_au8GrpEnd[BTN_MODE_PULSE], sg_au8GrpEnd[BTN_MODE_TOGGLE], ptBtnRes);
+#endif
+
+#ifdef __BTN_SM_METRICS
+    Btn_Metrics_End(1, u16Tm);
+#endif
+    return u8Ret;
+}
+#endif
+
+#ifdef __BTN_SM_SLEEP
+/******************************************************************************
+* Name       : static uint8 Btn_Sleep_Pin(const T_BTN_PIN *ptPin, uint8 u8Idx, uint32 *pu32Bit)
+* Function   : Get the input pin of a channel in the port words
+* Input      : const T_BTN_PIN *ptPin  Pins of channels, NULL: bit (N-1) is channel N
+*              uint8            u8Idx  0~MAX_BTN_CH-1   Index of the channel
+* Output:    : uint32          *pu32Bit                 Mask of the pin in the word
+* Return     : BTN_ERROR               The pin is out of the ports
+*              0~BTN_SLEEP_PORTS-1     Word of the pin
+* description: None
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Sleep_Pin(const T_BTN_PIN *ptPin, uint8 u8Idx, uint32 *pu32Bit)
+{
+    uint8 u8Port, u8Bit;
+
+    if(NULL == ptPin)
+    {
+        u8Port = u8Idx >> 5;
+        u8Bit  = u8Idx & 31;
+    }
+    else
+    {
+        u8Port = ptPin[u8Idx].u8Port;
+        u8Bit  = ptPin[u8Idx].u8Bit;
+    }
+
+    if((u8Port >= BTN_SLEEP_PORTS) || (u8Bit > 31))
+    {
+        return BTN_ERROR;
+    }
+    *pu32Bit = (uint32)1 << u8Bit;
+    return u8Port;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Enter(T_BTN_SLEEP *ptSleep, const T_BTN_PIN *ptPin)
+* Function   : Check if the module may sleep and get the view of the inputs
+* Input      : const T_BTN_PIN *ptPin  Pins of channel 1~MAX_BTN_CH in the input
+*                                      port words, NULL: bit (N-1) is channel N
+* Output:    : T_BTN_SLEEP *ptSleep    Normal states and mask of enabled channels
+* Return     : BTN_ERROR               Some enabled channel is NOT in BTN_IDLE_ST,
+*                                      a hold-off rule is being timed, a snapshot
+*                                      of the replication is NOT written yet, the
+*                                      pin of some channel is out of the ports, or
+*                                      input parameter is invalid
+*              SUCCESS                 The scan may be stopped
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Enter(T_BTN_SLEEP *ptSleep, const T_BTN_PIN *ptPin)
+{
+    uint32 u32Bit;
+    uint8  u8Idx, u8Port;
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptSleep)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+#ifdef __BTN_SM_INTERLOCK
+    if(0 != sg_u8RuleArmed)
+    {   /* A hold-off is still being timed */
+        return BTN_ERROR;
+    }
+#endif
+#ifdef __BTN_SM_REPLICA
+    if(0 != sg_u8ReplSnap)
+    {   /* The standby is NOT in sync yet */
+        return BTN_ERROR;
+    }
+#endif
+
+    for(u8Idx = 0; u8Idx < BTN_SLEEP_PORTS; u8Idx++)
+    {
+        ptSleep->au32Norm[u8Idx] = 0;
+        ptSleep->au32Mask[u8Idx] = 0;
+    }
+    ptSleep->ptPin = ptPin;
+
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        /* Check if the channel is initialized */
+        if(NULL == sg_aptBtnPara[u8Idx])
+        {
+            return BTN_ERROR;
+        }
+        if(BTN_FUNC_ENABLE != sg_aptBtnPara[u8Idx]->u8BtnEn)
+        {   /* Disabled channels do NOT wake up */
+            continue;
+        }
+        if(BTN_IDLE_ST != sg_atBtnSt[u8Idx].u8BtnSt)
+        {   /* The channel is still being operated */
+            return BTN_ERROR;
+        }
+
+        if(0 != BTN_SRC_CH(sg_aptBtnPara[u8Idx]))
+        {   /* Logical channels have no input */
+            continue;
+        }
+
+        u8Port = Btn_Sleep_Pin(ptPin, u8Idx, &u32Bit);
+        if(BTN_ERROR == u8Port)
+        {   /* The input can NOT be checked */
+            return BTN_ERROR;
+        }
+        ptSleep->au32Mask[u8Port] |= u32Bit;
+        if(BTN_STATE_0 != sg_aptBtnPara[u8Idx]->u8NormalSt)
+        {
+            ptSleep->au32Norm[u8Port] |= u32Bit;
+        }
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Check(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port)
+* Function   : Check if any enabled input is NOT in its normal state
+* Input      : const T_BTN_SLEEP *ptSleep    View got by Btn_Sleep_Enter()
+*              const uint32      *pu32Port   BTN_SLEEP_PORTS words of input levels,
+*                                            in the layout of the pins
+* Output:    : None
+* Return     : 1                             Wake up
+*              0                             Keep sleeping
+* description: One compare per word, the module state is NOT touched.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Check(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port)
+{
+    uint32 u32Diff = 0;
+    uint8  u8Word;
+
+    for(u8Word = 0; u8Word < BTN_SLEEP_PORTS; u8Word++)
+    {
+        u32Diff |= (pu32Port[u8Word] ^ ptSleep->au32Norm[u8Word]) & ptSleep->au32Mask[u8Word];
+    }
+    return (uint8)(0 != u32Diff);
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Wake(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port,
+*                                   uint16 u16EdgeTm)
+* Function   : Resume the module after sleep
+* Input      : const T_BTN_SLEEP *ptSleep    View got by Btn_Sleep_Enter()
+*              const uint32      *pu32Port   Input levels at wake up, as
+*                                            Btn_Sleep_Check(), NULL if no input
+*                                            is changed
+*              uint16             u16EdgeTm  General time of the wake up edge
+* Output:    : None
+* Return     : BTN_ERROR                     The module is NOT initialized, or
+*                                            input parameter is invalid
+*              SUCCESS                       The module is resumed
+* description: Enabled channels whose input is NOT in normal state go to
+*              BTN_PRESS_PRE_ST with the debounce started at u16EdgeTm, so the
+*              press is still debounced and reported as if the scan never stopped.
+*              For channels with BTN_OPT_SPECULATIVE, the next process outputs
+*              BTN_PRESS_TENTATIVE_EVT, unless the input is already released.
+*              Call the process functions as usual after this function.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Wake(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port, uint16 u16EdgeTm)
+{
+    T_BTN_PARA *ptBtnPara;
+    uint32 u32Bit;
+    uint8 u8Idx, u8Port, u8Level;
+
+    /* Check if the input parameter is invalid */
+    if((NULL != pu32Port) && (NULL == ptSleep))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        ptBtnPara = sg_aptBtnPara[u8Idx];
+
+        /* Check if the channel is initialized */
+        if(NULL == ptBtnPara)
+        {
+            return BTN_ERROR;
+        }
+        if((NULL == pu32Port) || (BTN_FUNC_ENABLE != ptBtnPara->u8BtnEn) || (0 != BTN_SRC_CH(ptBtnPara)))
+        {   /* Logical channels follow their sources */
+            continue;
+        }
+
+        u8Port = Btn_Sleep_Pin(ptSleep->ptPin, u8Idx, &u32Bit);
+        if(BTN_ERROR == u8Port)
+        {
+            return BTN_ERROR;
+        }
+        u8Level = (uint8)(0 != (pu32Port[u8Port] & u32Bit));
+        if((u8Level != ptBtnPara->u8NormalSt) && (BTN_IDLE_ST == sg_atBtnSt[u8Idx].u8BtnSt))
+        {   /* Pressed in sleep: debounce from the edge */
+            sg_atBtnSt[u8Idx].u8BtnSt          = BTN_PRESS_PRE_ST;
+            sg_atBtnSt[u8Idx].u16DebounceOldTm = u16EdgeTm;
+#ifdef __BTN_SM_SPECULATIVE
+            if(ptBtnPara->u8Opt & BTN_OPT_SPECULATIVE)
+            {   /* The tentative press is output by the next process */
+                sg_au32SpecWake[u8Idx >> 5] |= (uint32)1 << (u8Idx & 31);
+            }
+#endif
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+            Btn_Dig_Put(u8Idx);
+#endif
+        }
+    }
+    return SUCCESS;
+}
+#endif
+
+#ifdef __BTN_SM_SPECULATIVE
+/******************************************************************************
+* Name       : uint8 Btn_Spec_Stat_Get(uint8 u8Ch, uint16 *pu16Tent, uint16 *pu16Retract)
+* Function   : Get the counters of speculative press events of one channel
+* Input      : uint8   u8Ch         1~255     The number of button channel
+* Output:    : uint16 *pu16Tent     0~65535   Number of BTN_PRESS_TENTATIVE_EVT
+*              uint16 *pu16Retract  0~65535   Number of BTN_PRESS_RETRACT_EVT
+* Return     : BTN_ERROR            Input parameter is invalid
+*              SUCCESS              The counters are got
+* description: Channels with BTN_OPT_SPECULATIVE in u8Opt output
+*              BTN_PRESS_TENTATIVE_EVT at the first edge out of BTN_IDLE_ST, before
+*              debounce. Then BTN_PRESSED_EVT confirms the press as usual, or
+*              BTN_PRESS_RETRACT_EVT is output if the debounce falls back to
+*              BTN_IDLE_ST, or if the press is suppressed by an interlock rule
+*              (instead of BTN_PRESSED_EVT). Retract / tentative is the retraction
+*              rate of the channel. The counters wrap around.
+*
+*              NOTE: Btn_Scan_Process_CT() does NOT output speculative events.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Spec_Stat_Get(uint8 u8Ch, uint16 *pu16Tent, uint16 *pu16Retract)
+{
+    /* Check if the input parameter is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH) || (NULL == pu16Tent) || (NULL == pu16Retract))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    *pu16Tent    = sg_au16SpecTent[u8Ch - 1];
+    *pu16Retract = sg_au16SpecRetract[u8Ch - 1];
+    return SUCCESS;
+}
+#endif
+
+#ifdef __BTN_SM_INTERLOCK
+/******************************************************************************
+* Name       : uint8 Btn_Rule_Init(T_BTN_RULE *ptRule, uint8 u8Num)
+* Function   : Set the interlock rule table
+* Input      : T_BTN_RULE *ptRule    Rules, must be kept by caller. NULL: no rule
+*              uint8       u8Num     Number of rules
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The rules are set
+* description: Please refer to Btn_SM_Module.h.
+*              The counters of the rules and the suppressed channels are cleared.
+* Version    : V1.00
 * Author     : Ian
-* Date       : 15th Jun 2016
+* Date       : 18th Oct 2026
 ******************************************************************************/
-uint8 Btn_Channel_Process(uint8 u8Ch, T_BTN_RESULT* ptBtnRes)
+uint8 Btn_Rule_Init(T_BTN_RULE *ptRule, uint8 u8Num)
 {
-    uint8 u8TmOut  = 0;
-    uint8 u8NextSt = 0x00;  
-    uint8 u8BtnSt;
+    T_BTN_RULE *ptCur;
+    uint8       u8Rule, u8Word;
 
-    T_BTN_PARA *ptBtnPara = sg_aptBtnPara[u8Ch - 1];
-    T_BTN_ST   *ptBtnSt   = &(sg_atBtnSt[u8Ch - 1]);
-        
+    /* Check if the input parameter is invalid */
+    if((NULL == ptRule) && (0 != u8Num))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    for(u8Rule = 0; u8Rule < u8Num; u8Rule++)
+    {
+        ptCur = &(ptRule[u8Rule]);
+        if((ptCur->u8Type > BTN_RULE_HOLDOFF) || (NULL == Btn_Map_Ptr(ptCur->u8Map)))
+        {   /* Return error */
+            return BTN_ERROR;
+        }
+    }
+
+    sg_u8RuleNum = 0;                     /* No rule is checked while setting */
+    for(u8Rule = 0; u8Rule < u8Num; u8Rule++)
+    {   /* Find the words with sources */
+        ptCur           = &(ptRule[u8Rule]);
+        ptCur->u8First  = BTN_MAP_WORDS;
+        ptCur->u8Last   = 0;
+        ptCur->u32SuppCnt = 0;
+        ptCur->u8Armed  = 0;
+        for(u8Word = 0; u8Word < BTN_MAP_WORDS; u8Word++)
+        {
+            if(0 != ptCur->au32Src[u8Word])
+            {
+                ptCur->u8First = (ptCur->u8First < u8Word) ? ptCur->u8First : u8Word;
+                ptCur->u8Last  = u8Word;
+            }
+        }
+        if(BTN_MAP_WORDS == ptCur->u8First)
+        {   /* No source, the loop of sources is empty */
+            ptCur->u8First = 1;
+            ptCur->u8Last  = 0;
+        }
+    }
+    for(u8Word = 0; u8Word < BTN_MAP_WORDS; u8Word++)
+    {
+        sg_au32RuleSupp[u8Word] = 0;
+    }
+    sg_u32RuleSuppCnt = 0;
+    sg_u8RuleArmed    = 0;
+    sg_ptRule         = ptRule;
+    sg_u8RuleNum      = u8Num;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint32 Btn_Rule_Supp_Get(void)
+* Function   : Get the number of suppressed events of all rules
+* Input      : None
+* Output:    : None
+* Return     : 0~             Suppressed events (presses and the following events)
+* description: The suppressed presses of each rule are in u32SuppCnt of the rule.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Rule_Supp_Get(void)
+{
+    return sg_u32RuleSuppCnt;
+}
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+/******************************************************************************
+* Name       : uint8 Btn_Lp_Cal_Init(uint8 u8Ch, T_BTN_LP_CAL *ptCal)
+* Function   : Attach a long-press time calibration to one channel
+* Input      : uint8         u8Ch      1~255   The number of button channel
+*              T_BTN_LP_CAL *ptCal             Calibration, must be kept by caller.
+*                                              NULL: stop the calibration
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The calibration is attached
+* description: Please refer to Btn_SM_Module.h.
+*              The channel should be initialized first.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Lp_Cal_Init(uint8 u8Ch, T_BTN_LP_CAL *ptCal)
+{
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH) || (NULL == sg_aptBtnPara[u8Ch - 1]))
+    {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
+        return BTN_ERROR;
+    }
+
+    /* Check if the input parameter is invalid */
+    if((NULL != ptCal) && ((0 == ptCal->u16MinTm) || (ptCal->u16MinTm > ptCal->u16MaxTm)
+    || (0 == ptCal->u8Quantile) || (ptCal->u8Quantile > 99)))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    if((NULL != ptCal) && (0 == ptCal->u32Cnt))
+    {   /* Start the estimate from the time of the channel */
+        Btn_Lp_Cal_Start(ptCal, sg_aptBtnPara[u8Ch - 1]->u16LongPressTm);
+    }
+
+    sg_aptLpCal[u8Ch - 1] = ptCal;
+    return SUCCESS;
+}
+#endif
+
+#ifdef __BTN_SM_REPLICA
+/******************************************************************************
+* Name       : uint8 Btn_Repl_Primary(T_BTN_REPL_RING *ptRing)
+* Function   : Start replicating the running status to a standby
+* Input      : T_BTN_REPL_RING *ptRing    Ring in shared memory. NULL: stop
+* Output:    : None
+* Return     : BTN_ERROR        Some channel is NOT initialized
+*              SUCCESS          The ring is set
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Repl_Primary(T_BTN_REPL_RING *ptRing)
+{
+    uint8 u8Idx;
+
+    sg_ptReplRing = NULL;
+    if(NULL == ptRing)
+    {
+        return SUCCESS;
+    }
+
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        /* Check if the channel is initialized */
+        if(NULL == sg_aptBtnPara[u8Idx])
+        {
+            return BTN_ERROR;
+        }
+    }
+
+    ptRing->u32Head = 0;
+    ptRing->u32Tail = 0;
+    ptRing->u32Lost = 0;
+    sg_ptReplRing   = ptRing;
+    return Btn_Repl_Snap();                     /* The empty ring has room for it */
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Repl_Apply(T_BTN_REPL_RING *ptRing)
+* Function   : Apply the replicated changes on the standby
+* Input      : T_BTN_REPL_RING *ptRing    Ring in shared memory
+* Output:    : None
+* Return     : BTN_ERROR        Out of sync, or input parameter is invalid
+*              SUCCESS          In sync
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Repl_Apply(T_BTN_REPL_RING *ptRing)
+{
+    const T_BTN_REPL_ITEM *ptItem;
+    T_BTN_ST *ptBtnSt;
+    uint32 u32Tail, u32Head;
+    uint8  u8Idx;
+#ifdef __BTN_SM_BITMAP
+    uint8  u8OldSt;
+#endif
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptRing)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    u32Tail = ptRing->u32Tail;
+    u32Head = ptRing->u32Head;
+    BTN_REPL_BARRIER();                         /* Read the items after the head */
+    for(; u32Tail != u32Head; u32Tail++)
+    {
+        ptItem = &(ptRing->atItem[u32Tail & (BTN_REPL_LEN - 1)]);
+        if((0 == ptItem->u8Ch) || (ptItem->u8Ch > MAX_BTN_CH) || (NULL == sg_aptBtnPara[ptItem->u8Ch - 1]))
+        {   /* NOT the same channels as the primary */
+            sg_u8ReplOk = BTN_ERROR;
+            continue;
+        }
+        u8Idx   = ptItem->u8Ch - 1;
+        ptBtnSt = &(sg_atBtnSt[u8Idx]);
+#ifdef __BTN_SM_BITMAP
+        u8OldSt = ptBtnSt->u8BtnSt;
+#endif
+        ptBtnSt->u16DebounceOldTm  = ptItem->u16DbTm;
+        ptBtnSt->u16LongPressOldTm = ptItem->u16LpTm;
+        ptBtnSt->u8BtnSt           = ptItem->u8St;
+        sg_aptBtnPara[u8Idx]->u8BtnEn = ptItem->u8En;
+#ifdef __BTN_SM_LP_ADAPT
+        sg_aptBtnPara[u8Idx]->u16LongPressTm = ptItem->u16LongTm;
+        if((NULL != sg_aptLpCal[u8Idx]) && (0 != ptItem->u16CalTm) && (ptItem->u16CalTm != sg_aptLpCal[u8Idx]->u16LongTm))
+        {   /* The estimate of the standby restarts from the time of the primary */
+            Btn_Lp_Cal_Start(sg_aptLpCal[u8Idx], ptItem->u16CalTm);
+        }
+#endif
+#ifdef __BTN_SM_TOGGLE
+        sg_au32BtnLatch[u8Idx >> 5] = (sg_au32BtnLatch[u8Idx >> 5] & ~((uint32)1 << (u8Idx & 31)))
+                                    | ((uint32)(ptItem->u8Latch & 1) << (u8Idx & 31));
+#endif
+#ifdef __BTN_SM_BITMAP
+        Btn_Map_Update(u8Idx, u8OldSt, ptBtnSt->u8BtnSt, BTN_NONE_EVT);
+#endif
+        Btn_Dig_Update(u8Idx);
+        sg_u8ReplOk = (sg_u32Digest == ptItem->u32Digest) ? SUCCESS : BTN_ERROR;
+    }
+    BTN_REPL_BARRIER();                         /* Free the items after they are read */
+    ptRing->u32Tail = u32Tail;
+    return sg_u8ReplOk;
+}
+
+/******************************************************************************
+* Name       : uint32 Btn_Repl_Digest_Get(void)
+* Function   : Get the digest of the running status of all channels
+* Input      : None
+* Output:    : None
+* Return     : 0~0xFFFFFFFF     The digest
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Repl_Digest_Get(void)
+{
+    return sg_u32Digest;
+}
+#endif
+
+#ifdef __BTN_SM_DIGEST
+/******************************************************************************
+* Name       : uint32 Btn_Digest_Get(void)
+* Function   : Get the digest of the running status of all channels
+* Input      : None
+* Output:    : None
+* Return     : 0~0xFFFFFFFF     The digest
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Digest_Get(void)
+{
+    return sg_u32Digest;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Grp_Get(uint32 *pu32Grp)
+* Function   : Get the digests of the groups of 32 channels
+* Input      : None
+* Output:    : uint32 *pu32Grp   BTN_MAP_WORDS digests, item N is channel 32N+1~32N+32
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The digests are got
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Grp_Get(uint32 *pu32Grp)
+{
+    uint8 u8Word;
+
+    /* Check if the input parameter is invalid */
+    if(NULL == pu32Grp)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    for(u8Word = 0; u8Word < BTN_MAP_WORDS; u8Word++)
+    {
+        pu32Grp[u8Word] = sg_au32DigGrp[u8Word];
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Ch_Get(uint8 u8Word, uint32 *pu32Hash)
+* Function   : Get the hashes of the channels of one group
+* Input      : uint8   u8Word    0~BTN_MAP_WORDS-1   Index of the group
+* Output:    : uint32 *pu32Hash  32 hashes, item N is channel 32*u8Word+N+1
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The hashes are got
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Ch_Get(uint8 u8Word, uint32 *pu32Hash)
+{
+    uint8 u8Bit;
+    uint16 u16Idx;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == pu32Hash) || (u8Word >= BTN_MAP_WORDS))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    for(u8Bit = 0; u8Bit < 32; u8Bit++)
+    {
+        u16Idx = ((uint16)u8Word << 5) + u8Bit;
+        pu32Hash[u8Bit] = (u16Idx < MAX_BTN_CH) ? sg_au32DigHash[u16Idx] : 0;
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Diff(uint8 u8Word, const uint32 *pu32Hash, uint32 *pu32Diff)
+* Function   : Find the channels of one group which differ from the other instance
+* Input      : uint8         u8Word    0~BTN_MAP_WORDS-1   Index of the group
+*              const uint32 *pu32Hash  32 hashes of the other instance, got by
+*                                      Btn_Digest_Ch_Get()
+* Output:    : uint32       *pu32Diff  Bit N: channel 32*u8Word+N+1 differs
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The channels are compared
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Diff(uint8 u8Word, const uint32 *pu32Hash, uint32 *pu32Diff)
+{
+    uint32 u32Diff = 0;
+    uint8 u8Bit;
+    uint16 u16Idx;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == pu32Hash) || (NULL == pu32Diff) || (u8Word >= BTN_MAP_WORDS))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    for(u8Bit = 0; u8Bit < 32; u8Bit++)
+    {
+        u16Idx = ((uint16)u8Word << 5) + u8Bit;
+        if(pu32Hash[u8Bit] != ((u16Idx < MAX_BTN_CH) ? sg_au32DigHash[u16Idx] : 0))
+        {
+            u32Diff |= (uint32)1 << u8Bit;
+        }
+    }
+    *pu32Diff = u32Diff;
+    return SUCCESS;
+}
+#endif
+
+#ifdef __BTN_SM_FLIGHT_RECORDER
+/******************************************************************************
+* Name       : uint8 Btn_Rec_Init(uint8 u8Ch, T_BTN_REC *ptRec)
+* Function   : Attach a flight recorder to one button channel
+* Input      : uint8      u8Ch     1~255      The number of button channel
+*              T_BTN_REC *ptRec               Recorder with ring buffer and depth set,
+*                                             NULL to detach the recorder
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: Call this function after channel init for the channels to be recorded.
+*              The ring buffer is cleared here. Each state transition of the channel
+*              is then stored as (tick, new state, trigger), overwriting the oldest
+*              one. Channels without recorder only cost one pointer.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Rec_Init(uint8 u8Ch, T_BTN_REC *ptRec)
+{
+    uint8 u8Idx;
+
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
+        return BTN_ERROR;
+    }
+
+    if(NULL != ptRec)
+    {   /* Check if the recorder is invalid */
+        if((NULL == ptRec->ptItem) || (0 == ptRec->u8Depth))
+        {   /* Return error if parameter is invalid */
+            return BTN_ERROR;
+        }
+
+        /* Clear the ring buffer, empty items are marked with BTN_NONE_EVT */
+        for(u8Idx = 0; u8Idx < ptRec->u8Depth; u8Idx++)
+        {
+            ptRec->ptItem[u8Idx].u8St = BTN_NONE_EVT;
+        }
+        ptRec->u8Idx = 0;
+    }
+
+    sg_aptBtnRec[u8Ch - 1] = ptRec;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Rec_Dump(uint8 u8Ch, PF_BTN_REC_OUT pfOut)
+* Function   : Dump the recorded transitions of one button channel
+* Input      : uint8          u8Ch     1~255      The number of button channel
+*              PF_BTN_REC_OUT pfOut               Function to output each transition
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or no recorder attached
+*              SUCCESS          Dump operation is successed
+* description: Transitions are output from the oldest to the newest one.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Rec_Dump(uint8 u8Ch, PF_BTN_REC_OUT pfOut)
+{
+    T_BTN_REC *ptRec;
+    uint8      u8Cnt, u8Idx;
+
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH) || (NULL == pfOut))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    ptRec = sg_aptBtnRec[u8Ch - 1];
+    if(NULL == ptRec)
+    {   /* Return error if no recorder attached */
+        return BTN_ERROR;
+    }
+
+    /* The next item to be written is the oldest one */
+    u8Idx = ptRec->u8Idx;
+    for(u8Cnt = 0; u8Cnt < ptRec->u8Depth; u8Cnt++)
+    {
+        if(BTN_NONE_EVT != ptRec->ptItem[u8Idx].u8St)
+        {   /* Skip the empty items */
+            pfOut(u8Ch, &(ptRec->ptItem[u8Idx]));
+        }
+        if(++u8Idx >= ptRec->u8Depth)
+        {
+            u8Idx = 0;
+        }
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : void Btn_Rec_Fault_Set(PF_BTN_REC_OUT pfOut)
+* Function   : Set the function to dump the recorder on fault
+* Input      : PF_BTN_REC_OUT pfOut    Function to output each transition,
+*                                      NULL to disable dump on fault
+* Output:    : None
+* Return     : None
+* description: If the button state getting function returns BTN_ERROR, the recorder
+*              of such channel is dumped with pfOut before Btn_Channel_Process()
+*              returns BTN_ERROR.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Rec_Fault_Set(PF_BTN_REC_OUT pfOut)
+{
+    sg_pfRecFault = pfOut;
+}
+#endif
+
+#ifdef __BTN_SM_TRACE
+/******************************************************************************
+* Name       : void Btn_Trace_Set(PF_BTN_TRACE pfTrace)
+* Function   : Set the trace hook of button state machine
+* Input      : PF_BTN_TRACE pfTrace    Function to trace each process, NULL to disable
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Trace_Set(PF_BTN_TRACE pfTrace)
+{
+    sg_pfTrace = pfTrace;
+}
+#endif
+
+#ifdef __BTN_SM_PULSE_CNT
+/******************************************************************************
+* Name       : uint8 Btn_Pulse_Init(uint8 u8Ch, T_BTN_PULSE *ptPulse)
+* Function   : Attach a pulse counter to one button channel in BTN_MODE_PULSE
+* Input      : uint8        u8Ch      1~255      The number of button channel
+*              T_BTN_PULSE *ptPulse              Pulse counter with u16WinTm set
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or the module is NOT
+*                               initialized by Btn_General_Init()
+*              SUCCESS          Init operation is successed
+* description: Call this function after channel init. The channel shares the input
+*              reading and the debounce (glitch filter) of the state machine, and
+*              each debounced press (BTN_PRESSED_EVT) is counted as one edge. The
+*              events of such channel are NOT output, only the state is.
+*              The counters are cleared and the first window starts here.
+*
+*              NOTE: One pulse takes about 8 processes of the channel, so the max
+*                    pulse rate of one channel is about 1/8 of the scan rate.
+*                    Btn_Scan_Process_CT() handles all channels as normal buttons.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Pulse_Init(uint8 u8Ch, T_BTN_PULSE *ptPulse)
+{
     /* Check if the channel number is invalid */
     if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
     {   /* If the channel number is NOT in the range of 1~MAX_BTN_CH, return error */
         return BTN_ERROR;
     }
 
-    ptBtnRes->u8Evt   = BTN_NONE_EVT;         /* Clear the old event */
-    ptBtnRes->u8State = ptBtnSt->u8BtnSt;     /* Fill current state  */
+    /* Check if the input parameter is invalid */
+    if((NULL == ptPulse) || (0 == ptPulse->u16WinTm))
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
+    }
 
-    /* Check if the button function is enabled or NOT */
-    if(ptBtnPara->u8BtnEn != BTN_FUNC_ENABLE)
-    {   /* If the function is NOT enabled, return none event and disabled state */
-        ptBtnRes->u8State = BTN_DIS_ST;
-        return SUCCESS;
+    /* Check if the module is NOT initialized */
+    if(NULL == sg_pfGetTm)
+    {   /* Return error if the time can NOT be got */
+        return BTN_ERROR;
     }
-    /* If the function is enabled, go on */
-            
-    /* Get the state of button first */
-#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN    
-    u8BtnSt = ptBtnPara->pfGetBtnSt(u8Ch); /* Use the specified one */
-#else
-    u8BtnSt = sg_pfGetBtnSt(u8Ch);         /* Use common one        */
+
+    ptPulse->u32Cnt        = 0;
+    ptPulse->u32WinCnt     = 0;
+    ptPulse->u16Freq       = 0;
+    ptPulse->u16Period     = 0;
+    ptPulse->u16WinStartTm = sg_pfGetTm();
+    ptPulse->u16EdgeTm     = ptPulse->u16WinStartTm;
+
+    sg_aptBtnPulse[u8Ch - 1] = ptPulse;
+    return SUCCESS;
+}
 #endif
-        
-    /* If the state invalid */
-    if(BTN_ERROR == u8BtnSt)
+
+#ifdef __BTN_SM_TOGGLE
+/******************************************************************************
+* Name       : uint8 Btn_Latch_Get(uint8 u8Ch)
+* Function   : Get the latch of one toggle button
+* Input      : uint8 u8Ch  1~255   The number of button channel
+* Output:    : None
+* Return     : 0/1                 Latch of the channel
+*              BTN_ERROR           Channel number is invalid
+* description: Channels in BTN_MODE_TOGGLE flip their latch on each debounced press,
+*              and BTN_PRESSED_EVT is replaced with BTN_TOGGLE_ON_EVT or
+*              BTN_TOGGLE_OFF_EVT. Other events are output as usual.
+*              The latch is kept when the channel is disabled, and cleared by
+*              Btn_Channel_Init().
+*
+*              NOTE: Btn_Scan_Process_CT() handles all channels as normal buttons.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Latch_Get(uint8 u8Ch)
+{
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
     {   /* Return error */
         return BTN_ERROR;
-    }  
+    }
+    return (uint8)((sg_au32BtnLatch[(u8Ch - 1) >> 5] >> ((u8Ch - 1) & 31)) & 1);
+}
 
-    /************************ Do operations of state ***************************/    
-    /* If the current state is :           */
-    /* Button just pressed event           */
-    /* Button just short released event    */
-    /* Button just long released event     */
-    /* Button pressed totally event        */
-    /* Button is long pressed              */
-    /* Button short released totally event */
-    /* Button long released totally event  */
-    if(ptBtnSt->u8BtnSt < BTN_PRESS_PRE_ST)
+/******************************************************************************
+* Name       : uint32 Btn_Latch_Word_Get(uint8 u8Word)
+* Function   : Get the latches of 32 channels with one read
+* Input      : uint8 u8Word  0~BTN_MAP_WORDS-1   Index of the word
+* Output:    : None
+* Return     : Bit N is the latch of channel (u8Word * 32 + N + 1), 0 if u8Word is
+*              out of range
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Latch_Word_Get(uint8 u8Word)
+{
+    /* Check if the index is invalid */
+    if(u8Word >= BTN_MAP_WORDS)
     {
-        ptBtnRes->u8State = cg_aau8StateMachine[ptBtnSt->u8BtnSt][0];    /* Use the next state as result */
-        
-        /* If the current state is :           */
-        /* Button just pressed event           */
-        /* Button just short released event    */
-        /* Button just long released event     */        
-        if(ptBtnSt->u8BtnSt < BTN_PRESSED_EVT)
-        {
-            ptBtnSt->u16DebounceOldTm = sg_pfGetTm();        /* Start timing debounce time */
-        }
+        return 0;
+    }
+    return sg_au32BtnLatch[u8Word];
+}
 
-        /* If the current state is :           */
-        /* Button pressed totally event        */
-        /* Button is long pressed              */
-        /* Button short released totally event */
-        /* Button long released totally event  */
-        else
-        {
-            ptBtnRes->u8Evt = ptBtnSt->u8BtnSt;              /* Update event of result */
+/******************************************************************************
+* Name       : uint8 Btn_Latch_Set(uint8 u8Ch, uint8 u8Latch)
+* Function   : Set the latch of one toggle button without event
+* Input      : uint8 u8Ch      1~255   The number of button channel
+*              uint8 u8Latch   0/1     New latch of the channel
+* Output:    : None
+* Return     : BTN_ERROR               Input parameter is invalid
+*              SUCCESS                 The latch is set
+* description: e.g. to restore the latches from non-volatile memory after init.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Latch_Set(uint8 u8Ch, uint8 u8Latch)
+{
+    uint32 u32Bit;
 
-            /* If the current state is :       */
-            /* Button pressed totally event    */
-            if(ptBtnSt->u8BtnSt == BTN_PRESSED_EVT)
-            {
-                ptBtnSt->u16LongPressOldTm = sg_pfGetTm();   /* Start timing long-press time */
-            }
-        }
+    /* Check if the input parameter is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH) || (u8Latch > 1))
+    {   /* Return error */
+        return BTN_ERROR;
     }
 
-    /* If the current state is :           */
-    /* Button is pressed before debounce                   */
-    /* Button is released before debounce form short press */
-    /* Button is released before debounce form long press  */
-    else if(ptBtnSt->u8BtnSt < BTN_IDLE_ST)
+    u32Bit = (uint32)1 << ((u8Ch - 1) & 31);
+    if(u8Latch)
     {
-        ptBtnRes->u8State += BTN_GO_BACK_OFFSET;    /* Do not provide a debounce state with the result  */ 
-        /* Check if debounce time is out */                  
-        u8TmOut = ((sg_pfGetTm() - ptBtnSt->u16DebounceOldTm) >= ptBtnPara->u16DebounceTm);   
+        sg_au32BtnLatch[(u8Ch - 1) >> 5] |= u32Bit;
+    }
+    else
+    {
+        sg_au32BtnLatch[(u8Ch - 1) >> 5] &= ~u32Bit;
     }
+#if defined(__BTN_SM_REPLICA) || defined(__BTN_SM_DIGEST)
+    Btn_Dig_Put(u8Ch - 1);
+#endif
+    return SUCCESS;
+}
+#endif
 
-    /* If the current state is :              */
-    /* Button is short pressed after debounce */
-    else if(ptBtnSt->u8BtnSt == BTN_PRESS_AFT_ST)
-    {   /* Check if long-press time is out */
-        u8TmOut = ((sg_pfGetTm() - ptBtnSt->u16LongPressOldTm) >= ptBtnPara->u16LongPressTm);
+#ifdef __BTN_SM_BITMAP
+/******************************************************************************
+* Name       : uint32 Btn_Map_Word_Get(uint8 u8Map, uint8 u8Word)
+* Function   : Get 32 channels of one bitmap with one read
+* Input      : uint8 u8Map   BTN_MAP_PRESSED       Debounced pressed channels
+*                            BTN_MAP_HOLDING       Long pressed channels
+*                            BTN_MAP_EVT           Channels with event in last process
+*                            BTN_MAP_LATCH         Latched toggle channels (__BTN_SM_TOGGLE)
+*              uint8 u8Word  0~BTN_MAP_WORDS-1     Index of the word
+* Output:    : None
+* Return     : Bit N is channel (u8Word * 32 + N + 1), 0 if input is invalid
+* description: The bitmaps are updated by the process functions only when the state
+*              or the event of a channel changes, so the queries cost nothing between
+*              scans. A channel is "pressed" from the end of press debounce to the
+*              end of release debounce. Disabled channels are cleared.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Map_Word_Get(uint8 u8Map, uint8 u8Word)
+{
+    const uint32 *pu32Map = Btn_Map_Ptr(u8Map);
+
+    /* Check if the input parameter is invalid */
+    if((NULL == pu32Map) || (u8Word >= BTN_MAP_WORDS))
+    {
+        return 0;
     }
-        
-    /* If the current state is :           */
-    /* Button is NOT pressed or released   */
-    /* Button is long pressed              */
-    /* ----------DO NOTHING!!------------- */
+    return pu32Map[u8Word];
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Map_Any(uint8 u8Map)
+* Function   : Check if any channel is set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+* Output:    : None
+* Return     : 1             At least one channel is set
+*              0             No channel is set, or u8Map is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Any(uint8 u8Map)
+{
+    const uint32 *pu32Map = Btn_Map_Ptr(u8Map);
+    uint32 u32Or = 0;
+    uint8  u8Word;
 
+    /* Check if the input parameter is invalid */
+    if(NULL == pu32Map)
+    {
+        return 0;
+    }
+    for(u8Word = 0; u8Word < BTN_MAP_WORDS; u8Word++)
+    {
+        u32Or |= pu32Map[u8Word];
+    }
+    return (uint8)(0 != u32Or);
+}
 
-    /*************************** Find the Next state ***************************/
-    /* Check if button is press or NOT */
-    if(u8BtnSt != ptBtnPara->u8NormalSt)
-    {   /* If button is pressed, update index number  */
-        u8NextSt++;
+/******************************************************************************
+* Name       : uint8 Btn_Map_Count(uint8 u8Map)
+* Function   : Count the channels set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+* Output:    : None
+* Return     : 0~MAX_BTN_CH  Number of channels set, 0 if u8Map is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Count(uint8 u8Map)
+{
+    const uint32 *pu32Map = Btn_Map_Ptr(u8Map);
+    uint8 u8Word, u8Cnt = 0;
+
+    /* Check if the input parameter is invalid */
+    if(NULL == pu32Map)
+    {
+        return 0;
     }
-    
-    /* Check if the debounce or long-press time is out or NOT */
-    if(u8TmOut)
-    {   /* If time is out, update index number */
-        u8NextSt += BTN_TM_TRG_EVT_OFFSET;
+    for(u8Word = 0; u8Word < BTN_MAP_WORDS; u8Word++)
+    {
+        u8Cnt += Btn_Bit_Cnt(pu32Map[u8Word]);
     }
-    
-    /************************* Do the state transition *************************/  
-    ptBtnSt->u8BtnSt = cg_aau8StateMachine[ptBtnSt->u8BtnSt][u8NextSt];
-    
-    return SUCCESS;
+    return u8Cnt;
 }
 
+/******************************************************************************
+* Name       : uint8 Btn_Map_Next(uint8 u8Map, uint8 u8Ch)
+* Function   : Find the next channel set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+*              uint8 u8Ch    0~255         Search after this channel, 0 to start
+* Output:    : None
+* Return     : 1~MAX_BTN_CH  The next channel set
+*              0             No more channel is set, or u8Map is invalid
+* description: Iterate the set channels with:
+*                  for(u8Ch = Btn_Map_Next(u8Map, 0); u8Ch; u8Ch = Btn_Map_Next(u8Map, u8Ch))
+*              Empty words are skipped, so it costs O(words) plus one step per channel.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Next(uint8 u8Map, uint8 u8Ch)
+{
+    const uint32 *pu32Map = Btn_Map_Ptr(u8Map);
+    uint32 u32Word;
+    uint8  u8Word;
+
+    /* Check if the input parameter is invalid, u8Ch is the index of next channel */
+    if((NULL == pu32Map) || (u8Ch >= MAX_BTN_CH))
+    {
+        return 0;
+    }
+
+    u8Word  = u8Ch >> 5;
+    u32Word = pu32Map[u8Word] & ((uint32)0xFFFFFFFF << (u8Ch & 31));
+    while(0 == u32Word)
+    {   /* Skip the empty words */
+        if(++u8Word >= BTN_MAP_WORDS)
+        {
+            return 0;
+        }
+        u32Word = pu32Map[u8Word];
+    }
+    return (uint8)((u8Word << 5) + Btn_Bit_First(u32Word) + 1);
+}
+#endif
 
+#ifdef __BTN_SM_HOLD_PROGRESS
 /******************************************************************************
-* Name       : uint8 Btn_SM_Easy_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
-* Function   : Easy init operation of button state machine for quick start.
-* Input      : PF_GET_TM pfGetTm       Function to get gengeral time
-*              PF_GET_BTN pfGetBtnSt   Function to get button state(0/1)
+* Name       : uint16 Btn_Hold_Progress_Get(uint8 u8Ch)
+* Function   : Get the progress of one pressed button toward long-press
+* Input      : uint8 u8Ch  1~255        The number of button channel
 * Output:    : None
-* Return     : BTN_ERROR               Input parameter is invalid
-*              SUCCESS                 Init operation is successed
-* description: This function should be called once before use button checking.
-*              This function get two necessary interface function: 
-*              "pfGetTm()":Function to get gengeral time;
-*              "pfGetBtnSt":Function to get button state(0/1). (if the MACRO 
-*              __BTN_SM_SPECIFIED_BTN_ST_FN is NOT defined)
-*
-*              NOTE:If the esay init is failed, DO NOT continue!!
+* Return     : 0~0xFFFF                 Elapsed / u16LongPressTm in Q0.16, 0xFFFF if
+*                                       the long-press time is reached
+*              0                        The channel is NOT in BTN_PRESS_AFT_ST, or
+*                                       the channel number is invalid
+* description: The progress is computed from the long-press start time of the
+*              channel and the last time got by the process (NO extra call of
+*              "pfGetTm()"), so it is as fresh as the last scan.
 * Version    : V1.00
 * Author     : Ian
-* Date       : 15th Jun 2016
+* Date       : 18th Oct 2026
 ******************************************************************************/
-uint8 Btn_SM_Easy_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+uint16 Btn_Hold_Progress_Get(uint8 u8Ch)
 {
-    static T_BTN_PARA s_atBtnPara[MAX_BTN_CH];
-    uint8 u8Idx,u8Temp;
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {
+        return 0;
+    }
 
-    /* Button general init */
-    u8Temp = Btn_General_Init(pfGetTm, pfGetBtnSt);
-    if(BTN_ERROR == u8Temp)
+    /* Only the channels held toward long-press have progress */
+    if(BTN_PRESS_AFT_ST != sg_atBtnSt[u8Ch - 1].u8BtnSt)
     {
-        return BTN_ERROR;
+        return 0;
     }
-    
-    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
-    {      
-        /* Configure the button parameters */
-        s_atBtnPara[u8Idx].u8Ch           = u8Idx + 1;       /* Channel number                  */
-        s_atBtnPara[u8Idx].u16DebounceTm  = 50;              /* Debounce time is 50 ms          */
-        s_atBtnPara[u8Idx].u16LongPressTm = 1000;            /* Long-press time is 1000ms       */
-        s_atBtnPara[u8Idx].u8NormalSt     = 0;               /* The normal state of button is 0 */
-        s_atBtnPara[u8Idx].u8BtnEn        = BTN_FUNC_ENABLE; /* Enable button at the beginning  */
-#ifdef __BTN_SM_SPECIFIED_BTN_ST_FN
-        s_atBtnPara[u8Idx].pfGetBtnSt     = pfGetBtnSt;      /* Function to get button state    */
+    return Btn_Hold_Progress(u8Ch - 1);
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Hold_Next(uint8 u8Ch, uint16 *pu16Prog)
+* Function   : Find the next button in BTN_PRESS_AFT_ST and get its progress
+* Input      : uint8   u8Ch       0~255     Search after this channel, 0 to start
+* Output:    : uint16 *pu16Prog             Progress as Btn_Hold_Progress_Get()
+* Return     : 1~MAX_BTN_CH                 The next channel in BTN_PRESS_AFT_ST
+*              0                            No more channel
+* description: Iterate the channels being held toward long-press with:
+*                  for(u8Ch = Btn_Hold_Next(0, &u16Prog); u8Ch; u8Ch = Btn_Hold_Next(u8Ch, &u16Prog))
+*              Only channels in BTN_PRESS_AFT_ST are returned. With __BTN_SM_BITMAP
+*              the channels NOT pressed are skipped by words.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Hold_Next(uint8 u8Ch, uint16 *pu16Prog)
+{
+    uint8 u8Idx;
+
+#ifdef __BTN_SM_BITMAP
+    /* Only pressed and NOT holding channels may be in BTN_PRESS_AFT_ST */
+    for(u8Ch = Btn_Map_Next(BTN_MAP_PRESSED, u8Ch); u8Ch; u8Ch = Btn_Map_Next(BTN_MAP_PRESSED, u8Ch))
+    {
+        u8Idx = u8Ch - 1;
+#else
+    for(u8Idx = u8Ch; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+#endif
+        if(BTN_PRESS_AFT_ST == sg_atBtnSt[u8Idx].u8BtnSt)
+        {
+            if(NULL != pu16Prog)
+            {
+                *pu16Prog = Btn_Hold_Progress(u8Idx);
+            }
+            return u8Idx + 1;
+        }
+    }
+    return 0;
+}
 #endif
 
-        /* Button channels init */
-        Btn_Channel_Init(u8Idx + 1 ,&(s_atBtnPara[u8Idx]));
+#ifdef __BTN_SM_METRICS
+/******************************************************************************
+* Name       : void Btn_Metrics_Tick_Set(PF_GET_TM pfGetTick)
+* Function   : Set the clock to measure scan duration
+* Input      : PF_GET_TM pfGetTick    Function to get a free running fine tick (e.g.
+*                                     us timer or cycle counter), NULL NOT to
+*                                     measure the scan duration
+* Output:    : None
+* Return     : None
+* description: The scan duration is measured only with this tick, it is called
+*              twice per scan. Without it the duration metrics stay 0; the general
+*              time is NOT used, as it is too coarse (1ms) and would be read in
+*              every scan, even when all channels are idle.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Metrics_Tick_Set(PF_GET_TM pfGetTick)
+{
+    sg_pfGetTick = pfGetTick;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Metrics_Get(T_BTN_METRICS *ptMetrics)
+* Function   : Get a copy of the metrics
+* Input      : None
+* Output:    : T_BTN_METRICS *ptMetrics   Copy of the metrics
+* Return     : BTN_ERROR        The metrics were being written in all tries, or
+*                               input parameter is invalid
+*              SUCCESS          All values of the copy are of the same scan
+* description: Please refer to Btn_SM_Module.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Metrics_Get(T_BTN_METRICS *ptMetrics)
+{
+    uint32 u32Seq;
+    uint8  u8Try;
+
+    /* Check if the input parameter is invalid */
+    if(NULL == ptMetrics)
+    {   /* Return error if parameter is invalid */
+        return BTN_ERROR;
     }
-    return SUCCESS;
+
+    for(u8Try = 0; u8Try < BTN_METRICS_TRY; u8Try++)
+    {
+        u32Seq = sg_u32MetricsSeq;
+        BTN_BARRIER();
+        *ptMetrics = sg_tMetrics;
+        BTN_BARRIER();
+        if((0 == (u32Seq & 1)) && (u32Seq == sg_u32MetricsSeq))
+        {   /* NOT written during the copy */
+            return SUCCESS;
+        }
+    }
+    return BTN_ERROR;
 }
+#endif
 
 
 /* end-of-file */
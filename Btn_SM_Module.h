@@ -16,6 +16,12 @@
 *                  * BTN_LONG_PRESSED_EVT   Button is just long pressed                              
 *                  * BTN_S_RELEASED_EVT     Button is just released from short pressed                 
 *                  * BTN_L_RELEASED_EVT     Button is just released from long pressed    
+*                  * BTN_TOGGLE_ON_EVT      Toggle button is just latched on (BTN_MODE_TOGGLE)
+*                  * BTN_TOGGLE_OFF_EVT     Toggle button is just latched off (BTN_MODE_TOGGLE)
+*                  * BTN_PRESS_TENTATIVE_EVT Button is maybe pressed, before debounce
+*                                           (BTN_OPT_SPECULATIVE)
+*                  * BTN_PRESS_RETRACT_EVT  The tentative press is NOT a press
+*                                           (BTN_OPT_SPECULATIVE)
 *
 *              - Following states (stable-state) can be provided
 *                  * BTN_IDLE_ST            Button stays in idle state (Not pressed)
@@ -32,6 +38,7 @@
 *                      If defined __BTN_SM_SPECIFIED_BTN_ST_FN, each button will use 
 *                      specified button state getting function.
 *              Step 7: Poll "Btn_Channel_Process()" per channel to get events and states.
+*                      Or poll "Btn_Scan_Process()" to process all channels at once.
 *
 *              NOTE: For advanced configuration, please use Btn_General_Init() and
 *                    Btn_channel_Init().
@@ -39,13 +46,48 @@
 *              NOTE: This software is modularization designed, so "Btn_SM_Module.c" and 
 *                    "Btn_SM_Module.h" should work without any modification. 
 *         
-* Version    : V1.10
+* Version    : V1.45
 * Author     : Ian
-* Date       : 15th Jun 2016
+* Date       : 18th Oct 2026
 * History    :  No.  When          Who   Version   What        
 *               1    27/Jan/2016   Ian   V1.00     Create      
 *               2    15/Jun/2016   Ian   V1.10     Re-design the state machine with state
 *                                                  table, return "Event" and "State"                                                          
+*               3    18/Oct/2026   Ian   V1.11     Add flight recorder of channel transitions
+*               4    18/Oct/2026   Ian   V1.12     Add trace hook of input, state and event
+*               5    18/Oct/2026   Ian   V1.13     Add whole scan process and metrics counters
+*               6    18/Oct/2026   Ian   V1.14     Add constant-time scan process for WCET
+*               7    18/Oct/2026   Ian   V1.15     Add channel mode and pulse counter mode
+*               8    18/Oct/2026   Ian   V1.16     Add toggle mode with latch bitmap
+*               9    18/Oct/2026   Ian   V1.17     Add pressed, holding and event bitmaps
+*               10   18/Oct/2026   Ian   V1.18     Add structure-of-arrays scan output
+*               11   18/Oct/2026   Ian   V1.19     Add hold progress of long-press
+*               12   18/Oct/2026   Ian   V1.20     Add scan of channels grouped by mode
+*               13   18/Oct/2026   Ian   V1.21     Sample the time at most once per scan
+*               14   18/Oct/2026   Ian   V1.22     Add sleep and wake-on-press detection
+*               15   18/Oct/2026   Ian   V1.23     Add speculative press events with retraction
+*               16   18/Oct/2026   Ian   V1.24     Add interlock rules of channels
+*               17   18/Oct/2026   Ian   V1.25     Add logical channels of one input
+*               18   18/Oct/2026   Ian   V1.26     Add adaptive long-press time
+*               19   18/Oct/2026   Ian   V1.27     Add replication of states to a standby
+*               20   18/Oct/2026   Ian   V1.28     Add rolling state digest for lockstep check
+*               21   18/Oct/2026   Ian   V1.29     Metrics of all scans, final events and checked copy
+*               22   18/Oct/2026   Ian   V1.30     Check mode and options of channel, time of pulse init
+*               23   18/Oct/2026   Ian   V1.31     Scan duration only with the fine tick
+*               24   18/Oct/2026   Ian   V1.32     Retract suppressed speculative press, tentative on wake
+*               25   18/Oct/2026   Ian   V1.33     End hold-off before the time wraps around
+*               26   18/Oct/2026   Ian   V1.34     Resync snapshot by the scan, default ring barrier
+*               27   18/Oct/2026   Ian   V1.35     Constant-time scan rejects features it does NOT run
+*               28   18/Oct/2026   Ian   V1.36     Interlock rules can NOT be bypassed by the constant-time scan
+*               29   18/Oct/2026   Ian   V1.37     Digest can NOT go stale by the constant-time scan
+*               30   18/Oct/2026   Ian   V1.38     Replication can NOT go stale by the constant-time scan
+*               31   18/Oct/2026   Ian   V1.39     Replicate the enable control of channels
+*               32   18/Oct/2026   Ian   V1.40     Replicate the adapted long-press time
+*               33   18/Oct/2026   Ian   V1.41     Mode and options of channel only with the MACRO using them
+*               34   18/Oct/2026   Ian   V1.42     Time once per pass of the channel process
+*               35   18/Oct/2026   Ian   V1.43     Map the sleep masks to the pins of the ports
+*               36   18/Oct/2026   Ian   V1.44     Count the replication and interlock metrics
+*               37   18/Oct/2026   Ian   V1.45     Reject groups with a source after its logical channel
 ******************************************************************************/
 
 
@@ -62,6 +104,8 @@ extern "C" {
 #define MAX_BTN_CH                   (1)         /* Max number of buttons, please define it in upper layer */
 #endif
 
+#define BTN_MAP_WORDS                ((MAX_BTN_CH + 31) / 32) /* Number of words of channel bitmap */
+
 #define BTN_STATE_NUM                (13)        /* The number of states in state machine               */
 #define BTN_TRG_NUM                  (4)         /* The number of trigger event in state machine        */
 
@@ -82,6 +126,10 @@ extern "C" {
 #define BTN_HOLDING_ST               (12)        /* Button is long pressed                              */
 #define BTN_NONE_EVT                 (13)        /* No event with the button                            */
 #define BTN_DIS_ST                   (14)        /* Button is disabled                                  */
+#define BTN_TOGGLE_ON_EVT            (15)        /* Toggle button is just latched on                    */
+#define BTN_TOGGLE_OFF_EVT           (16)        /* Toggle button is just latched off                   */
+#define BTN_PRESS_TENTATIVE_EVT      (17)        /* Button is maybe pressed, before debounce            */
+#define BTN_PRESS_RETRACT_EVT        (18)        /* The tentative press is retracted                    */
 
 #define BTN_GO_BACK_OFFSET           (3)         /* Offset betwen debounce state and previous ones      */
 #define BTN_TM_TRG_EVT_OFFSET        (2)         /* Offset for time out trigger in state table          */
@@ -105,6 +153,24 @@ extern "C" {
 #define BTN_STATE_0                  (0)         /* The state of button is "0"        */
 #define BTN_STATE_1                  (1)         /* The state of button is "1"        */
 
+#define BTN_MODE_NORMAL              (0)         /* Normal button                     */
+#define BTN_MODE_PULSE               (1)         /* Pulse counter (__BTN_SM_PULSE_CNT)*/
+#define BTN_MODE_TOGGLE              (2)         /* Toggle button (__BTN_SM_TOGGLE)   */
+#define BTN_MODE_NUM                 (3)         /* Number of channel modes           */
+
+#define BTN_OPT_SPECULATIVE          (0x01)      /* Speculative press events          */
+
+/* u8Mode and u8Opt are members of T_BTN_PARA only if some MACRO uses them */
+#if defined(__BTN_SM_PULSE_CNT) || defined(__BTN_SM_TOGGLE) || defined(__BTN_SM_SPECULATIVE)
+#define __BTN_SM_CH_MODE
+#endif
+
+#define BTN_MAP_PRESSED              (0)         /* Bitmap of debounced pressed       */
+#define BTN_MAP_HOLDING              (1)         /* Bitmap of long pressed            */
+#define BTN_MAP_EVT                  (2)         /* Bitmap of event in last process   */
+#define BTN_MAP_LATCH                (3)         /* Bitmap of toggle latch            */
+#define BTN_MAP_NUM                  (3)         /* Number of bitmaps kept by process */
+
 /* Function type definition */
 /******************************************************************************
 * Name       : uint8  (*)(uint8 u8Ch)
@@ -148,6 +214,19 @@ typedef uint16 (*PF_GET_TM)();
                uint8   u8NormalSt      BTN_NORMAL_0      The normal state of button is "0"
                                        BTN_NORMAL_1      The normal state of button is "1"
                uint8   u8Ch            1~255             Channel number of button       
+               uint8   u8Mode          BTN_MODE_NORMAL   Normal button
+                                       BTN_MODE_PULSE    Pulse counter
+                                       BTN_MODE_TOGGLE   Toggle button
+               uint8   u8Opt           0                 No option
+                                       BTN_OPT_XXX       Options of the channel (bits)
+               uint8   u8SrcCh         0                 Physical channel, input is read
+                                       1~u8Ch-1          Logical channel of the source
+                                                         channel (__BTN_SM_LOGICAL)
+               u8Mode and u8Opt are members only with __BTN_SM_PULSE_CNT,
+               __BTN_SM_TOGGLE or __BTN_SM_SPECULATIVE. When they are, set them
+               (0 for a normal button without option) before Btn_Channel_Init(),
+               e.g. clear the whole structure first, as Btn_Channel_Init() fails
+               on unknown values.
 *******************************************************************************/
 typedef struct _T_BTN_PARA_
 {
@@ -159,6 +238,13 @@ typedef struct _T_BTN_PARA_
     uint8       u8BtnEn;            /* Enable or disable function      */
     uint8       u8NormalSt;         /* Normal(stable) state of button  */
     uint8       u8Ch;               /* Channel number of button        */
+#ifdef __BTN_SM_CH_MODE
+    uint8       u8Mode;             /* Mode of the channel             */
+    uint8       u8Opt;              /* Options of the channel          */
+#endif
+#ifdef __BTN_SM_LOGICAL
+    uint8       u8SrcCh;            /* Source channel of logical one   */
+#endif
 }T_BTN_PARA;
 
 /*******************************************************************************
@@ -169,6 +255,10 @@ typedef struct _T_BTN_PARA_
 *                               BTN_LONG_PRESSED_EVT  Button is just long pressed
 *                               BTN_S_RELEASED_EVT    Button is just released from short press
 *                               BTN_L_RELEASED_EVT    Button is just released from long press
+*                               BTN_TOGGLE_ON_EVT     Toggle button is just latched on
+*                               BTN_TOGGLE_OFF_EVT    Toggle button is just latched off
+*                               BTN_PRESS_TENTATIVE_EVT Button is maybe pressed
+*                               BTN_PRESS_RETRACT_EVT The tentative press is retracted
 *              uint8   u8State  BTN_IDLE_ST           Button is in idle state
 *                               BTN_PRESS_AFT_ST      Button is in short pressed state
 *                               BTN_HOLDING_ST        Button is in long pressed state
@@ -201,6 +291,339 @@ typedef struct _T_BTN_ST_
     uint8   u8BtnSt;                /* The state of state machine         */
 }T_BTN_ST;
 
+#ifdef __BTN_SM_FLIGHT_RECORDER
+/*******************************************************************************
+* Structure  : T_BTN_REC_ITEM
+* Description: Structure of one recorded transition.
+* Memebers   : Type    Member   Range                 Descrption
+*              uint16  u16Tm    0~65535               Time of the transition
+*              uint8   u8St     BTN_PRESS_EVT~        The new state of state machine
+*                               BTN_HOLDING_ST
+*                               BTN_NONE_EVT          Empty item
+*              uint8   u8Trg    0~(BTN_TRG_NUM-1)     The trigger(column of state table)
+*******************************************************************************/
+typedef struct _T_BTN_REC_ITEM_
+{
+    uint16  u16Tm;                  /* Time of the transition             */
+    uint8   u8St;                   /* The new state of state machine     */
+    uint8   u8Trg;                  /* The trigger of the transition      */
+}T_BTN_REC_ITEM;
+
+/*******************************************************************************
+* Structure  : T_BTN_REC
+* Description: Structure of flight recorder of one channel.
+* Memebers   : Type             Member   Range    Descrption
+*              T_BTN_REC_ITEM*  ptItem            Ring buffer of recorded transitions
+*              uint8            u8Depth  1~255    Number of items in the ring buffer
+*              uint8            u8Idx    0~254    Index of the next item to be written
+*******************************************************************************/
+typedef struct _T_BTN_REC_
+{
+    T_BTN_REC_ITEM *ptItem;         /* Ring buffer of transitions         */
+    uint8           u8Depth;        /* Number of items in ring buffer     */
+    uint8           u8Idx;          /* Index of the next item             */
+}T_BTN_REC;
+
+/******************************************************************************
+* Name       : void (*)(uint8 u8Ch, const T_BTN_REC_ITEM *ptItem)
+* Function   : Output one recorded transition
+* Input      : uint8 u8Ch                1~255   The number of button channel
+*              const T_BTN_REC_ITEM *ptItem      The recorded transition
+* Output:    : None
+* Return     : None
+* description: Called from the oldest item to the newest one when dumping.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+typedef void (*PF_BTN_REC_OUT)(uint8 u8Ch, const T_BTN_REC_ITEM *ptItem);
+#endif
+
+#ifdef __BTN_SM_TRACE
+/******************************************************************************
+* Name       : void (*)(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt)
+* Function   : Trace one process of a button channel
+* Input      : uint8 u8Ch       1~255               The number of button channel
+*              uint8 u8BtnSt    BTN_STATE_0/1       Raw input of the button
+*              uint8 u8St       BTN_PRESS_EVT~      Internal state of state machine after
+*                               BTN_HOLDING_ST      the process (including hidden ones)
+*              uint8 u8Evt      BTN_PRESSED_EVT~    Event output by the process
+*                               BTN_NONE_EVT
+* Output:    : None
+* Return     : None
+* description: Called at the end of each successful Btn_Channel_Process() of an
+*              enabled channel. Keep it short, it runs in the scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+typedef void (*PF_BTN_TRACE)(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt);
+#endif
+
+#ifdef __BTN_SM_SOA
+/*******************************************************************************
+* Structure  : T_BTN_EVT_ITEM
+* Description: Structure of one event in the event list of a scan.
+* Memebers   : Type    Member   Range          Descrption
+*              uint8   u8Ch     1~MAX_BTN_CH   Channel number of the event
+*              uint8   u8Evt    BTN_XXX_EVT    The event
+*******************************************************************************/
+typedef struct _T_BTN_EVT_ITEM_
+{
+    uint8       u8Ch;               /* Channel number */
+    uint8       u8Evt;              /* Event          */
+}T_BTN_EVT_ITEM;
+
+/*******************************************************************************
+* Structure  : T_BTN_SOA
+* Description: Structure of scan results in structure-of-arrays form.
+* Memebers   : Type            Member        Range          Descrption
+*              uint8           au8State[]    BTN_XXX_ST     State of channel N in [N-1]
+*              uint32          au32EvtMap[]  0~0xFFFFFFFF   Bit of channel N is set if it
+*                                                           has an event in this scan
+*              T_BTN_EVT_ITEM  atEvt[]                      Events of this scan in
+*                                                           channel order
+*              uint8           u8EvtNum      0~MAX_BTN_CH   Number of items in atEvt[]
+*******************************************************************************/
+typedef struct _T_BTN_SOA_
+{
+    uint8           au8State[MAX_BTN_CH];       /* States of channels      */
+    uint32          au32EvtMap[BTN_MAP_WORDS];  /* Event bitmap            */
+    T_BTN_EVT_ITEM  atEvt[MAX_BTN_CH];          /* Event list              */
+    uint8           u8EvtNum;                   /* Number of events        */
+}T_BTN_SOA;
+#endif
+
+#ifdef __BTN_SM_SLEEP
+/*******************************************************************************
+* Structure  : T_BTN_PIN
+* Description: Structure of the input pin of one channel in the port words.
+* Memebers   : Type    Member        Range              Descrption
+*              uint8   u8Port        0~BTN_SLEEP_PORTS-1 Word of the input ports
+*              uint8   u8Bit         0~31               Bit in the word
+*******************************************************************************/
+typedef struct _T_BTN_PIN_
+{
+    uint8       u8Port;                     /* Word of the input ports  */
+    uint8       u8Bit;                      /* Bit in the word          */
+}T_BTN_PIN;
+
+/*******************************************************************************
+* Structure  : T_BTN_SLEEP
+* Description: Structure of the view of the inputs handed to the wake detector.
+*              The words are in the layout of the input port words given to
+*              Btn_Sleep_Check() and Btn_Sleep_Wake(), as mapped by the pins
+*              given to Btn_Sleep_Enter().
+* Memebers   : Type    Member        Range          Descrption
+*              T_BTN_PIN *ptPin                     Pins of channels, NULL: bit
+*                                                   (N-1) of the words is channel N
+*              uint32  au32Norm[]    0~0xFFFFFFFF   Normal(stable) state of pins
+*              uint32  au32Mask[]    0~0xFFFFFFFF   Pins of enabled channels
+*******************************************************************************/
+typedef struct _T_BTN_SLEEP_
+{
+    const T_BTN_PIN *ptPin;                 /* Pins of channels         */
+    uint32      au32Norm[BTN_SLEEP_PORTS];  /* Normal state of pins     */
+    uint32      au32Mask[BTN_SLEEP_PORTS];  /* Pins of enabled channels */
+}T_BTN_SLEEP;
+#endif
+
+#ifdef __BTN_SM_INTERLOCK
+#define BTN_RULE_INHIBIT             (0)         /* Targets are ignored while a source is active     */
+#define BTN_RULE_EXCLUSIVE           (1)         /* Only one channel of the group can be active      */
+#define BTN_RULE_HOLDOFF             (2)         /* Targets are ignored within a time after a source */
+
+/*******************************************************************************
+* Structure  : T_BTN_RULE
+* Description: Structure of one interlock rule. Bit (N-1) of the words is channel N.
+* Memebers   : Type    Member        Range               Descrption
+*              uint8   u8Type        BTN_RULE_XXX        Type of the rule (config)
+*              uint8   u8Map         BTN_MAP_PRESSED     Source is active if pressed
+*                                    BTN_MAP_HOLDING     Source is active if long pressed
+*                                    BTN_MAP_LATCH       Source is active if latched on
+*                                                        (config, NOT used by HOLDOFF)
+*              uint16  u16HoldTm     1~65535             Time after a source press
+*                                                        (config, HOLDOFF only)
+*              uint32  au32Src[]     0~0xFFFFFFFF        Source channels, or the group
+*                                                        of EXCLUSIVE (config)
+*              uint32  au32Dst[]     0~0xFFFFFFFF        Target channels (config, NOT
+*                                                        used by EXCLUSIVE)
+*              uint32  u32SuppCnt    0~                  Presses suppressed by the rule
+*              uint16  u16SrcTm      0~65535             Time of the last source press
+*              uint8   u8Armed       0/1                 A source was pressed (HOLDOFF)
+*              uint8   u8First       0~                  First word with sources
+*              uint8   u8Last        0~                  Last word with sources
+*              The members without "config" are kept by the module.
+*******************************************************************************/
+typedef struct _T_BTN_RULE_
+{
+    uint8       u8Type;                     /* Type of the rule            */
+    uint8       u8Map;                      /* Bitmap of active sources    */
+    uint16      u16HoldTm;                  /* Hold-off time               */
+    uint32      au32Src[BTN_MAP_WORDS];     /* Source channels             */
+    uint32      au32Dst[BTN_MAP_WORDS];     /* Target channels             */
+    uint32      u32SuppCnt;                 /* Suppressed presses          */
+    uint16      u16SrcTm;                   /* Time of last source press   */
+    uint8       u8Armed;                    /* A source was pressed        */
+    uint8       u8First;                    /* First word with sources     */
+    uint8       u8Last;                     /* Last word with sources      */
+}T_BTN_RULE;
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+/*******************************************************************************
+* Structure  : T_BTN_LP_CAL
+* Description: Structure of long-press time calibration of one channel or a
+*              profile (several channels with the same structure).
+* Memebers   : Type    Member        Range       Descrption
+*              uint16  u16MinTm      1~65535     Min long-press time (config)
+*              uint16  u16MaxTm      1~65535     Max long-press time (config)
+*              uint16  u16Margin     0~65535     Long-press time above the quantile
+*                                                of short presses (config)
+*              uint16  u16UndoTm     0~65535     A long press released within it
+*                                                after the long-press event is an
+*                                                accidental one, 0: NOT used (config)
+*              uint8   u8Quantile    1~99        Quantile of short presses in
+*                                                percent, e.g. 95 (config)
+*              uint16  u16LongTm     1~65535     Long-press time in use
+*              uint32  u32Est        0~          Quantile estimate (1/16 time unit)
+*              uint16  u16Step       1~          Step of the estimate (1/16 unit)
+*              uint8   u8Dir         0~2         Direction of the last step
+*              uint32  u32Cnt        0~          Samples of hold time
+*              The members without "config" are kept by the module.
+*******************************************************************************/
+typedef struct _T_BTN_LP_CAL_
+{
+    uint16      u16MinTm;           /* Min long-press time           */
+    uint16      u16MaxTm;           /* Max long-press time           */
+    uint16      u16Margin;          /* Margin above the quantile     */
+    uint16      u16UndoTm;          /* Time of accidental long press */
+    uint8       u8Quantile;         /* Quantile in percent           */
+    uint8       u8Dir;              /* Direction of the last step    */
+    uint16      u16LongTm;          /* Long-press time in use        */
+    uint16      u16Step;            /* Step of the estimate          */
+    uint32      u32Est;             /* Quantile estimate             */
+    uint32      u32Cnt;             /* Samples of hold time          */
+}T_BTN_LP_CAL;
+#endif
+
+#ifdef __BTN_SM_REPLICA
+/*******************************************************************************
+* Structure  : T_BTN_REPL_ITEM
+* Description: Structure of one replicated change: the whole running status of
+*              one channel after the change.
+* Memebers   : Type    Member        Range          Descrption
+*              uint32  u32Digest     0~0xFFFFFFFF   Digest of all channels of the
+*                                                   primary after the change
+*              uint16  u16DbTm       0~65535        u16DebounceOldTm
+*              uint16  u16LpTm       0~65535        u16LongPressOldTm
+*              uint8   u8Ch          1~MAX_BTN_CH   The number of button channel
+*              uint8   u8St          BTN_PRESS_EVT~ u8BtnSt
+*              uint8   u8Latch       0/1            Latch of toggle channel
+*              uint8   u8En          BTN_FUNC_XXX   u8BtnEn of the parameters
+*              uint16  u16LongTm     0~65535        u16LongPressTm of the parameters
+*                                                   (__BTN_SM_LP_ADAPT)
+*              uint16  u16CalTm      0~65535        u16LongTm of the calibration,
+*                                                   0: NOT calibrated (__BTN_SM_LP_ADAPT)
+*******************************************************************************/
+typedef struct _T_BTN_REPL_ITEM_
+{
+    uint32      u32Digest;          /* Digest after the change     */
+    uint16      u16DbTm;            /* Start time of debounce      */
+    uint16      u16LpTm;            /* Start time of long press    */
+    uint8       u8Ch;               /* Channel number              */
+    uint8       u8St;               /* State of state machine      */
+    uint8       u8Latch;            /* Latch of toggle channel     */
+    uint8       u8En;               /* Enable or disable function  */
+#ifdef __BTN_SM_LP_ADAPT
+    uint16      u16LongTm;          /* Long-press time in use      */
+    uint16      u16CalTm;           /* Long-press time calibrated  */
+#endif
+}T_BTN_REPL_ITEM;
+
+/*******************************************************************************
+* Structure  : T_BTN_REPL_RING
+* Description: Structure of the replication ring, in memory shared by the primary
+*              and the standby.
+* Memebers   : Type    Member        Range          Descrption
+*              uint32  u32Head       0~             Items written, by the primary
+*              uint32  u32Tail       0~             Items applied, by the standby
+*              uint32  u32Lost       0~             Changes NOT written for the
+*                                                   ring was full, by the primary
+*              T_BTN_REPL_ITEM atItem[]             The items
+*******************************************************************************/
+typedef struct _T_BTN_REPL_RING_
+{
+    volatile uint32 u32Head;                    /* Written by the primary */
+    volatile uint32 u32Tail;                    /* Written by the standby */
+    volatile uint32 u32Lost;                    /* Written by the primary */
+    T_BTN_REPL_ITEM atItem[BTN_REPL_LEN];       /* The items              */
+}T_BTN_REPL_RING;
+#endif
+
+#ifdef __BTN_SM_PULSE_CNT
+/*******************************************************************************
+* Structure  : T_BTN_PULSE
+* Description: Structure of pulse counter of one channel in BTN_MODE_PULSE.
+* Memebers   : Type    Member          Range      Descrption
+*              uint16  u16WinTm        1~65535    Measure window (config)
+*              uint32  u32Cnt          0~         Total debounced edges (wraps around)
+*              uint32  u32WinCnt       0~         Edges in the current window
+*              uint16  u16Freq         0~65535    Edges per 1000 time units in the last
+*                                                 window (Hz if the time unit is 1ms)
+*              uint16  u16Period       0~65535    Time between the last two edges
+*              uint16  u16WinStartTm   0~65535    Start time of the current window
+*              uint16  u16EdgeTm       0~65535    Time of the last edge
+*******************************************************************************/
+typedef struct _T_BTN_PULSE_
+{
+    uint32  u32Cnt;                 /* Total edges                        */
+    uint32  u32WinCnt;              /* Edges in current window            */
+    uint16  u16WinTm;               /* Measure window                     */
+    uint16  u16Freq;                /* Frequency of the last window       */
+    uint16  u16Period;              /* Period of the last two edges       */
+    uint16  u16WinStartTm;          /* Start time of current window       */
+    uint16  u16EdgeTm;              /* Time of the last edge              */
+}T_BTN_PULSE;
+#endif
+
+#ifdef __BTN_SM_METRICS
+/*******************************************************************************
+* Structure  : T_BTN_METRICS
+* Description: Structure of metrics of button state machine.
+* Memebers   : Type    Member          Range      Descrption
+*              uint32  u32ScanCnt      0~         Number of scans (all scan functions)
+*              uint32  u32ScanTmSum    0~         Total scan duration in ticks
+*              uint32  u32EvtCnt       0~         Number of events output (final events)
+*              uint32  u32ErrCnt       0~         Number of failed button state getting
+*              uint32  u32ReplDepth    0~BTN_REPL_LEN  Items in the replication ring NOT
+*                                                 applied by the standby yet
+*              uint32  u32ReplLost     0~         Changes NOT replicated for the ring
+*                                                 was full (u32Lost of the ring)
+*              uint32  u32SuppCnt      0~         Events suppressed by interlock rules
+*              uint16  u16ScanTm       0~65535    Duration of the last scan in ticks
+*              uint16  u16ScanTmMax    0~65535    Max duration of scans in ticks
+*              uint8   u8ActiveCh      0~255      Channels NOT idle in the last scan
+*******************************************************************************/
+typedef struct _T_BTN_METRICS_
+{
+    uint32  u32ScanCnt;             /* Counter: scans                     */
+    uint32  u32ScanTmSum;           /* Counter: total scan duration       */
+    uint32  u32EvtCnt;              /* Counter: events                    */
+    uint32  u32ErrCnt;              /* Counter: errors                    */
+#ifdef __BTN_SM_REPLICA
+    uint32  u32ReplDepth;           /* Gauge: items NOT applied by standby*/
+    uint32  u32ReplLost;            /* Counter: changes NOT replicated    */
+#endif
+#ifdef __BTN_SM_INTERLOCK
+    uint32  u32SuppCnt;             /* Counter: events suppressed by rules*/
+#endif
+    uint16  u16ScanTm;              /* Gauge: duration of last scan       */
+    uint16  u16ScanTmMax;           /* Gauge: max duration of scans       */
+    uint8   u8ActiveCh;             /* Gauge: channels NOT idle           */
+}T_BTN_METRICS;
+#endif
+
 
 /* Function declaration */
 /******************************************************************************
@@ -254,6 +677,17 @@ uint8 Btn_General_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt);
 *              before button checking.  
 *              This function save the parameter structure pointer for further 
 *              operation, and init running state of such channel.
+*              With __BTN_SM_LOGICAL, a channel with u8SrcCh is a logical channel:
+*              it does NOT read any input, but takes the debounced pressed state
+*              of channel u8SrcCh (pressed, long pressed, or released but NOT yet
+*              debounced) as its input, so one input read and one debounce feed
+*              several channels with their own long-press time, mode and options.
+*              u8SrcCh must be less than u8Ch, so the source is processed first in
+*              a scan; set u16DebounceTm of the logical channel to 0, its events
+*              then follow the ones of the source by 2 process calls.
+*              u8Mode and u8Opt (if they are members) must be known and enabled
+*              by their MACRO (e.g. BTN_MODE_TOGGLE needs __BTN_SM_TOGGLE),
+*              otherwise BTN_ERROR is returned.
 *
 *              NOTE:If the channel init is failed, DO NOT continue!!
 * Version    : V1.00
@@ -279,6 +713,8 @@ uint8 Btn_Channel_Init(uint8 u8Ch ,T_BTN_PARA *ptBtnPara);
 *              SUCCESS       Process operation is successed
 * description: This function should be called after general init and channel init.
 *              This function should be polled to check button event and state.
+*              Poll the channels in ascending order, the general time is then got
+*              once per pass (please refer to Btn_Scan_Time_Set()).
 *              ------------------------------------------------------------------------------
 *             | No.1 Demo of long press and release with debounce check
 *             |  ________                                                ______________ ________
@@ -394,6 +830,747 @@ uint8 Btn_Channel_Process(uint8 u8Ch, T_BTN_RESULT* ptBtnRes);
 ******************************************************************************/
 uint8 Btn_SM_Easy_Init(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt);
 
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid
+*              SUCCESS       Process operation is successed
+* description: Same as calling Btn_Channel_Process() for channel 1~MAX_BTN_CH.
+*              All channels should be initialized. A failed channel does NOT stop
+*              the scan of the others.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process(T_BTN_RESULT* ptBtnRes);
+
+/******************************************************************************
+* Name       : void Btn_Scan_Time_Set(uint16 u16Tm)
+* Function   : Give the general time of the next scan
+* Input      : uint16 u16Tm    0~65535    The general time
+* Output:    : None
+* Return     : None
+* description: The process functions get the general time with "pfGetTm()" at most
+*              once per scan, and only when some channel needs it. A scan is one
+*              call of the scan functions, or one pass of Btn_Channel_Process()
+*              over the channels: a call for a channel NOT above the last one
+*              processed starts a new scan. If the caller already has the time,
+*              call this function before the scan, then "pfGetTm()" is NOT called
+*              in that scan at all.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Scan_Time_Set(uint16 u16Tm);
+
+#ifdef __BTN_SM_CONST_TIME
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_CT(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once in constant time
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid
+*              SUCCESS       Process operation is successed
+* description: Same results as Btn_Scan_Process() for normal channels only, but
+*              every channel executes the same instruction path regardless of its
+*              state, input and enable control, so the scan time only depends on
+*              MAX_BTN_CH:
+*              - The general time is got once per scan, NOT per channel, even if
+*                no channel is in timing.
+*              - Both timers are always checked and the state table selects the
+*                one in use; state updates and timer starts are done with masks.
+*              - The button state getting function is called for disabled channels
+*                too (the result is masked). A channel whose state is BTN_ERROR
+*                keeps its state and the scan returns BTN_ERROR at the end.
+*              - Flight recorder and trace hook are NOT run here. Metrics are
+*                counted without branches.
+*              - Channel modes, options, logical channels, long-press calibration,
+*                interlock rules, the digest and the replication are NOT run here,
+*                so __BTN_SM_CONST_TIME can NOT be defined with their MACRO
+*                (checked at compile time).
+*              Data-dependent cost left in the path (must be bounded by the user):
+*              - The button state getting function "pfGetBtnSt()".
+*              - The general time getting function "pfGetTm()" (once per scan).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_CT(T_BTN_RESULT* ptBtnRes);
+#endif
+
+#ifdef __BTN_SM_SOA
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_SoA(T_BTN_SOA *ptOut)
+* Function   : Process all button channels at once, output in structure-of-arrays
+* Input      : None
+* Output:    : T_BTN_SOA *ptOut    State array, event bitmap and event list
+* Return     : BTN_ERROR           Input parameter or any button state is invalid
+*              SUCCESS             Process operation is successed
+* description: Same as Btn_Scan_Process(), but only the changes are written:
+*              - A state in au8State[] is written only if it differs.
+*              - The event bits of the last scan are cleared with its event list,
+*                then the events of this scan are put into the bitmap and the list.
+*              So an idle scan writes nothing but u8EvtNum.
+*              Clear the whole structure before the first scan, then the states of
+*              all channels are written at the first scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_SoA(T_BTN_SOA *ptOut);
+#endif
+
+#ifdef __BTN_SM_GROUP
+/******************************************************************************
+* Name       : uint8 Btn_Group_Build(void)
+* Function   : Group the channels by channel mode for Btn_Scan_Process_Grp()
+* Input      : None
+* Output:    : None
+* Return     : BTN_ERROR     Some channel is NOT initialized, or the group of a
+*                            logical channel is before the group of its source
+*              SUCCESS       The groups are built
+* description: Call this function after all channels are initialized, and again
+*              after u8Mode of any channel is changed. Modes NOT enabled by their
+*              MACRO are grouped as BTN_MODE_NORMAL.
+*              The groups are processed in order of BTN_MODE_XXX, so a source must
+*              be in the group of its logical channel or in a group before it,
+*              otherwise the logical channel would see the state of the source of
+*              the last scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Group_Build(void);
+
+/******************************************************************************
+* Name       : uint8 Btn_Scan_Process_Grp(T_BTN_RESULT* ptBtnRes)
+* Function   : Process all button channels at once, grouped by channel mode
+* Input      : None
+* Output:    : T_BTN_RESULT* ptBtnRes   Array of MAX_BTN_CH results, result of
+*                                       channel N is stored in ptBtnRes[N-1]
+* Return     : BTN_ERROR     Input parameter or any button state is invalid, or
+*                            the groups are NOT built
+*              SUCCESS       Process operation is successed
+* description: Same results as Btn_Scan_Process(), but the channels of one mode are
+*              processed in one loop with the mode as a constant, so the mode
+*              checks do NOT change from channel to channel and a mixed scan costs
+*              the same as a scan of one mode. The results stay in channel order.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Scan_Process_Grp(T_BTN_RESULT* ptBtnRes);
+#endif
+
+#ifdef __BTN_SM_SLEEP
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Enter(T_BTN_SLEEP *ptSleep, const T_BTN_PIN *ptPin)
+* Function   : Check if the module may sleep and get the view of the inputs
+* Input      : const T_BTN_PIN *ptPin  Pins of channel 1~MAX_BTN_CH in the input
+*                                      port words, NULL: bit (N-1) is channel N
+* Output:    : T_BTN_SLEEP *ptSleep    Normal states and mask of enabled channels
+* Return     : BTN_ERROR               Some enabled channel is NOT in BTN_IDLE_ST,
+*                                      a hold-off rule is being timed, a snapshot
+*                                      of the replication is NOT written yet, the
+*                                      pin of some channel is out of the ports, or
+*                                      input parameter is invalid
+*              SUCCESS                 The scan may be stopped
+* description: After SUCCESS, stop calling the process functions and check the inputs
+*              with Btn_Sleep_Check() (e.g. in the port interrupt or a low power
+*              timer) until it returns 1, then call Btn_Sleep_Wake().
+*              The masks are built in the layout of the pins, so the GPIO input
+*              registers can be given to Btn_Sleep_Check() as they are read, with
+*              NO remap of bits. The pins of logical channels are NOT used. The
+*              pins are kept in ptSleep for Btn_Sleep_Wake().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Enter(T_BTN_SLEEP *ptSleep, const T_BTN_PIN *ptPin);
+
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Check(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port)
+* Function   : Check if any enabled input is NOT in its normal state
+* Input      : const T_BTN_SLEEP *ptSleep    View got by Btn_Sleep_Enter()
+*              const uint32      *pu32Port   BTN_SLEEP_PORTS words of input levels,
+*                                            in the layout of the pins
+* Output:    : None
+* Return     : 1                             Wake up
+*              0                             Keep sleeping
+* description: One compare per word, the module state is NOT touched.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Check(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port);
+
+/******************************************************************************
+* Name       : uint8 Btn_Sleep_Wake(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port,
+*                                   uint16 u16EdgeTm)
+* Function   : Resume the module after sleep
+* Input      : const T_BTN_SLEEP *ptSleep    View got by Btn_Sleep_Enter()
+*              const uint32      *pu32Port   Input levels at wake up, as
+*                                            Btn_Sleep_Check(), NULL if no input
+*                                            is changed
+*              uint16             u16EdgeTm  General time of the wake up edge
+* Output:    : None
+* Return     : BTN_ERROR                     The module is NOT initialized, or
+*                                            input parameter is invalid
+*              SUCCESS                       The module is resumed
+* description: Enabled channels whose input is NOT in normal state go to
+*              BTN_PRESS_PRE_ST with the debounce started at u16EdgeTm, so the
+*              press is still debounced and reported as if the scan never stopped.
+*              For channels with BTN_OPT_SPECULATIVE, the next process outputs
+*              BTN_PRESS_TENTATIVE_EVT, unless the input is already released.
+*              Call the process functions as usual after this function.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Sleep_Wake(const T_BTN_SLEEP *ptSleep, const uint32 *pu32Port, uint16 u16EdgeTm);
+#endif
+
+#ifdef __BTN_SM_SPECULATIVE
+/******************************************************************************
+* Name       : uint8 Btn_Spec_Stat_Get(uint8 u8Ch, uint16 *pu16Tent, uint16 *pu16Retract)
+* Function   : Get the counters of speculative press events of one channel
+* Input      : uint8   u8Ch         1~255     The number of button channel
+* Output:    : uint16 *pu16Tent     0~65535   Number of BTN_PRESS_TENTATIVE_EVT
+*              uint16 *pu16Retract  0~65535   Number of BTN_PRESS_RETRACT_EVT
+* Return     : BTN_ERROR            Input parameter is invalid
+*              SUCCESS              The counters are got
+* description: Channels with BTN_OPT_SPECULATIVE in u8Opt output
+*              BTN_PRESS_TENTATIVE_EVT at the first edge out of BTN_IDLE_ST, before
+*              debounce. Then BTN_PRESSED_EVT confirms the press as usual, or
+*              BTN_PRESS_RETRACT_EVT is output if the debounce falls back to
+*              BTN_IDLE_ST, or if the press is suppressed by an interlock rule
+*              (instead of BTN_PRESSED_EVT). Retract / tentative is the retraction
+*              rate of the channel. The counters wrap around.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Spec_Stat_Get(uint8 u8Ch, uint16 *pu16Tent, uint16 *pu16Retract);
+#endif
+
+#ifdef __BTN_SM_INTERLOCK
+/******************************************************************************
+* Name       : uint8 Btn_Rule_Init(T_BTN_RULE *ptRule, uint8 u8Num)
+* Function   : Set the interlock rule table
+* Input      : T_BTN_RULE *ptRule    Rules, must be kept by caller. NULL: no rule
+*              uint8       u8Num     Number of rules
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The rules are set
+* description: The rules are checked in the process of each channel, on each event,
+*              against the bitmaps (__BTN_SM_BITMAP) with word-wide operations:
+*                  * BTN_RULE_INHIBIT    A press of a target is suppressed while any
+*                                        source is active (e.g. jog buttons while
+*                                        E-stop is held).
+*                  * BTN_RULE_EXCLUSIVE  A press of a channel of the group is
+*                                        suppressed while any other channel of the
+*                                        group is active (e.g. radio buttons with
+*                                        BTN_MAP_LATCH).
+*                  * BTN_RULE_HOLDOFF    A press of a target is suppressed within
+*                                        u16HoldTm after a press of a source. While
+*                                        it is timed, the general time is got in
+*                                        every scan, so it ends in time.
+*              A suppressed press is NOT delivered, and the other events of the
+*              channel until its release are NOT delivered either (the latch of a
+*              toggle channel is NOT changed, the edge of a pulse counter is NOT
+*              counted). A suppressed channel is NOT active for the rules. For a
+*              channel with BTN_OPT_SPECULATIVE, BTN_PRESS_RETRACT_EVT is output
+*              instead of the suppressed press, to retract the tentative press.
+*              Each rule checks only the words between its first and last source,
+*              so the cost does NOT grow with the number of channels for rules of
+*              nearby channels.
+*
+*              NOTE: __BTN_SM_CONST_TIME can NOT be defined with it, as
+*                    Btn_Scan_Process_CT() does NOT check the rules.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Rule_Init(T_BTN_RULE *ptRule, uint8 u8Num);
+
+/******************************************************************************
+* Name       : uint32 Btn_Rule_Supp_Get(void)
+* Function   : Get the number of suppressed events of all rules
+* Input      : None
+* Output:    : None
+* Return     : 0~             Suppressed events (presses and the following events)
+* description: The suppressed presses of each rule are in u32SuppCnt of the rule.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Rule_Supp_Get(void);
+#endif
+
+#ifdef __BTN_SM_LP_ADAPT
+/******************************************************************************
+* Name       : uint8 Btn_Lp_Cal_Init(uint8 u8Ch, T_BTN_LP_CAL *ptCal)
+* Function   : Attach a long-press time calibration to one channel
+* Input      : uint8         u8Ch      1~255   The number of button channel
+*              T_BTN_LP_CAL *ptCal             Calibration, must be kept by caller.
+*                                              NULL: stop the calibration
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The calibration is attached
+* description: The hold time of each short press (from BTN_PRESSED_EVT to the
+*              release) is put into a streaming quantile estimate (frugal
+*              streaming: the estimate steps up or down towards each sample, with
+*              the up/down steps in the ratio of the quantile, and the step grows
+*              while it moves the same way and halves when it turns). No sample is
+*              stored, each update is O(1).
+*              The long-press time is the estimate plus u16Margin, within
+*              u16MinTm~u16MaxTm. It is written into u16LongPressTm of the channel
+*              at each BTN_PRESSED_EVT, so the running press keeps its time.
+*              Long presses are NOT short-press samples, but one released within
+*              u16UndoTm after its long-press event is put as a short press held
+*              for the whole long-press time, which pushes the time up.
+*              Attach the same structure to several channels for a profile. The
+*              estimate starts from u16LongPressTm of the first channel attached,
+*              and is NOT reset by attaching more channels (clear u32Cnt to
+*              restart it).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Lp_Cal_Init(uint8 u8Ch, T_BTN_LP_CAL *ptCal);
+#endif
+
+#ifdef __BTN_SM_REPLICA
+/******************************************************************************
+* Name       : uint8 Btn_Repl_Primary(T_BTN_REPL_RING *ptRing)
+* Function   : Start replicating the running status to a standby
+* Input      : T_BTN_REPL_RING *ptRing    Ring in shared memory. NULL: stop
+* Output:    : None
+* Return     : BTN_ERROR        Some channel is NOT initialized
+*              SUCCESS          The ring is set
+* description: The ring is cleared and a snapshot of all channels is written, then
+*              each change of a channel (transition, timer start, latch, enable)
+*              writes the whole running status of the channel into the ring, in
+*              O(1) and without waiting for the standby.
+*              If the ring is full, the change is counted in u32Lost and a new
+*              snapshot is written by the next scan (or change) when the ring has
+*              room for it, so the standby is in sync again after it, even if no
+*              channel changes. Btn_Sleep_Enter() fails until it is written.
+*              Call it after all channels are initialized, and before the standby
+*              calls Btn_Repl_Apply().
+*
+*              NOTE: __BTN_SM_CONST_TIME can NOT be defined with it, as
+*                    Btn_Scan_Process_CT() does NOT replicate. Pulse counters and
+*                    flight recorders are NOT replicated.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Repl_Primary(T_BTN_REPL_RING *ptRing);
+
+/******************************************************************************
+* Name       : uint8 Btn_Repl_Apply(T_BTN_REPL_RING *ptRing)
+* Function   : Apply the replicated changes on the standby
+* Input      : T_BTN_REPL_RING *ptRing    Ring in shared memory
+* Output:    : None
+* Return     : BTN_ERROR        The digest after the last change is NOT the one of
+*                               the primary (out of sync, e.g. changes were lost),
+*                               or input parameter is invalid
+*              SUCCESS          In sync
+* description: The standby initializes its channels with the same parameters as the
+*              primary, then calls this function periodically instead of the
+*              process functions. It keeps the digest of its own channels in the
+*              same way as the primary and compares it with the digest in each item.
+*              The enable control (u8BtnEn) of the standby is set as the one of
+*              the primary. With __BTN_SM_LP_ADAPT, so is the long-press time in
+*              use, and the calibration of the standby restarts its estimate from
+*              the calibrated time of the primary (the samples are NOT
+*              replicated), so the same long-press time is used after failover.
+*              On failover, the standby just starts the process functions: held
+*              buttons stay held and the timers keep their start times, so both
+*              processes must use the same general time.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Repl_Apply(T_BTN_REPL_RING *ptRing);
+
+/******************************************************************************
+* Name       : uint32 Btn_Repl_Digest_Get(void)
+* Function   : Get the digest of the running status of all channels
+* Input      : None
+* Output:    : None
+* Return     : 0~0xFFFFFFFF     The digest
+* description: The digest is the XOR of a hash of the running status of each
+*              channel, kept with each change in O(1). Two processes with the same
+*              running status of all channels have the same digest.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Repl_Digest_Get(void);
+#endif
+
+#ifdef __BTN_SM_DIGEST
+/******************************************************************************
+* Name       : uint32 Btn_Digest_Get(void)
+* Function   : Get the digest of the running status of all channels
+* Input      : None
+* Output:    : None
+* Return     : 0~0xFFFFFFFF     The digest
+* description: For redundant instances running in lockstep on redundant inputs.
+*              The digest is the XOR of a hash of each channel: the state, the
+*              latch of toggle channel, and the start time of the debounce or
+*              long-press timer while it is running. It is updated only on each
+*              change of a channel (transition, enable, latch, wake), so reading it
+*              once per scan costs one word. Instances with the same running status
+*              have the same digest, so a mismatch shows the divergence in O(1).
+*              Then compare the digests of the groups (Btn_Digest_Grp_Get()), and
+*              the channels of the groups which differ (Btn_Digest_Ch_Get() and
+*              Btn_Digest_Diff()).
+*
+*              NOTE: The instances must use the same general time, as the start
+*                    times of the timers are compared. __BTN_SM_CONST_TIME can NOT
+*                    be defined with it, as Btn_Scan_Process_CT() does NOT update
+*                    the digest.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Digest_Get(void);
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Grp_Get(uint32 *pu32Grp)
+* Function   : Get the digests of the groups of 32 channels
+* Input      : None
+* Output:    : uint32 *pu32Grp   BTN_MAP_WORDS digests, item N is channel 32N+1~32N+32
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The digests are got
+* description: The XOR of the digests of all groups is Btn_Digest_Get().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Grp_Get(uint32 *pu32Grp);
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Ch_Get(uint8 u8Word, uint32 *pu32Hash)
+* Function   : Get the hashes of the channels of one group
+* Input      : uint8   u8Word    0~BTN_MAP_WORDS-1   Index of the group
+* Output:    : uint32 *pu32Hash  32 hashes, item N is channel 32*u8Word+N+1
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The hashes are got
+* description: The hash of a channel beyond MAX_BTN_CH, or NOT initialized, is 0.
+*              Give the hashes to Btn_Digest_Diff() of the other instance.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Ch_Get(uint8 u8Word, uint32 *pu32Hash);
+
+/******************************************************************************
+* Name       : uint8 Btn_Digest_Diff(uint8 u8Word, const uint32 *pu32Hash, uint32 *pu32Diff)
+* Function   : Find the channels of one group which differ from the other instance
+* Input      : uint8         u8Word    0~BTN_MAP_WORDS-1   Index of the group
+*              const uint32 *pu32Hash  32 hashes of the other instance, got by
+*                                      Btn_Digest_Ch_Get()
+* Output:    : uint32       *pu32Diff  Bit N: channel 32*u8Word+N+1 differs
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The channels are compared
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Digest_Diff(uint8 u8Word, const uint32 *pu32Hash, uint32 *pu32Diff);
+#endif
+
+#ifdef __BTN_SM_FLIGHT_RECORDER
+/******************************************************************************
+* Name       : uint8 Btn_Rec_Init(uint8 u8Ch, T_BTN_REC *ptRec)
+* Function   : Attach a flight recorder to one button channel
+* Input      : uint8      u8Ch     1~255      The number of button channel
+*              T_BTN_REC *ptRec               Recorder with ring buffer and depth set,
+*                                             NULL to detach the recorder
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: Call this function after channel init for the channels to be recorded.
+*              The ring buffer is cleared here. Each state transition of the channel
+*              is then stored as (tick, new state, trigger), overwriting the oldest
+*              one. Channels without recorder only cost one pointer.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Rec_Init(uint8 u8Ch, T_BTN_REC *ptRec);
+
+/******************************************************************************
+* Name       : uint8 Btn_Rec_Dump(uint8 u8Ch, PF_BTN_REC_OUT pfOut)
+* Function   : Dump the recorded transitions of one button channel
+* Input      : uint8          u8Ch     1~255      The number of button channel
+*              PF_BTN_REC_OUT pfOut               Function to output each transition
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or no recorder attached
+*              SUCCESS          Dump operation is successed
+* description: Transitions are output from the oldest to the newest one.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Rec_Dump(uint8 u8Ch, PF_BTN_REC_OUT pfOut);
+
+/******************************************************************************
+* Name       : void Btn_Rec_Fault_Set(PF_BTN_REC_OUT pfOut)
+* Function   : Set the function to dump the recorder on fault
+* Input      : PF_BTN_REC_OUT pfOut    Function to output each transition,
+*                                      NULL to disable dump on fault
+* Output:    : None
+* Return     : None
+* description: If the button state getting function returns BTN_ERROR, the recorder
+*              of such channel is dumped with pfOut before Btn_Channel_Process()
+*              returns BTN_ERROR.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Rec_Fault_Set(PF_BTN_REC_OUT pfOut);
+#endif
+
+#ifdef __BTN_SM_TRACE
+/******************************************************************************
+* Name       : void Btn_Trace_Set(PF_BTN_TRACE pfTrace)
+* Function   : Set the trace hook of button state machine
+* Input      : PF_BTN_TRACE pfTrace    Function to trace each process, NULL to disable
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Trace_Set(PF_BTN_TRACE pfTrace);
+#endif
+
+#ifdef __BTN_SM_PULSE_CNT
+/******************************************************************************
+* Name       : uint8 Btn_Pulse_Init(uint8 u8Ch, T_BTN_PULSE *ptPulse)
+* Function   : Attach a pulse counter to one button channel in BTN_MODE_PULSE
+* Input      : uint8        u8Ch      1~255      The number of button channel
+*              T_BTN_PULSE *ptPulse              Pulse counter with u16WinTm set
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or the module is NOT
+*                               initialized by Btn_General_Init()
+*              SUCCESS          Init operation is successed
+* description: Call this function after channel init. The channel shares the input
+*              reading and the debounce (glitch filter) of the state machine, and
+*              each debounced press (BTN_PRESSED_EVT) is counted as one edge. The
+*              events of such channel are NOT output, only the state is.
+*              The counters are cleared and the first window starts here.
+*
+*              NOTE: One pulse takes about 8 processes of the channel, so the max
+*                    pulse rate of one channel is about 1/8 of the scan rate.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Pulse_Init(uint8 u8Ch, T_BTN_PULSE *ptPulse);
+#endif
+
+#ifdef __BTN_SM_TOGGLE
+/******************************************************************************
+* Name       : uint8 Btn_Latch_Get(uint8 u8Ch)
+* Function   : Get the latch of one toggle button
+* Input      : uint8 u8Ch  1~255   The number of button channel
+* Output:    : None
+* Return     : 0/1                 Latch of the channel
+*              BTN_ERROR           Channel number is invalid
+* description: Channels in BTN_MODE_TOGGLE flip their latch on each debounced press,
+*              and BTN_PRESSED_EVT is replaced with BTN_TOGGLE_ON_EVT or
+*              BTN_TOGGLE_OFF_EVT. Other events are output as usual.
+*              The latch is kept when the channel is disabled, and cleared by
+*              Btn_Channel_Init().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Latch_Get(uint8 u8Ch);
+
+/******************************************************************************
+* Name       : uint32 Btn_Latch_Word_Get(uint8 u8Word)
+* Function   : Get the latches of 32 channels with one read
+* Input      : uint8 u8Word  0~BTN_MAP_WORDS-1   Index of the word
+* Output:    : None
+* Return     : Bit N is the latch of channel (u8Word * 32 + N + 1), 0 if u8Word is
+*              out of range
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Latch_Word_Get(uint8 u8Word);
+
+/******************************************************************************
+* Name       : uint8 Btn_Latch_Set(uint8 u8Ch, uint8 u8Latch)
+* Function   : Set the latch of one toggle button without event
+* Input      : uint8 u8Ch      1~255   The number of button channel
+*              uint8 u8Latch   0/1     New latch of the channel
+* Output:    : None
+* Return     : BTN_ERROR               Input parameter is invalid
+*              SUCCESS                 The latch is set
+* description: e.g. to restore the latches from non-volatile memory after init.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Latch_Set(uint8 u8Ch, uint8 u8Latch);
+#endif
+
+#ifdef __BTN_SM_BITMAP
+/******************************************************************************
+* Name       : uint32 Btn_Map_Word_Get(uint8 u8Map, uint8 u8Word)
+* Function   : Get 32 channels of one bitmap with one read
+* Input      : uint8 u8Map   BTN_MAP_PRESSED       Debounced pressed channels
+*                            BTN_MAP_HOLDING       Long pressed channels
+*                            BTN_MAP_EVT           Channels with event in last process
+*                            BTN_MAP_LATCH         Latched toggle channels (__BTN_SM_TOGGLE)
+*              uint8 u8Word  0~BTN_MAP_WORDS-1     Index of the word
+* Output:    : None
+* Return     : Bit N is channel (u8Word * 32 + N + 1), 0 if input is invalid
+* description: The bitmaps are updated by the process functions only when the state
+*              or the event of a channel changes, so the queries cost nothing between
+*              scans. A channel is "pressed" from the end of press debounce to the
+*              end of release debounce. Disabled channels are cleared.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Map_Word_Get(uint8 u8Map, uint8 u8Word);
+
+/******************************************************************************
+* Name       : uint8 Btn_Map_Any(uint8 u8Map)
+* Function   : Check if any channel is set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+* Output:    : None
+* Return     : 1             At least one channel is set
+*              0             No channel is set, or u8Map is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Any(uint8 u8Map);
+
+/******************************************************************************
+* Name       : uint8 Btn_Map_Count(uint8 u8Map)
+* Function   : Count the channels set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+* Output:    : None
+* Return     : 0~MAX_BTN_CH  Number of channels set, 0 if u8Map is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Count(uint8 u8Map);
+
+/******************************************************************************
+* Name       : uint8 Btn_Map_Next(uint8 u8Map, uint8 u8Ch)
+* Function   : Find the next channel set in one bitmap
+* Input      : uint8 u8Map   BTN_MAP_XXX   The bitmap
+*              uint8 u8Ch    0~255         Search after this channel, 0 to start
+* Output:    : None
+* Return     : 1~MAX_BTN_CH  The next channel set
+*              0             No more channel is set, or u8Map is invalid
+* description: Iterate the set channels with:
+*                  for(u8Ch = Btn_Map_Next(u8Map, 0); u8Ch; u8Ch = Btn_Map_Next(u8Map, u8Ch))
+*              Empty words are skipped, so it costs O(words) plus one step per channel.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Map_Next(uint8 u8Map, uint8 u8Ch);
+#endif
+
+#ifdef __BTN_SM_HOLD_PROGRESS
+/******************************************************************************
+* Name       : uint16 Btn_Hold_Progress_Get(uint8 u8Ch)
+* Function   : Get the progress of one pressed button toward long-press
+* Input      : uint8 u8Ch  1~255        The number of button channel
+* Output:    : None
+* Return     : 0~0xFFFF                 Elapsed / u16LongPressTm in Q0.16, 0xFFFF if
+*                                       the long-press time is reached
+*              0                        The channel is NOT in BTN_PRESS_AFT_ST, or
+*                                       the channel number is invalid
+* description: The progress is computed from the long-press start time of the
+*              channel and the last time got by the process (NO extra call of
+*              "pfGetTm()"), so it is as fresh as the last scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Btn_Hold_Progress_Get(uint8 u8Ch);
+
+/******************************************************************************
+* Name       : uint8 Btn_Hold_Next(uint8 u8Ch, uint16 *pu16Prog)
+* Function   : Find the next button in BTN_PRESS_AFT_ST and get its progress
+* Input      : uint8   u8Ch       0~255     Search after this channel, 0 to start
+* Output:    : uint16 *pu16Prog             Progress as Btn_Hold_Progress_Get()
+* Return     : 1~MAX_BTN_CH                 The next channel in BTN_PRESS_AFT_ST
+*              0                            No more channel
+* description: Iterate the channels being held toward long-press with:
+*                  for(u8Ch = Btn_Hold_Next(0, &u16Prog); u8Ch; u8Ch = Btn_Hold_Next(u8Ch, &u16Prog))
+*              Only channels in BTN_PRESS_AFT_ST are returned. With __BTN_SM_BITMAP
+*              the channels NOT pressed are skipped by words.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Hold_Next(uint8 u8Ch, uint16 *pu16Prog);
+#endif
+
+#ifdef __BTN_SM_METRICS
+/******************************************************************************
+* Name       : void Btn_Metrics_Tick_Set(PF_GET_TM pfGetTick)
+* Function   : Set the clock to measure scan duration
+* Input      : PF_GET_TM pfGetTick    Function to get a free running fine tick (e.g.
+*                                     us timer or cycle counter), NULL NOT to
+*                                     measure the scan duration
+* Output:    : None
+* Return     : None
+* description: The scan duration is measured only with this tick, it is called
+*              twice per scan. Without it the duration metrics stay 0; the general
+*              time is NOT used, as it is too coarse (1ms) and would be read in
+*              every scan, even when all channels are idle.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Metrics_Tick_Set(PF_GET_TM pfGetTick);
+
+/******************************************************************************
+* Name       : uint8 Btn_Metrics_Get(T_BTN_METRICS *ptMetrics)
+* Function   : Get a copy of the metrics
+* Input      : None
+* Output:    : T_BTN_METRICS *ptMetrics   Copy of the metrics
+* Return     : BTN_ERROR        The metrics were being written in all tries, or
+*                               input parameter is invalid
+*              SUCCESS          All values of the copy are of the same scan
+* description: Counters are only increased and wrap around, gauges show the
+*              latest value. The copy is checked by a sequence counter, so it may
+*              be called from another thread, but NOT from an interrupt which
+*              preempts the scan (all tries would fail).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Metrics_Get(T_BTN_METRICS *ptMetrics);
+#endif
+
 
 
 #ifdef __cplusplus
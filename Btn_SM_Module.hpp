@@ -0,0 +1,233 @@
+/******************************************************************************
+* File       : Btn_SM_Module.hpp
+* Function   : C++ facade of button state machine module for host code.
+* description: Header-only wrapper over the C functions of Btn_SM_Module.h:
+*                  * Btn_SM::Engine      Owning object of the module, init in
+*                                        constructor and all channels disabled in
+*                                        destructor (RAII)
+*                  * Btn_SM::Channel     Typed channel handle, NOT a raw uint8
+*                  * Btn_SM::EventView   Range over the pending events of a scan
+*              Batch results are passed as std::span of MAX_BTN_CH items, so the
+*              array size is checked by the compiler.
+*              All functions are inline and only forward to the C functions, so an
+*              optimized build is the same as the raw C calls. This can be checked
+*              with Btn_SM_Bench_Hpp.cpp.
+*
+*              HOW TO USE:
+*                  Btn_SM::Engine tEngine(Get_Time, Get_Btn);
+*                  std::array<T_BTN_RESULT, MAX_BTN_CH> atRes;
+*                  tEngine.Scan(atRes);
+*                  for(const Btn_SM::Event &tEvt : Btn_SM::Engine::Events(atRes)) {...}
+*
+*              NOTE: The module keeps its state in global variables, so only one
+*                    Engine can be alive at a time. A second one is NOT Ok() and
+*                    does nothing.
+*              NOTE: Needs C++20 (std::span).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#ifndef _BTN_SM_MODULE_HPP_
+#define _BTN_SM_MODULE_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+
+namespace Btn_SM
+{
+
+/*******************************************************************************
+* Class      : Channel
+* Description: Typed handle of one button channel (1~MAX_BTN_CH).
+*******************************************************************************/
+class Channel
+{
+public:
+    constexpr explicit Channel(uint8 u8Ch) : m_u8Ch(u8Ch) {}
+
+    constexpr uint8 Num() const { return m_u8Ch; }                   /* Channel number 1~  */
+    constexpr uint8 Idx() const { return (uint8)(m_u8Ch - 1); }      /* Index in arrays 0~ */
+    constexpr bool  Valid() const { return (0 != m_u8Ch) && (m_u8Ch <= MAX_BTN_CH); }
+
+    constexpr bool operator==(const Channel &tOther) const { return m_u8Ch == tOther.m_u8Ch; }
+
+private:
+    uint8 m_u8Ch;                   /* Channel number */
+};
+
+/*******************************************************************************
+* Structure  : Event
+* Description: One pending event of a scan.
+*******************************************************************************/
+struct Event
+{
+    Channel tCh;                    /* Channel of the event */
+    uint8   u8Evt;                  /* BTN_XXX_EVT          */
+};
+
+/*******************************************************************************
+* Class      : EventView
+* Description: Range over the results of a scan that have an event, in channel
+*              order. It does NOT own the results.
+*******************************************************************************/
+class EventView
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Event;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const Event*;
+        using reference         = Event;
+
+        Iterator() = default;
+        Iterator(const T_BTN_RESULT *ptCur, const T_BTN_RESULT *ptBeg, const T_BTN_RESULT *ptEnd)
+            : m_ptCur(ptCur), m_ptBeg(ptBeg), m_ptEnd(ptEnd) { Skip(); }
+
+        Event operator*() const
+        {
+            return Event{Channel((uint8)(m_ptCur - m_ptBeg + 1)), m_ptCur->u8Evt};
+        }
+        Iterator& operator++() { ++m_ptCur; Skip(); return *this; }
+        Iterator  operator++(int) { Iterator tOld = *this; ++(*this); return tOld; }
+        bool operator==(const Iterator &tOther) const { return m_ptCur == tOther.m_ptCur; }
+
+    private:
+        /* Move to the next result with event */
+        void Skip()
+        {
+            while((m_ptCur != m_ptEnd) && (BTN_NONE_EVT == m_ptCur->u8Evt))
+            {
+                ++m_ptCur;
+            }
+        }
+
+        const T_BTN_RESULT *m_ptCur = nullptr;
+        const T_BTN_RESULT *m_ptBeg = nullptr;
+        const T_BTN_RESULT *m_ptEnd = nullptr;
+    };
+
+    explicit EventView(std::span<const T_BTN_RESULT, MAX_BTN_CH> tRes) : m_tRes(tRes) {}
+
+    Iterator begin() const { return Iterator(m_tRes.data(), m_tRes.data(), m_tRes.data() + MAX_BTN_CH); }
+    Iterator end() const   { return Iterator(m_tRes.data() + MAX_BTN_CH, m_tRes.data(), m_tRes.data() + MAX_BTN_CH); }
+
+private:
+    std::span<const T_BTN_RESULT, MAX_BTN_CH> m_tRes;
+};
+
+/*******************************************************************************
+* Class      : Engine
+* Description: Owning object of the button state machine module.
+*******************************************************************************/
+class Engine
+{
+public:
+    /* Easy init, same parameters as Btn_SM_Easy_Init() */
+    Engine(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt)
+    {
+        if(Acquire())
+        {
+            m_bOk = (SUCCESS == Btn_SM_Easy_Init(pfGetTm, pfGetBtnSt));
+            Release_If_Failed();
+        }
+    }
+
+    /* Advanced init, atPara[N-1] is the parameter of channel N and must live
+       as long as the engine */
+    Engine(PF_GET_TM pfGetTm, PF_GET_BTN pfGetBtnSt, std::span<T_BTN_PARA, MAX_BTN_CH> atPara)
+    {
+        if(Acquire())
+        {
+            m_bOk = (SUCCESS == Btn_General_Init(pfGetTm, pfGetBtnSt));
+            for(uint8 u8Idx = 0; m_bOk && (u8Idx < MAX_BTN_CH); u8Idx++)
+            {
+                m_bOk = (SUCCESS == Btn_Channel_Init((uint8)(u8Idx + 1), &atPara[u8Idx]));
+            }
+            Release_If_Failed();
+        }
+    }
+
+    /* Disable all channels, so nothing is reported after the owner is gone */
+    ~Engine()
+    {
+        if(m_bOk)
+        {
+            for(uint8 u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+            {
+                Btn_Func_En_Dis(u8Ch, BTN_FUNC_DISABLE);
+            }
+            s_bAlive = false;
+        }
+    }
+
+    Engine(const Engine&)            = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    bool Ok() const { return m_bOk; }
+
+    /* Process one channel, Btn_Channel_Process() */
+    uint8 Process(Channel tCh, T_BTN_RESULT &tRes) { return Btn_Channel_Process(tCh.Num(), &tRes); }
+
+    /* Process all channels, Btn_Scan_Process() */
+    uint8 Scan(std::span<T_BTN_RESULT, MAX_BTN_CH> atRes) { return Btn_Scan_Process(atRes.data()); }
+
+#ifdef __BTN_SM_CONST_TIME
+    /* Process all channels in constant time, Btn_Scan_Process_CT() */
+    uint8 Scan_CT(std::span<T_BTN_RESULT, MAX_BTN_CH> atRes) { return Btn_Scan_Process_CT(atRes.data()); }
+#endif
+
+#ifdef __BTN_SM_SOA
+    /* Process all channels with structure-of-arrays output, Btn_Scan_Process_SoA() */
+    uint8 Scan(T_BTN_SOA &tOut) { return Btn_Scan_Process_SoA(&tOut); }
+
+    /* Events of a structure-of-arrays scan */
+    static std::span<const T_BTN_EVT_ITEM> Events(const T_BTN_SOA &tOut)
+    {
+        return std::span<const T_BTN_EVT_ITEM>(tOut.atEvt, tOut.u8EvtNum);
+    }
+#endif
+
+    /* Enable or disable one channel, Btn_Func_En_Dis() */
+    void Enable(Channel tCh, bool bEn) { Btn_Func_En_Dis(tCh.Num(), bEn ? BTN_FUNC_ENABLE : BTN_FUNC_DISABLE); }
+
+    /* Pending events of a scan */
+    static EventView Events(std::span<const T_BTN_RESULT, MAX_BTN_CH> atRes) { return EventView(atRes); }
+
+private:
+    /* Only one engine can own the module */
+    bool Acquire()
+    {
+        if(s_bAlive)
+        {
+            return false;
+        }
+        s_bAlive = true;
+        return true;
+    }
+
+    void Release_If_Failed()
+    {
+        if(!m_bOk)
+        {
+            s_bAlive = false;
+        }
+    }
+
+    bool m_bOk = false;             /* Init is successed and the module is owned */
+    static inline bool s_bAlive = false;
+};
+
+} /* namespace Btn_SM */
+
+#endif /* _BTN_SM_MODULE_HPP_ */
+
+/* end-of-file */
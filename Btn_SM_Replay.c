@@ -0,0 +1,180 @@
+/******************************************************************************
+* File       : Btn_SM_Replay.c
+* Function   : Replay recorded button input traces through the state machine.
+* description: Please refer to Btn_SM_Replay.h for details.
+* Version    : V1.01
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Add port words of inputs
+******************************************************************************/
+
+#include <stddef.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Replay.h"
+
+static const T_BTN_TRACE_ITEM *sg_ptItem            = NULL;  /* Trace being replayed      */
+static uint32                  sg_u32Num            = 0;     /* Number of trace items     */
+static uint32                  sg_u32Idx            = 0;     /* Index of the next item    */
+static uint32                  sg_u32Tm             = 0;     /* Virtual clock             */
+static uint8                   sg_au8Level[MAX_BTN_CH];      /* Current level of inputs   */
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Init(const T_BTN_TRACE_ITEM *ptItem, uint32 u32Num)
+* Function   : Start replaying a trace
+* Input      : const T_BTN_TRACE_ITEM *ptItem     Trace items in time order
+*              uint32                  u32Num     Number of trace items
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All inputs are set to BTN_STATE_0 and the clock is set to 0.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Init(const T_BTN_TRACE_ITEM *ptItem, uint32 u32Num)
+{
+    uint8 u8Idx;
+
+    /* Check if the input parameter is valid or NOT */
+    if((NULL == ptItem) && (0 != u32Num))
+    {   /* Return if the parameter is invalid */
+        return BTN_ERROR;
+    }
+
+    sg_ptItem = ptItem;
+    sg_u32Num = u32Num;
+    sg_u32Idx = 0;
+    sg_u32Tm  = 0;
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        sg_au8Level[u8Idx] = BTN_STATE_0;
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Step(uint32 u32Tm)
+* Function   : Move the virtual clock and apply the input changes up to it
+* Input      : uint32 u32Tm     New time of the virtual clock
+* Output:    : None
+* Return     : 1                There are still items to be replayed
+*              0                The trace is finished
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Step(uint32 u32Tm)
+{
+    const T_BTN_TRACE_ITEM *ptItem;
+
+    sg_u32Tm = u32Tm;
+    while(sg_u32Idx < sg_u32Num)
+    {
+        ptItem = &(sg_ptItem[sg_u32Idx]);
+        if(ptItem->u32Tm > u32Tm)
+        {   /* The rest items are in the future */
+            break;
+        }
+        if((0 != ptItem->u8Ch) && (ptItem->u8Ch <= MAX_BTN_CH))
+        {   /* Skip the channels out of range */
+            sg_au8Level[ptItem->u8Ch - 1] = ptItem->u8Level;
+        }
+        sg_u32Idx++;
+    }
+    return (uint8)(sg_u32Idx < sg_u32Num);
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Level_Set(uint8 u8Ch, uint8 u8Level)
+* Function   : Override the level of one input
+* Input      : uint8 u8Ch       1~MAX_BTN_CH   The number of button channel
+*              uint8 u8Level    BTN_STATE_0/1  The new level of the input
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The level is set
+* description: For synthetic stimulus without a trace.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Level_Set(uint8 u8Ch, uint8 u8Level)
+{
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    sg_au8Level[u8Ch - 1] = u8Level;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the replayed button state (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_CH   The number of button channel
+* Output:    : None
+* Return     : BTN_STATE_0      Button state is logic "0"
+*              BTN_STATE_1      Button state is logic "1"
+*              BTN_ERROR        Channel number is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Btn_St_Get(uint8 u8Ch)
+{
+    /* Check if the channel number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    return sg_au8Level[u8Ch - 1];
+}
+
+/******************************************************************************
+* Name       : uint16 Btn_Replay_Time(void)
+* Function   : Get the virtual clock (PF_GET_TM)
+* Input      : None
+* Output:    : None
+* Return     : 0~65535  Lower 16 bits of the virtual clock
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Btn_Replay_Time(void)
+{
+    return (uint16)sg_u32Tm;
+}
+
+/******************************************************************************
+* Name       : void Btn_Replay_Port_Get(uint32 *pu32Port)
+* Function   : Get the replayed levels of all inputs as port words
+* Input      : None
+* Output:    : uint32 *pu32Port   (MAX_BTN_CH + 31) / 32 words, bit (N-1) is the
+*                                 level of channel N
+* Return     : None
+* description: For wake detectors reading the whole input port at once.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Replay_Port_Get(uint32 *pu32Port)
+{
+    uint8 u8Idx;
+
+    for(u8Idx = 0; u8Idx < (MAX_BTN_CH + 31) / 32; u8Idx++)
+    {
+        pu32Port[u8Idx] = 0;
+    }
+    for(u8Idx = 0; u8Idx < MAX_BTN_CH; u8Idx++)
+    {
+        pu32Port[u8Idx >> 5] |= (uint32)(sg_au8Level[u8Idx] & 1) << (u8Idx & 31);
+    }
+}
+
+/* end-of-file */
@@ -0,0 +1,138 @@
+/******************************************************************************
+* File       : Btn_SM_Replay.h
+* Function   : Replay recorded button input traces through the state machine.
+* description: A replay trace is a time ordered list of input changes (time, channel,
+*              level). The replay provides the PF_GET_BTN/PF_GET_TM interface
+*              functions, so the button state machine runs on the trace instead
+*              of the hardware, with a virtual clock.
+*
+*              HOW TO USE:
+*              Step 1: Call "Btn_Replay_Init()" with the trace.
+*              Step 2: Call "Btn_SM_Easy_Init(Btn_Replay_Time, Btn_Replay_Btn_St_Get)".
+*              Step 3: For each tick, call "Btn_Replay_Step()" and then process the
+*                      channels as usual.
+*
+*              NOTE: This file is for host environment only.
+* Version    : V1.01
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Add port words of inputs
+******************************************************************************/
+
+#ifndef _BTN_SM_REPLAY_
+#define _BTN_SM_REPLAY_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+* Structure  : T_BTN_TRACE_ITEM
+* Description: Structure of one input change in a replay trace.
+* Memebers   : Type    Member    Range          Descrption
+*              uint32  u32Tm     0~             Time of the change (1 unit = 1ms)
+*              uint8   u8Ch      1~MAX_BTN_CH   The number of button channel
+*              uint8   u8Level   BTN_STATE_0/1  The new level of the input
+*******************************************************************************/
+typedef struct _T_BTN_TRACE_ITEM_
+{
+    uint32      u32Tm;              /* Time of the change     */
+    uint8       u8Ch;               /* Channel number         */
+    uint8       u8Level;            /* New level of the input */
+}T_BTN_TRACE_ITEM;
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Init(const T_BTN_TRACE_ITEM *ptItem, uint32 u32Num)
+* Function   : Start replaying a trace
+* Input      : const T_BTN_TRACE_ITEM *ptItem     Trace items in time order
+*              uint32                  u32Num     Number of trace items
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All inputs are set to BTN_STATE_0 and the clock is set to 0.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Init(const T_BTN_TRACE_ITEM *ptItem, uint32 u32Num);
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Step(uint32 u32Tm)
+* Function   : Move the virtual clock and apply the input changes up to it
+* Input      : uint32 u32Tm     New time of the virtual clock
+* Output:    : None
+* Return     : 1                There are still items to be replayed
+*              0                The trace is finished
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Step(uint32 u32Tm);
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Level_Set(uint8 u8Ch, uint8 u8Level)
+* Function   : Override the level of one input
+* Input      : uint8 u8Ch       1~MAX_BTN_CH   The number of button channel
+*              uint8 u8Level    BTN_STATE_0/1  The new level of the input
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The level is set
+* description: For synthetic stimulus without a trace.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Level_Set(uint8 u8Ch, uint8 u8Level);
+
+/******************************************************************************
+* Name       : uint8 Btn_Replay_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the replayed button state (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_CH   The number of button channel
+* Output:    : None
+* Return     : BTN_STATE_0      Button state is logic "0"
+*              BTN_STATE_1      Button state is logic "1"
+*              BTN_ERROR        Channel number is invalid
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Replay_Btn_St_Get(uint8 u8Ch);
+
+/******************************************************************************
+* Name       : uint16 Btn_Replay_Time(void)
+* Function   : Get the virtual clock (PF_GET_TM)
+* Input      : None
+* Output:    : None
+* Return     : 0~65535  Lower 16 bits of the virtual clock
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Btn_Replay_Time(void);
+
+/******************************************************************************
+* Name       : void Btn_Replay_Port_Get(uint32 *pu32Port)
+* Function   : Get the replayed levels of all inputs as port words
+* Input      : None
+* Output:    : uint32 *pu32Port   (MAX_BTN_CH + 31) / 32 words, bit (N-1) is the
+*                                 level of channel N
+* Return     : None
+* description: For wake detectors reading the whole input port at once.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Replay_Port_Get(uint32 *pu32Port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_REPLAY_ */
+
+/* end-of-file */
@@ -0,0 +1,192 @@
+/******************************************************************************
+* File       : Btn_SM_Touch.c
+* Function   : Capacitive touch pads as button channels.
+* description: Please refer to Btn_SM_Touch.h for details.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#include "common.h"
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Touch.h"
+
+#ifdef __BTN_SM_TOUCH
+
+#define BTN_TOUCH_FRAC               (8)         /* Fraction bits of counts and baselines */
+
+/* Select A if the bit is 1, else B, without branch */
+#define BTN_TOUCH_SEL(u32Bit, u32A, u32B)  (((u32A) & ((uint32)0 - (u32Bit))) | ((u32B) & ((u32Bit) - 1)))
+
+static T_BTN_TOUCH_PARA sg_tTouchPara;                          /* Parameters                 */
+static uint8            sg_u8TouchCal = 1;                      /* Calibrate at the next scan */
+
+/* All per-pad arrays are of the same width, so one SIMD lane is one pad */
+static uint32 sg_au32TouchFilt[MAX_BTN_TOUCH_PAD];              /* Filtered counts            */
+static uint32 sg_au32TouchBase[MAX_BTN_TOUCH_PAD];              /* Baselines                  */
+static uint32 sg_au32TouchOn[MAX_BTN_TOUCH_PAD];                /* Scans of the touch         */
+static uint32 sg_au32TouchSt[MAX_BTN_TOUCH_PAD];                /* 1: Pad is touched          */
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Init(const T_BTN_TOUCH_PARA *ptPara)
+* Function   : Init the touch pads
+* Input      : const T_BTN_TOUCH_PARA *ptPara    Parameters of all pads
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: The parameters are copied. The baselines are calibrated by the
+*              next Btn_Touch_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Init(const T_BTN_TOUCH_PARA *ptPara)
+{
+    /* Check if the input parameter is invalid */
+    if((NULL == ptPara) || (ptPara->u16RelTh >= ptPara->u16TouchTh) || (0 == ptPara->u16NegTh)
+    || (ptPara->u8FiltShift > BTN_TOUCH_FRAC) || (0 == ptPara->u8BaseShift) || (ptPara->u8BaseShift > 16))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    sg_tTouchPara = *ptPara;
+    sg_u8TouchCal = 1;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Process(const uint16 *pu16Raw)
+* Function   : Process the raw counts of one scan of all pads
+* Input      : const uint16 *pu16Raw    MAX_BTN_TOUCH_PAD raw counts, item N-1 is
+*                                       pad N
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The counts are processed
+* description: The loop of filters has no branch and no function call, please keep
+*              it so, or the compiler can NOT vectorize it.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Process(const uint16 *pu16Raw)
+{
+    uint32 u32FiltSh = sg_tTouchPara.u8FiltShift;
+    uint32 u32BaseSh = sg_tTouchPara.u8BaseShift;
+    uint32 u32TouchTh = (uint32)sg_tTouchPara.u16TouchTh << BTN_TOUCH_FRAC;
+    uint32 u32RelTh   = (uint32)sg_tTouchPara.u16RelTh << BTN_TOUCH_FRAC;
+    uint32 u32NegTh   = (uint32)sg_tTouchPara.u16NegTh << BTN_TOUCH_FRAC;
+    uint32 u32MaxOn   = sg_tTouchPara.u16MaxOnScan ? sg_tTouchPara.u16MaxOnScan : 0xFFFFFFFF;
+    uint16 u16Idx;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == pu16Raw) || (0 == sg_tTouchPara.u8BaseShift))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    if(sg_u8TouchCal)
+    {   /* Calibrate the baselines by the first counts */
+        for(u16Idx = 0; u16Idx < MAX_BTN_TOUCH_PAD; u16Idx++)
+        {
+            sg_au32TouchFilt[u16Idx] = (uint32)pu16Raw[u16Idx] << BTN_TOUCH_FRAC;
+            sg_au32TouchBase[u16Idx] = sg_au32TouchFilt[u16Idx];
+            sg_au32TouchOn[u16Idx]   = 0;
+            sg_au32TouchSt[u16Idx]   = 0;
+        }
+        sg_u8TouchCal = 0;
+        return SUCCESS;
+    }
+
+    /* Filters of all pads */
+    for(u16Idx = 0; u16Idx < MAX_BTN_TOUCH_PAD; u16Idx++)
+    {
+        uint32 u32Raw  = (uint32)pu16Raw[u16Idx] << BTN_TOUCH_FRAC;
+        uint32 u32Filt = sg_au32TouchFilt[u16Idx];
+        uint32 u32Base = sg_au32TouchBase[u16Idx];
+        uint32 u32St   = sg_au32TouchSt[u16Idx];
+        uint32 u32On, u32Pos, u32Neg, u32Reset;
+
+        /* Noise filter, up and down are separated to keep the counts unsigned */
+        u32Filt = u32Filt + (((u32Raw > u32Filt) ? (u32Raw - u32Filt) : 0) >> u32FiltSh)
+                          - (((u32Filt > u32Raw) ? (u32Filt - u32Raw) : 0) >> u32FiltSh);
+        u32Pos  = (u32Filt > u32Base) ? (u32Filt - u32Base) : 0;
+        u32Neg  = (u32Base > u32Filt) ? (u32Base - u32Filt) : 0;
+
+        /* Touch with hysteresis, and the scans of the touch */
+        u32St   = BTN_TOUCH_SEL(u32St, (uint32)(u32Pos >= u32RelTh), (uint32)(u32Pos >= u32TouchTh));
+        u32On   = (sg_au32TouchOn[u16Idx] + 1) & ((uint32)0 - u32St);
+
+        /* Re-baseline on negative delta or stuck touch */
+        u32Reset = (uint32)(u32Neg >= u32NegTh) | (uint32)(u32On >= u32MaxOn);
+        u32St   &= u32Reset ^ 1;
+        u32On   &= (uint32)0 - (u32Reset ^ 1);
+
+        /* Baseline follows the drift only if NOT touched */
+        u32Base = u32Base + (((u32Pos >> u32BaseSh) & ((uint32)0 - (u32St ^ 1))))
+                          - (((u32Neg >> u32BaseSh) & ((uint32)0 - (u32St ^ 1))));
+        sg_au32TouchBase[u16Idx] = BTN_TOUCH_SEL(u32Reset, u32Filt, u32Base);
+        sg_au32TouchFilt[u16Idx] = u32Filt;
+        sg_au32TouchOn[u16Idx]   = u32On;
+        sg_au32TouchSt[u16Idx]   = u32St;
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the touch state of one pad (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_TOUCH_PAD   The number of pad
+* Output:    : None
+* Return     : BTN_STATE_0      Pad is NOT touched
+*              BTN_STATE_1      Pad is touched
+*              BTN_ERROR        Pad number is invalid
+* description: The state after the last Btn_Touch_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Btn_St_Get(uint8 u8Ch)
+{
+    /* Check if the pad number is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_TOUCH_PAD))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    return sg_au32TouchSt[u8Ch - 1] ? BTN_STATE_1 : BTN_STATE_0;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Pad_Get(uint8 u8Ch, uint16 *pu16Base, uint16 *pu16Delta)
+* Function   : Get the baseline and the delta of one pad
+* Input      : uint8   u8Ch       1~MAX_BTN_TOUCH_PAD   The number of pad
+* Output:    : uint16 *pu16Base   0~65535               Baseline (integer part)
+*              uint16 *pu16Delta  0~65535               Delta above baseline
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The values are got
+* description: For tuning of the thresholds.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Pad_Get(uint8 u8Ch, uint16 *pu16Base, uint16 *pu16Delta)
+{
+    uint32 u32Filt, u32Base;
+
+    /* Check if the input parameter is invalid */
+    if((0 == u8Ch) || (u8Ch > MAX_BTN_TOUCH_PAD) || (NULL == pu16Base) || (NULL == pu16Delta))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+    u32Filt    = sg_au32TouchFilt[u8Ch - 1];
+    u32Base    = sg_au32TouchBase[u8Ch - 1];
+    *pu16Base  = (uint16)(u32Base >> BTN_TOUCH_FRAC);
+    *pu16Delta = (uint16)(((u32Filt > u32Base) ? (u32Filt - u32Base) : 0) >> BTN_TOUCH_FRAC);
+    return SUCCESS;
+}
+
+#endif
+
+/* end-of-file */
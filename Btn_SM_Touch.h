@@ -0,0 +1,146 @@
+/******************************************************************************
+* File       : Btn_SM_Touch.h
+* Function   : Capacitive touch pads as button channels.
+* description: Each pad reports a raw count, which grows when the pad is touched.
+*              Each scan, the raw counts of all pads are processed at once:
+*                  * Filter   A fast integer IIR filter removes the noise of raw
+*                             counts: F += (R - F) >> u8FiltShift
+*                  * Baseline A slow integer IIR filter follows the drift of the
+*                             pad (temperature, humidity) while it is NOT touched:
+*                             B += (F - B) >> u8BaseShift
+*                             If the filtered count falls u16NegTh below the
+*                             baseline (e.g. a finger was on the pad at power-on),
+*                             the baseline is set to the filtered count at once.
+*                  * Touch    Delta = F - B. The pad is touched when the delta
+*                             reaches u16TouchTh, and NOT touched when it is below
+*                             u16RelTh (u16RelTh < u16TouchTh, hysteresis).
+*                  * Stuck    If the pad is touched for u16MaxOnScan scans (e.g. a
+*                             cup on the panel), the baseline is set to the filtered
+*                             count and the pad is NOT touched. 0: disabled.
+*              The counts and the baselines are kept with 8 fraction bits, so the
+*              slow filter does NOT lose the small drift.
+*
+*              The touch state is given to the button state machine by
+*              Btn_Touch_Btn_St_Get() (PF_GET_BTN, normal state BTN_NORMAL_0), so
+*              the debounce, press, long-press and release events are the same as
+*              digital channels.
+*
+*              All pads are filtered in one branch-free loop over arrays, so the
+*              compiler can use SIMD instructions (e.g. -O3 on GCC; on x86-64 host
+*              "uint32" is 64 bits and needs -msse4.2 or later for the compares).
+*
+*              HOW TO USE:
+*              Step 1: Call "Btn_Touch_Init()" with the parameters.
+*              Step 2: Call "Btn_SM_Easy_Init(Get_Time, Btn_Touch_Btn_St_Get)", or
+*                      use it as pfGetBtnSt of the touch channels.
+*              Step 3: For each scan, call "Btn_Touch_Process()" with the raw counts,
+*                      then process the channels as usual.
+*
+*              NOTE: The baselines are calibrated by the first raw counts, so do
+*                    NOT touch the pads at the first scan.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#ifndef _BTN_SM_TOUCH_
+#define _BTN_SM_TOUCH_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __BTN_SM_TOUCH
+
+/*******************************************************************************
+* Structure  : T_BTN_TOUCH_PARA
+* Description: Structure of touch pad parameters (all pads).
+* Memebers   : Type    Member        Range     Descrption
+*              uint16  u16TouchTh    1~65535   Delta to touch
+*              uint16  u16RelTh      0~65534   Delta to release, less than u16TouchTh
+*              uint16  u16NegTh      1~65535   Delta below baseline to re-baseline
+*              uint16  u16MaxOnScan  0~65535   Max scans of a touch, 0: no limit
+*              uint8   u8FiltShift   0~8       Shift of the noise filter, 0: none
+*              uint8   u8BaseShift   1~16      Shift of the baseline filter
+*******************************************************************************/
+typedef struct _T_BTN_TOUCH_PARA_
+{
+    uint16      u16TouchTh;         /* Delta to touch                */
+    uint16      u16RelTh;           /* Delta to release              */
+    uint16      u16NegTh;           /* Delta below baseline to reset */
+    uint16      u16MaxOnScan;       /* Max scans of a touch          */
+    uint8       u8FiltShift;        /* Shift of the noise filter     */
+    uint8       u8BaseShift;        /* Shift of the baseline filter  */
+}T_BTN_TOUCH_PARA;
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Init(const T_BTN_TOUCH_PARA *ptPara)
+* Function   : Init the touch pads
+* Input      : const T_BTN_TOUCH_PARA *ptPara    Parameters of all pads
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: The parameters are copied. The baselines are calibrated by the
+*              next Btn_Touch_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Init(const T_BTN_TOUCH_PARA *ptPara);
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Process(const uint16 *pu16Raw)
+* Function   : Process the raw counts of one scan of all pads
+* Input      : const uint16 *pu16Raw    MAX_BTN_TOUCH_PAD raw counts, item N-1 is
+*                                       pad N
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The counts are processed
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Process(const uint16 *pu16Raw);
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Btn_St_Get(uint8 u8Ch)
+* Function   : Get the touch state of one pad (PF_GET_BTN)
+* Input      : uint8 u8Ch  1~MAX_BTN_TOUCH_PAD   The number of pad
+* Output:    : None
+* Return     : BTN_STATE_0      Pad is NOT touched
+*              BTN_STATE_1      Pad is touched
+*              BTN_ERROR        Pad number is invalid
+* description: The state after the last Btn_Touch_Process().
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Btn_St_Get(uint8 u8Ch);
+
+/******************************************************************************
+* Name       : uint8 Btn_Touch_Pad_Get(uint8 u8Ch, uint16 *pu16Base, uint16 *pu16Delta)
+* Function   : Get the baseline and the delta of one pad
+* Input      : uint8   u8Ch       1~MAX_BTN_TOUCH_PAD   The number of pad
+* Output:    : uint16 *pu16Base   0~65535               Baseline (integer part)
+*              uint16 *pu16Delta  0~65535               Delta above baseline
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The values are got
+* description: For tuning of the thresholds.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Touch_Pad_Get(uint8 u8Ch, uint16 *pu16Base, uint16 *pu16Delta);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_TOUCH_ */
+
+/* end-of-file */
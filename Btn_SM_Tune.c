@@ -0,0 +1,751 @@
+/******************************************************************************
+* File       : Btn_SM_Tune.c
+* Function   : Parameter tuner of debounce and long-press time by trace replay.
+* description: Replays button traces through the state machine under many sets of
+*              u16DebounceTm and u16LongPressTm, scores each set and prints the
+*              Pareto-optimal sets.
+*
+*              Traces are either generated or imported from a VCD file:
+*                  * Generated: TUNE_LANES buttons, each with taps, long presses and
+*                    short glitches at random gaps, and random contact bounce on
+*                    both edges of each press. The intended presses are known.
+*                  * VCD: the "chN_in" signals (Btn_Vcd_Import(), active high).
+*                    The intended presses are labelled by a reference: edges closer
+*                    than TUNE_REF_GAP are bounce of one press, presses shorter than
+*                    TUNE_REF_MIN are glitches, presses of TUNE_REF_LONG or longer
+*                    are long presses.
+*              Each button of the trace is a lane, and all lanes are replayed on
+*              channel 1 one after another (the lanes share the parameters and the
+*              channels do NOT affect each other).
+*
+*              Scores of a set (all lower is better):
+*                  * false     BTN_PRESSED_EVT without an intended press (glitch,
+*                              bounce, or a second one in the same press), and
+*                              BTN_LONG_PRESSED_EVT of a tap.
+*                  * missed    Intended presses without BTN_PRESSED_EVT, and long
+*                              presses without BTN_LONG_PRESSED_EVT.
+*                  * latency   Mean time from the first contact of a press to its
+*                              BTN_PRESSED_EVT.
+*                  * long lat. Mean time from the first contact of a long press to
+*                              its BTN_LONG_PRESSED_EVT.
+*              A latency without any matched event is the worst ("-").
+*              An event belongs to the last intended press started before it.
+*
+*              The sets are evaluated by one worker process per CPU (fork(), the
+*              module keeps its state in static variables), the scores are written
+*              into shared memory and the parent prints the Pareto front.
+*              With __BTN_SM_SLEEP the idle time between presses is skipped: when
+*              the channel is idle (Btn_Sleep_Enter()), the clock jumps to the next
+*              input change, so only the ticks of the presses are scanned.
+*
+*              Usage: Btn_SM_Tune grid [configs] [minutes]     Grid search
+*                     Btn_SM_Tune rand [configs] [minutes]     Random search
+*                     Btn_SM_Tune grid|rand [configs] <file.vcd>
+*                     minutes: length of the generated trace of each lane.
+*
+*              Build: cc -O2 -DMAX_BTN_CH=1 -D__BTN_SM_SLEEP -I<path of common.h>
+*                        -o Btn_SM_Tune Btn_SM_Tune.c Btn_SM_Module.c Btn_SM_Replay.c
+*                        Btn_SM_Vcd.c -lpthread
+*                     (On host "common.h" must provide NULL, e.g. include <stddef.h>.)
+*                     The VCD import takes channels 1~255 whatever MAX_BTN_CH is,
+*                     all lanes are replayed on channel 1.
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.02
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Warn when the VCD import is truncated
+*               3    18/Oct/2026   Ian   V1.02     Give the pins to Btn_Sleep_Enter()
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Replay.h"
+#include "Btn_SM_Vcd.h"
+
+#define TUNE_CONFIGS                 (1000)      /* Default number of parameter sets      */
+#define TUNE_MINUTES                 (60)        /* Default minutes of each generated lane */
+#define TUNE_LANES                   (8)         /* Lanes of generated trace              */
+#define TUNE_DB_MAX                  (60)        /* Max debounce time of search           */
+#define TUNE_LP_MIN                  (200)       /* Min long-press time of search         */
+#define TUNE_LP_MAX                  (2000)      /* Max long-press time of search         */
+#define TUNE_TAIL                    (3000)      /* Replay time after the last change     */
+#define TUNE_VCD_MAX                 (4000000)   /* Max items imported from VCD           */
+
+#define TUNE_GAP_MIN                 (150)       /* Min gap between presses               */
+#define TUNE_GAP_MAX                 (3000)      /* Max gap between presses               */
+#define TUNE_TAP_MIN                 (40)        /* Min length of taps                    */
+#define TUNE_TAP_MAX                 (350)       /* Max length of taps                    */
+#define TUNE_LONG_MIN                (800)       /* Min length of long presses            */
+#define TUNE_LONG_MAX                (2000)      /* Max length of long presses            */
+#define TUNE_BOUNCE_MAX              (12)        /* Max bounce time of each edge          */
+#define TUNE_GLITCH_MAX              (8)         /* Max length of glitches                */
+
+#define TUNE_REF_GAP                 (20)        /* Reference: edges closer are bounce    */
+#define TUNE_REF_MIN                 (20)        /* Reference: shorter are glitches       */
+#define TUNE_REF_LONG                (600)       /* Reference: longer are long presses    */
+
+#define TUNE_GOT_PRESS               (0x01)      /* The press got BTN_PRESSED_EVT         */
+#define TUNE_GOT_LONG                (0x02)      /* The press got BTN_LONG_PRESSED_EVT    */
+#define TUNE_NO_LAT                  (0xFFFFFFFF) /* Latency if no event is matched       */
+
+/* Intended press of a lane */
+typedef struct _T_TUNE_PRESS_
+{
+    uint32      u32Beg;             /* First contact            */
+    uint32      u32End;             /* Last contact             */
+    uint8       u8Long;             /* 1: Long press is intended */
+}T_TUNE_PRESS;
+
+/* Trace of one button */
+typedef struct _T_TUNE_LANE_
+{
+    T_BTN_TRACE_ITEM *ptItem;       /* Input changes, channel 1 */
+    uint32      u32Num;             /* Number of changes        */
+    uint32      u32Max;             /* Size of ptItem           */
+    T_TUNE_PRESS *ptPress;          /* Intended presses         */
+    uint32      u32PressNum;        /* Number of presses        */
+    uint32      u32PressMax;        /* Size of ptPress          */
+    uint32      u32EndTm;           /* End of the replay        */
+}T_TUNE_LANE;
+
+/* Parameter set and its scores */
+typedef struct _T_TUNE_SCORE_
+{
+    uint16      u16DbTm;            /* Debounce time              */
+    uint16      u16LpTm;            /* Long-press time            */
+    uint32      u32False;           /* False events               */
+    uint32      u32Miss;            /* Missed presses             */
+    uint32      u32Lat;             /* Mean latency, 0.01 units   */
+    uint32      u32LongLat;         /* Mean long latency, 0.01    */
+    uint8       u8Pareto;           /* 1: On the Pareto front     */
+}T_TUNE_SCORE;
+
+static T_TUNE_LANE *sg_ptLane                = NULL;      /* Lanes of the trace             */
+static uint32       sg_u32LaneNum            = 0;         /* Number of lanes                */
+static uint32       sg_u32PressMax           = 0;         /* Max presses of one lane        */
+static uint32       sg_u32Seed               = 1;         /* Seed of pseudo random numbers  */
+static T_BTN_PARA   sg_atPara[MAX_BTN_CH];                /* Parameters of channels         */
+
+/******************************************************************************
+* Name       : static uint32 Tune_Rand(void)
+* Function   : Fast pseudo random number (xorshift32), same sequence in each run
+* Input      : None
+* Output:    : None
+* Return     : Random number
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint32 Tune_Rand(void)
+{
+    sg_u32Seed ^= sg_u32Seed << 13;
+    sg_u32Seed ^= (sg_u32Seed & 0xFFFFFFFF) >> 17;
+    sg_u32Seed ^= sg_u32Seed << 5;
+    sg_u32Seed &= 0xFFFFFFFF;
+    return sg_u32Seed;
+}
+
+/******************************************************************************
+* Name       : static void Tune_Item_Put(T_TUNE_LANE *ptLane, uint32 u32Tm, uint8 u8Level)
+* Function   : Append one input change to a lane
+* Input      : uint32       u32Tm      Time of the change, NOT earlier than the last
+*              uint8        u8Level    New level of the input
+* Output:    : T_TUNE_LANE *ptLane     The lane
+* Return     : None
+* description: Exits the program if out of memory.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Item_Put(T_TUNE_LANE *ptLane, uint32 u32Tm, uint8 u8Level)
+{
+    if(ptLane->u32Num == ptLane->u32Max)
+    {
+        ptLane->u32Max = (0 == ptLane->u32Max) ? 1024 : (ptLane->u32Max * 2);
+        ptLane->ptItem = realloc(ptLane->ptItem, ptLane->u32Max * sizeof(T_BTN_TRACE_ITEM));
+        if(NULL == ptLane->ptItem)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    ptLane->ptItem[ptLane->u32Num].u32Tm   = u32Tm;
+    ptLane->ptItem[ptLane->u32Num].u8Ch    = 1;
+    ptLane->ptItem[ptLane->u32Num].u8Level = u8Level;
+    ptLane->u32Num++;
+}
+
+/******************************************************************************
+* Name       : static void Tune_Press_Put(T_TUNE_LANE *ptLane, uint32 u32Beg,
+*                                         uint32 u32End, uint8 u8Long)
+* Function   : Append one intended press to a lane
+* Input      : uint32       u32Beg     First contact
+*              uint32       u32End     Last contact
+*              uint8        u8Long     1: Long press is intended
+* Output:    : T_TUNE_LANE *ptLane     The lane
+* Return     : None
+* description: Exits the program if out of memory.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Press_Put(T_TUNE_LANE *ptLane, uint32 u32Beg, uint32 u32End, uint8 u8Long)
+{
+    if(ptLane->u32PressNum == ptLane->u32PressMax)
+    {
+        ptLane->u32PressMax = (0 == ptLane->u32PressMax) ? 256 : (ptLane->u32PressMax * 2);
+        ptLane->ptPress = realloc(ptLane->ptPress, ptLane->u32PressMax * sizeof(T_TUNE_PRESS));
+        if(NULL == ptLane->ptPress)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    ptLane->ptPress[ptLane->u32PressNum].u32Beg = u32Beg;
+    ptLane->ptPress[ptLane->u32PressNum].u32End = u32End;
+    ptLane->ptPress[ptLane->u32PressNum].u8Long = u8Long;
+    ptLane->u32PressNum++;
+    if(ptLane->u32PressNum > sg_u32PressMax)
+    {
+        sg_u32PressMax = ptLane->u32PressNum;
+    }
+}
+
+/******************************************************************************
+* Name       : static void Tune_Edge(T_TUNE_LANE *ptLane, uint32 u32Tm, uint8 u8Level)
+* Function   : Append one edge with random contact bounce to a lane
+* Input      : uint32       u32Tm      Time of the first contact change
+*              uint8        u8Level    Level after the edge
+* Output:    : T_TUNE_LANE *ptLane     The lane
+* Return     : None
+* description: The input toggles every 1~3 ticks for 0~TUNE_BOUNCE_MAX ticks.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Edge(T_TUNE_LANE *ptLane, uint32 u32Tm, uint8 u8Level)
+{
+    uint32 u32Bounce = Tune_Rand() % (TUNE_BOUNCE_MAX + 1);
+    uint32 u32T      = u32Tm;
+    uint8  u8L       = u8Level;
+
+    while(u32T < u32Tm + u32Bounce)
+    {
+        Tune_Item_Put(ptLane, u32T, u8L);
+        u32T += 1 + Tune_Rand() % 3;
+        u8L  ^= 1;
+    }
+    Tune_Item_Put(ptLane, u32Tm + u32Bounce, u8Level);
+}
+
+/******************************************************************************
+* Name       : static void Tune_Gen(uint32 u32Minutes)
+* Function   : Generate the lanes of the trace
+* Input      : uint32 u32Minutes   Length of each lane
+* Output:    : None
+* Return     : None
+* description: 70% taps, 20% long presses and 10% glitches, at random gaps.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Gen(uint32 u32Minutes)
+{
+    T_TUNE_LANE *ptLane;
+    uint32 u32Dur = u32Minutes * 60000;
+    uint32 u32Lane, u32Tm, u32Kind, u32Len;
+
+    sg_u32LaneNum = TUNE_LANES;
+    sg_ptLane     = calloc(sg_u32LaneNum, sizeof(T_TUNE_LANE));
+    for(u32Lane = 0; u32Lane < sg_u32LaneNum; u32Lane++)
+    {
+        ptLane = &(sg_ptLane[u32Lane]);
+        u32Tm  = Tune_Rand() % TUNE_GAP_MAX;
+        while(u32Tm < u32Dur)
+        {
+            u32Kind = Tune_Rand() % 100;
+            if(u32Kind < 10)
+            {   /* Glitch, NOT a press */
+                u32Len = 1 + Tune_Rand() % TUNE_GLITCH_MAX;
+                Tune_Item_Put(ptLane, u32Tm, BTN_STATE_1);
+                Tune_Item_Put(ptLane, u32Tm + u32Len, BTN_STATE_0);
+            }
+            else
+            {   /* Tap or long press */
+                u32Len = (u32Kind < 80) ? (TUNE_TAP_MIN + Tune_Rand() % (TUNE_TAP_MAX - TUNE_TAP_MIN + 1))
+                                        : (TUNE_LONG_MIN + Tune_Rand() % (TUNE_LONG_MAX - TUNE_LONG_MIN + 1));
+                Tune_Edge(ptLane, u32Tm, BTN_STATE_1);
+                Tune_Edge(ptLane, u32Tm + u32Len, BTN_STATE_0);
+                Tune_Press_Put(ptLane, u32Tm, u32Tm + u32Len, (uint8)(u32Kind >= 80));
+            }
+            u32Tm += u32Len + TUNE_GAP_MIN + Tune_Rand() % (TUNE_GAP_MAX - TUNE_GAP_MIN);
+        }
+        ptLane->u32EndTm = ptLane->ptItem[ptLane->u32Num - 1].u32Tm + TUNE_TAIL;
+    }
+}
+
+/******************************************************************************
+* Name       : static void Tune_Label(T_TUNE_LANE *ptLane)
+* Function   : Label the intended presses of a recorded lane
+* Input      : None
+* Output:    : T_TUNE_LANE *ptLane     The lane
+* Return     : None
+* description: Please refer to the file header.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Label(T_TUNE_LANE *ptLane)
+{
+    const T_BTN_TRACE_ITEM *ptItem;
+    uint32 u32Idx, u32Beg = 0, u32End = 0;
+    uint8  u8Level = BTN_STATE_0;
+    uint8  u8Open  = 0;
+
+    for(u32Idx = 0; u32Idx < ptLane->u32Num; u32Idx++)
+    {
+        ptItem = &(ptLane->ptItem[u32Idx]);
+        if(ptItem->u8Level == u8Level)
+        {
+            continue;
+        }
+        u8Level = ptItem->u8Level;
+        if(BTN_STATE_0 == u8Level)
+        {
+            u32End = ptItem->u32Tm;
+        }
+        else if((0 == u8Open) || (ptItem->u32Tm - u32End >= TUNE_REF_GAP))
+        {   /* A new press, close the last one */
+            if(u8Open && (u32End - u32Beg >= TUNE_REF_MIN))
+            {
+                Tune_Press_Put(ptLane, u32Beg, u32End, (uint8)(u32End - u32Beg >= TUNE_REF_LONG));
+            }
+            u8Open = 1;
+            u32Beg = ptItem->u32Tm;
+        }
+    }
+    if(u8Open)
+    {   /* Still pressed at the end of the trace */
+        u32End = (BTN_STATE_0 == u8Level) ? u32End : ptLane->u32EndTm;
+        if(u32End - u32Beg >= TUNE_REF_MIN)
+        {
+            Tune_Press_Put(ptLane, u32Beg, u32End, (uint8)(u32End - u32Beg >= TUNE_REF_LONG));
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static uint8 Tune_Load(const char *pcPath)
+* Function   : Import a VCD file into the lanes of the trace
+* Input      : const char *pcPath    Path of the VCD file
+* Output:    : None
+* Return     : BTN_ERROR             No input change is imported
+*              SUCCESS               The lanes are built
+* description: Each "chN_in" signal with changes is one lane. If TUNE_VCD_MAX
+*              changes are imported, the rest of the file may be dropped, and a
+*              warning is printed.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Tune_Load(const char *pcPath)
+{
+    T_BTN_TRACE_ITEM *ptItem = malloc(TUNE_VCD_MAX * sizeof(T_BTN_TRACE_ITEM));
+    T_TUNE_LANE      *aptCh[256] = {NULL};
+    uint32 u32Num, u32Idx;
+    uint8  u8Ch;
+
+    if(NULL == ptItem)
+    {
+        return BTN_ERROR;
+    }
+    u32Num = Btn_Vcd_Import(pcPath, ptItem, TUNE_VCD_MAX);
+    if(TUNE_VCD_MAX == u32Num)
+    {   /* The buffer is full, the import may be truncated */
+        fprintf(stderr, "warning: only the first %u input changes of %s are imported\n",
+                (unsigned)TUNE_VCD_MAX, pcPath);
+    }
+
+    sg_ptLane     = calloc(256, sizeof(T_TUNE_LANE));
+    sg_u32LaneNum = 0;
+    for(u32Idx = 0; u32Idx < u32Num; u32Idx++)
+    {
+        u8Ch = ptItem[u32Idx].u8Ch;
+        if(NULL == aptCh[u8Ch])
+        {
+            aptCh[u8Ch] = &(sg_ptLane[sg_u32LaneNum++]);
+        }
+        Tune_Item_Put(aptCh[u8Ch], ptItem[u32Idx].u32Tm, ptItem[u32Idx].u8Level);
+    }
+    free(ptItem);
+
+    for(u32Idx = 0; u32Idx < sg_u32LaneNum; u32Idx++)
+    {
+        sg_ptLane[u32Idx].u32EndTm = sg_ptLane[u32Idx].ptItem[sg_ptLane[u32Idx].u32Num - 1].u32Tm + TUNE_TAIL;
+        Tune_Label(&(sg_ptLane[u32Idx]));
+    }
+    return (0 == sg_u32LaneNum) ? BTN_ERROR : SUCCESS;
+}
+
+/******************************************************************************
+* Name       : static void Tune_Eval(T_TUNE_SCORE *ptScore)
+* Function   : Replay all lanes under one parameter set and score it
+* Input      : T_TUNE_SCORE *ptScore   u16DbTm and u16LpTm are the parameters
+* Output:    : T_TUNE_SCORE *ptScore   The scores are filled
+* Return     : None
+* description: Please refer to the file header.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Eval(T_TUNE_SCORE *ptScore)
+{
+    static uint8 *s_pu8Got = NULL;                /* TUNE_GOT_XXX of each press */
+    const T_TUNE_LANE  *ptLane;
+    const T_TUNE_PRESS *ptPress;
+    T_BTN_RESULT tRes;
+#ifdef __BTN_SM_SLEEP
+    T_BTN_SLEEP  tSleep;
+#endif
+    uint64_t u64Lat = 0, u64LongLat = 0;
+    uint32   u32LatNum = 0, u32LongNum = 0;
+    uint32   u32Lane, u32Tm, u32Idx, u32Cur;
+    uint8    u8Ch, u8In;
+
+    if(NULL == s_pu8Got)
+    {   /* Each worker has its own */
+        s_pu8Got = malloc(sg_u32PressMax + 1);
+    }
+
+    ptScore->u32False = 0;
+    ptScore->u32Miss  = 0;
+    for(u32Lane = 0; u32Lane < sg_u32LaneNum; u32Lane++)
+    {
+        ptLane = &(sg_ptLane[u32Lane]);
+
+        /* Channel 1 replays the lane, the others are disabled */
+        Btn_Replay_Init(ptLane->ptItem, ptLane->u32Num);
+        for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+        {
+            sg_atPara[u8Ch - 1].u8Ch           = u8Ch;
+            sg_atPara[u8Ch - 1].u16DebounceTm  = ptScore->u16DbTm;
+            sg_atPara[u8Ch - 1].u16LongPressTm = ptScore->u16LpTm;
+            sg_atPara[u8Ch - 1].u8NormalSt     = BTN_NORMAL_0;
+            sg_atPara[u8Ch - 1].u8BtnEn        = (1 == u8Ch) ? BTN_FUNC_ENABLE : BTN_FUNC_DISABLE;
+            Btn_Channel_Init(u8Ch, &(sg_atPara[u8Ch - 1]));
+        }
+        memset(s_pu8Got, 0, ptLane->u32PressNum);
+
+        u32Tm  = 0;
+        u32Idx = 0;
+        u32Cur = 0;
+        while(u32Tm <= ptLane->u32EndTm)
+        {
+            Btn_Replay_Step(u32Tm);
+            while((u32Idx < ptLane->u32Num) && (ptLane->ptItem[u32Idx].u32Tm <= u32Tm))
+            {
+                u32Idx++;
+            }
+            Btn_Channel_Process(1, &tRes);
+
+            if(BTN_NONE_EVT != tRes.u8Evt)
+            {   /* The event belongs to the last press started before it */
+                while((u32Cur + 1 < ptLane->u32PressNum) && (ptLane->ptPress[u32Cur + 1].u32Beg <= u32Tm))
+                {
+                    u32Cur++;
+                }
+                ptPress = &(ptLane->ptPress[u32Cur]);
+                u8In    = (uint8)((0 != ptLane->u32PressNum) && (ptPress->u32Beg <= u32Tm));
+
+                if(BTN_PRESSED_EVT == tRes.u8Evt)
+                {
+                    if(u8In && !(s_pu8Got[u32Cur] & TUNE_GOT_PRESS))
+                    {
+                        s_pu8Got[u32Cur] |= TUNE_GOT_PRESS;
+                        u64Lat += u32Tm - ptPress->u32Beg;
+                        u32LatNum++;
+                    }
+                    else
+                    {
+                        ptScore->u32False++;
+                    }
+                }
+                else if(BTN_LONG_PRESSED_EVT == tRes.u8Evt)
+                {
+                    if(u8In && ptPress->u8Long && (s_pu8Got[u32Cur] == TUNE_GOT_PRESS))
+                    {
+                        s_pu8Got[u32Cur] |= TUNE_GOT_LONG;
+                        u64LongLat += u32Tm - ptPress->u32Beg;
+                        u32LongNum++;
+                    }
+                    else
+                    {
+                        ptScore->u32False++;
+                    }
+                }
+            }
+
+#ifdef __BTN_SM_SLEEP
+            if(SUCCESS == Btn_Sleep_Enter(&tSleep, NULL))
+            {   /* Idle, nothing happens until the next change */
+                u32Tm = (u32Idx < ptLane->u32Num) ? ptLane->ptItem[u32Idx].u32Tm : (ptLane->u32EndTm + 1);
+                continue;
+            }
+#endif
+            u32Tm++;
+        }
+
+        for(u32Cur = 0; u32Cur < ptLane->u32PressNum; u32Cur++)
+        {
+            if(!(s_pu8Got[u32Cur] & TUNE_GOT_PRESS)
+            || (ptLane->ptPress[u32Cur].u8Long && !(s_pu8Got[u32Cur] & TUNE_GOT_LONG)))
+            {
+                ptScore->u32Miss++;
+            }
+        }
+    }
+
+    ptScore->u32Lat     = (uint32)((0 == u32LatNum)  ? TUNE_NO_LAT : (u64Lat * 100 / u32LatNum));
+    ptScore->u32LongLat = (uint32)((0 == u32LongNum) ? TUNE_NO_LAT : (u64LongLat * 100 / u32LongNum));
+}
+
+/******************************************************************************
+* Name       : static uint8 Tune_Dominate(const T_TUNE_SCORE *ptA, const T_TUNE_SCORE *ptB)
+* Function   : Check if set A dominates set B
+* Input      : const T_TUNE_SCORE *ptA    Set A
+*              const T_TUNE_SCORE *ptB    Set B
+* Output:    : None
+* Return     : 1: A is NOT worse in any score and better in some score, 0: NOT
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Tune_Dominate(const T_TUNE_SCORE *ptA, const T_TUNE_SCORE *ptB)
+{
+    if((ptA->u32False > ptB->u32False) || (ptA->u32Miss > ptB->u32Miss)
+    || (ptA->u32Lat > ptB->u32Lat) || (ptA->u32LongLat > ptB->u32LongLat))
+    {
+        return 0;
+    }
+    return (uint8)((ptA->u32False < ptB->u32False) || (ptA->u32Miss < ptB->u32Miss)
+                || (ptA->u32Lat < ptB->u32Lat) || (ptA->u32LongLat < ptB->u32LongLat));
+}
+
+/******************************************************************************
+* Name       : static int Tune_Cmp(const void *pvA, const void *pvB)
+* Function   : Order of the printed sets
+* Input      : const void *pvA, *pvB   Two T_TUNE_SCORE
+* Output:    : None
+* Return     : <0, 0, >0
+* description: By false + missed, then by latency.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static int Tune_Cmp(const void *pvA, const void *pvB)
+{
+    const T_TUNE_SCORE *ptA = (const T_TUNE_SCORE *)pvA;
+    const T_TUNE_SCORE *ptB = (const T_TUNE_SCORE *)pvB;
+    uint32 u32A = ptA->u32False + ptA->u32Miss;
+    uint32 u32B = ptB->u32False + ptB->u32Miss;
+
+    if(u32A != u32B)
+    {
+        return (u32A < u32B) ? -1 : 1;
+    }
+    if(ptA->u32Lat != ptB->u32Lat)
+    {
+        return (ptA->u32Lat < ptB->u32Lat) ? -1 : 1;
+    }
+    return (ptA->u32LongLat < ptB->u32LongLat) ? -1 : (ptA->u32LongLat > ptB->u32LongLat);
+}
+
+/******************************************************************************
+* Name       : static void Tune_Lat_Print(uint32 u32Lat, int iWidth)
+* Function   : Print one latency score
+* Input      : uint32 u32Lat    Latency in 0.01 units, TUNE_NO_LAT if no event
+*              int    iWidth    Width of the column
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Tune_Lat_Print(uint32 u32Lat, int iWidth)
+{
+    if(TUNE_NO_LAT == u32Lat)
+    {
+        printf("%*s", iWidth, "-");
+    }
+    else
+    {
+        printf("%*.2f", iWidth, u32Lat / 100.0);
+    }
+}
+
+/******************************************************************************
+* Name       : int main(int argc, char *argv[])
+* Function   : Search the parameter sets and print the Pareto front
+* Input      : Please refer to the usage in file header
+* Output:    : None
+* Return     : 0        Done
+*              1        Invalid arguments or failed to get resources
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+int main(int argc, char *argv[])
+{
+    T_TUNE_SCORE *ptScore;
+    struct timespec tBeg, tEnd;
+    uint32 u32Num     = (argc > 2) ? (uint32)atoi(argv[2]) : TUNE_CONFIGS;
+    uint32 u32Workers = (uint32)sysconf(_SC_NPROCESSORS_ONLN);
+    uint32 u32Idx, u32Jdx, u32DbNum, u32LpNum, u32Front;
+    uint32 u32Press = 0, u32Long = 0;
+    double dTm = 0, dSec;
+    uint8  u8Rand;
+    pid_t  tPid;
+
+    if((argc < 2) || ((0 != strcmp(argv[1], "grid")) && (0 != strcmp(argv[1], "rand"))) || (0 == u32Num))
+    {
+        fprintf(stderr, "usage: %s grid|rand [configs] [minutes|file.vcd]\n", argv[0]);
+        return 1;
+    }
+    u8Rand = (uint8)(0 == strcmp(argv[1], "rand"));
+
+    /* Trace: generated or recorded */
+    if((argc > 3) && (NULL != strstr(argv[3], ".vcd")))
+    {
+        if(SUCCESS != Tune_Load(argv[3]))
+        {
+            fprintf(stderr, "no input in %s\n", argv[3]);
+            return 1;
+        }
+    }
+    else
+    {
+        Tune_Gen((argc > 3) ? (uint32)atoi(argv[3]) : TUNE_MINUTES);
+    }
+    for(u32Idx = 0; u32Idx < sg_u32LaneNum; u32Idx++)
+    {
+        dTm += sg_ptLane[u32Idx].u32EndTm;
+        u32Press += sg_ptLane[u32Idx].u32PressNum;
+        for(u32Jdx = 0; u32Jdx < sg_ptLane[u32Idx].u32PressNum; u32Jdx++)
+        {
+            u32Long += sg_ptLane[u32Idx].ptPress[u32Jdx].u8Long;
+        }
+    }
+
+    /* Parameter sets in shared memory, written by the workers */
+    if(!u8Rand)
+    {   /* Square grid */
+        for(u32DbNum = 1; (u32DbNum + 1) * (u32DbNum + 1) <= u32Num; u32DbNum++);
+        u32DbNum = (u32DbNum > TUNE_DB_MAX + 1) ? (TUNE_DB_MAX + 1) : u32DbNum;
+        u32LpNum = u32Num / u32DbNum;
+        u32Num   = u32DbNum * u32LpNum;
+    }
+    ptScore = mmap(NULL, u32Num * sizeof(T_TUNE_SCORE), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(MAP_FAILED == ptScore)
+    {
+        fprintf(stderr, "failed to map the scores\n");
+        return 1;
+    }
+    for(u32Idx = 0; u32Idx < u32Num; u32Idx++)
+    {
+        if(u8Rand)
+        {
+            ptScore[u32Idx].u16DbTm = (uint16)(Tune_Rand() % (TUNE_DB_MAX + 1));
+            ptScore[u32Idx].u16LpTm = (uint16)(TUNE_LP_MIN + Tune_Rand() % (TUNE_LP_MAX - TUNE_LP_MIN + 1));
+        }
+        else
+        {
+            ptScore[u32Idx].u16DbTm = (uint16)((u32DbNum < 2) ? 0 : (u32Idx % u32DbNum) * TUNE_DB_MAX / (u32DbNum - 1));
+            ptScore[u32Idx].u16LpTm = (uint16)((u32LpNum < 2) ? TUNE_LP_MIN
+                                    : (TUNE_LP_MIN + (u32Idx / u32DbNum) * (TUNE_LP_MAX - TUNE_LP_MIN) / (u32LpNum - 1)));
+        }
+    }
+
+    /* One worker per CPU, each takes every u32Workers-th set */
+    Btn_General_Init(Btn_Replay_Time, Btn_Replay_Btn_St_Get);
+    u32Workers = (0 == u32Workers) ? 1 : u32Workers;
+    u32Workers = (u32Workers > u32Num) ? u32Num : u32Workers;
+    clock_gettime(CLOCK_MONOTONIC, &tBeg);
+    for(u32Idx = 0; u32Idx < u32Workers; u32Idx++)
+    {
+        tPid = fork();
+        if(tPid < 0)
+        {
+            fprintf(stderr, "failed to start a worker\n");
+            return 1;
+        }
+        if(0 == tPid)
+        {
+            for(u32Jdx = u32Idx; u32Jdx < u32Num; u32Jdx += u32Workers)
+            {
+                Tune_Eval(&(ptScore[u32Jdx]));
+            }
+            _exit(0);
+        }
+    }
+    while(wait(NULL) > 0);
+    clock_gettime(CLOCK_MONOTONIC, &tEnd);
+    dSec = (tEnd.tv_sec - tBeg.tv_sec) + (tEnd.tv_nsec - tBeg.tv_nsec) / 1e9;
+
+    /* Pareto front */
+    u32Front = 0;
+    for(u32Idx = 0; u32Idx < u32Num; u32Idx++)
+    {
+        ptScore[u32Idx].u8Pareto = 1;
+        for(u32Jdx = 0; (u32Jdx < u32Num) && ptScore[u32Idx].u8Pareto; u32Jdx++)
+        {
+            ptScore[u32Idx].u8Pareto = !Tune_Dominate(&(ptScore[u32Jdx]), &(ptScore[u32Idx]));
+        }
+    }
+    for(u32Idx = 0; u32Idx < u32Num; u32Idx++)
+    {   /* Move the front to the head */
+        if(ptScore[u32Idx].u8Pareto)
+        {
+            T_TUNE_SCORE tTmp = ptScore[u32Front];
+
+            ptScore[u32Front++] = ptScore[u32Idx];
+            ptScore[u32Idx]     = tTmp;
+        }
+    }
+    qsort(ptScore, u32Front, sizeof(T_TUNE_SCORE), Tune_Cmp);
+
+    printf("lanes %lu, trace %.2f h, presses %lu (long %lu)\n", (unsigned long)sg_u32LaneNum,
+           dTm / 3600000.0, (unsigned long)u32Press, (unsigned long)u32Long);
+    printf("%s search, %lu sets, %lu workers, %.2f s (%.0f trace hours/s)\n", u8Rand ? "random" : "grid",
+           (unsigned long)u32Num, (unsigned long)u32Workers, dSec, dTm * u32Num / 3600000.0 / dSec);
+    printf("Pareto front, %lu sets:\n", (unsigned long)u32Front);
+    printf("debounce  long-press    false   missed  latency(ms)  long latency(ms)\n");
+    for(u32Idx = 0; u32Idx < u32Front; u32Idx++)
+    {
+        printf("%8u  %10u  %7lu  %7lu  ", (unsigned)ptScore[u32Idx].u16DbTm,
+               (unsigned)ptScore[u32Idx].u16LpTm, (unsigned long)ptScore[u32Idx].u32False,
+               (unsigned long)ptScore[u32Idx].u32Miss);
+        Tune_Lat_Print(ptScore[u32Idx].u32Lat, 11);
+        printf("  ");
+        Tune_Lat_Print(ptScore[u32Idx].u32LongLat, 16);
+        printf("\n");
+    }
+    munmap(ptScore, u32Num * sizeof(T_TUNE_SCORE));
+    return 0;
+}
+
+/* end-of-file */
@@ -0,0 +1,523 @@
+/******************************************************************************
+* File       : Btn_SM_Vcd.c
+* Function   : Value Change Dump(VCD) export and import of button activity.
+* description: Please refer to Btn_SM_Vcd.h for details.
+* Version    : V1.02
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Import by tokens, convert $timescale
+*               3    18/Oct/2026   Ian   V1.02     Import channels 1~255 regardless of MAX_BTN_CH
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Replay.h"
+#include "Btn_SM_Vcd.h"
+
+#define BTN_VCD_SIG_IN               (0)         /* Raw input signal                   */
+#define BTN_VCD_SIG_ST               (1)         /* Internal state signal              */
+#define BTN_VCD_SIG_EVT              (2)         /* Event signal                       */
+#define BTN_VCD_SIG_NUM              (3)         /* Number of signals of each channel  */
+#define BTN_VCD_UNKNOWN              (0xFF)      /* Value NOT dumped yet               */
+#define BTN_VCD_ID_LEN               (4)         /* Max length of identifier code      */
+#define BTN_VCD_LINE_LEN             (256)       /* Max length of a token for import   */
+#define BTN_VCD_IMPORT_CH            (255)       /* Max channel number of import       */
+
+/* One change of a signal */
+typedef struct _T_BTN_VCD_REC_
+{
+    uint32      u32Tm;              /* Extended time of the change   */
+    uint8       u8Ch;               /* Channel number                */
+    uint8       u8Sig;              /* Signal of the channel         */
+    uint8       u8Val;              /* New value of the signal       */
+}T_BTN_VCD_REC;
+
+static FILE           *sg_ptFile                  = NULL;  /* VCD file                        */
+static PF_GET_TM       sg_pfVcdGetTm              = NULL;  /* Function to get general time    */
+static uint32          sg_u32Tm                   = 0;     /* Extended time                   */
+static uint16          sg_u16LastTm               = 0;     /* Last 16-bit time                */
+static uint32          sg_u32WrTm                 = 0;     /* Time of the last written change */
+static uint8           sg_aau8Last[MAX_BTN_CH][BTN_VCD_SIG_NUM]; /* Last dumped values        */
+
+static T_BTN_VCD_REC   sg_aatBuf[2][BTN_VCD_BUF_NUM];      /* Double buffer of changes        */
+static uint32          sg_au32Cnt[2];                      /* Number of changes in buffers    */
+static uint8           sg_u8Fill                  = 0;     /* Buffer being filled by scan     */
+static uint8           sg_u8Pending               = 0;     /* Other buffer is waiting to write*/
+static uint8           sg_u8Stop                  = 0;     /* Writer thread should exit       */
+static pthread_t       sg_tThread;                         /* Writer thread                   */
+static pthread_mutex_t sg_tMutex                  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  sg_tReady                  = PTHREAD_COND_INITIALIZER; /* Buffer pending */
+static pthread_cond_t  sg_tFree                   = PTHREAD_COND_INITIALIZER; /* Buffer written */
+
+/******************************************************************************
+* Name       : static void Btn_Vcd_Id(uint16 u16Sig, char *pcId)
+* Function   : Make the identifier code of one signal
+* Input      : uint16 u16Sig   Index of the signal
+* Output:    : char  *pcId     Identifier code, printable characters '!'~'~'
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vcd_Id(uint16 u16Sig, char *pcId)
+{
+    do
+    {
+        *pcId++ = (char)('!' + (u16Sig % 94));
+        u16Sig /= 94;
+    }while(u16Sig);
+    *pcId = '\0';
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vcd_Write(const T_BTN_VCD_REC *ptRec, uint32 u32Cnt)
+* Function   : Format a batch of changes into the VCD file
+* Input      : const T_BTN_VCD_REC *ptRec    Changes in time order
+*              uint32               u32Cnt   Number of changes
+* Output:    : None
+* Return     : None
+* description: Runs in the writer thread.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vcd_Write(const T_BTN_VCD_REC *ptRec, uint32 u32Cnt)
+{
+    char          acId[BTN_VCD_ID_LEN];
+    uint8         u8Bit;
+
+    for(; u32Cnt; u32Cnt--, ptRec++)
+    {
+        if(ptRec->u32Tm != sg_u32WrTm)
+        {   /* New time stamp */
+            sg_u32WrTm = ptRec->u32Tm;
+            fprintf(sg_ptFile, "#%lu\n", (unsigned long)sg_u32WrTm);
+        }
+
+        Btn_Vcd_Id((uint16)((ptRec->u8Ch - 1) * BTN_VCD_SIG_NUM + ptRec->u8Sig), acId);
+        if(BTN_VCD_SIG_IN == ptRec->u8Sig)
+        {   /* Scalar value */
+            fprintf(sg_ptFile, "%u%s\n", ptRec->u8Val, acId);
+        }
+        else
+        {   /* Vector value */
+            fputc('b', sg_ptFile);
+            for(u8Bit = 8; u8Bit; u8Bit--)
+            {
+                fputc('0' + ((ptRec->u8Val >> (u8Bit - 1)) & 1), sg_ptFile);
+            }
+            fprintf(sg_ptFile, " %s\n", acId);
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static void* Btn_Vcd_Thread(void *pvArg)
+* Function   : Writer thread, write the pending buffers until stopped
+* Input      : void *pvArg     Not used
+* Output:    : None
+* Return     : NULL
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void* Btn_Vcd_Thread(void *pvArg)
+{
+    uint8 u8Idx;
+
+    (void)pvArg;
+    pthread_mutex_lock(&sg_tMutex);
+    while(1)
+    {
+        while((!sg_u8Pending) && (!sg_u8Stop))
+        {
+            pthread_cond_wait(&sg_tReady, &sg_tMutex);
+        }
+        if(!sg_u8Pending)
+        {   /* Stopped and nothing left */
+            break;
+        }
+
+        /* The pending buffer is the one NOT being filled */
+        u8Idx = (uint8)(sg_u8Fill ^ 1);
+        pthread_mutex_unlock(&sg_tMutex);
+        Btn_Vcd_Write(sg_aatBuf[u8Idx], sg_au32Cnt[u8Idx]);
+        pthread_mutex_lock(&sg_tMutex);
+
+        sg_u8Pending = 0;
+        pthread_cond_signal(&sg_tFree);
+    }
+    pthread_mutex_unlock(&sg_tMutex);
+    return NULL;
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vcd_Swap(void)
+* Function   : Hand the buffer being filled to the writer thread
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: Waits only if the writer has NOT finished the previous buffer.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vcd_Swap(void)
+{
+    pthread_mutex_lock(&sg_tMutex);
+    while(sg_u8Pending)
+    {
+        pthread_cond_wait(&sg_tFree, &sg_tMutex);
+    }
+    sg_u8Fill ^= 1;
+    sg_au32Cnt[sg_u8Fill] = 0;
+    sg_u8Pending = 1;
+    pthread_cond_signal(&sg_tReady);
+    pthread_mutex_unlock(&sg_tMutex);
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Vcd_Open(const char *pcPath, PF_GET_TM pfGetTm)
+* Function   : Create the VCD file and start the writer thread
+* Input      : const char *pcPath     Path of the VCD file
+*              PF_GET_TM   pfGetTm    Function to get general time, same as the one
+*                                     given to the module
+* Output:    : None
+* Return     : BTN_ERROR              Failed to create the file or the thread
+*              SUCCESS                The writer is started
+* description: The 16-bit time is extended to 32 bits, so the dump may be longer
+*              than one wrap of the clock as long as the scan runs at least once
+*              per wrap.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vcd_Open(const char *pcPath, PF_GET_TM pfGetTm)
+{
+    static const char *s_apcSig[BTN_VCD_SIG_NUM] = {"wire 1", "reg 8", "reg 8"};
+    static const char *s_apcName[BTN_VCD_SIG_NUM] = {"in", "st", "evt"};
+    char  acId[BTN_VCD_ID_LEN];
+    uint8 u8Ch, u8Sig;
+
+    /* Check if the input parameter is valid or NOT */
+    if((NULL == pcPath) || (NULL == pfGetTm) || (NULL != sg_ptFile))
+    {   /* Return if the parameter is invalid or the writer is already started */
+        return BTN_ERROR;
+    }
+
+    sg_ptFile = fopen(pcPath, "w");
+    if(NULL == sg_ptFile)
+    {
+        return BTN_ERROR;
+    }
+
+    /* Header and variable definitions */
+    fprintf(sg_ptFile, "$timescale 1ms $end\n$scope module btn $end\n");
+    for(u8Ch = 1; u8Ch <= MAX_BTN_CH; u8Ch++)
+    {
+        for(u8Sig = 0; u8Sig < BTN_VCD_SIG_NUM; u8Sig++)
+        {
+            Btn_Vcd_Id((uint16)((u8Ch - 1) * BTN_VCD_SIG_NUM + u8Sig), acId);
+            fprintf(sg_ptFile, "$var %s %s ch%u_%s $end\n", s_apcSig[u8Sig], acId, u8Ch, s_apcName[u8Sig]);
+            sg_aau8Last[u8Ch - 1][u8Sig] = BTN_VCD_UNKNOWN;
+        }
+    }
+    fprintf(sg_ptFile, "$upscope $end\n$enddefinitions $end\n");
+
+    sg_pfVcdGetTm = pfGetTm;
+    sg_u16LastTm  = pfGetTm();
+    sg_u32Tm      = 0;
+    sg_u32WrTm    = 0xFFFFFFFF;
+    sg_u8Fill     = 0;
+    sg_au32Cnt[0] = 0;
+    sg_u8Pending  = 0;
+    sg_u8Stop     = 0;
+
+    if(0 != pthread_create(&sg_tThread, NULL, Btn_Vcd_Thread, NULL))
+    {
+        fclose(sg_ptFile);
+        sg_ptFile = NULL;
+        return BTN_ERROR;
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : void Btn_Vcd_Trace(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt)
+* Function   : Trace hook to be set with Btn_Trace_Set() (PF_BTN_TRACE)
+* Input      : Please refer to PF_BTN_TRACE
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Vcd_Trace(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt)
+{
+    uint8  *pu8Last;
+    uint8   au8Val[BTN_VCD_SIG_NUM];
+    uint8   u8Sig;
+    uint16  u16Tm;
+    T_BTN_VCD_REC *ptRec;
+
+    if((NULL == sg_ptFile) || (0 == u8Ch) || (u8Ch > MAX_BTN_CH))
+    {   /* Writer is NOT started or the channel is invalid */
+        return;
+    }
+
+    pu8Last   = sg_aau8Last[u8Ch - 1];
+    au8Val[BTN_VCD_SIG_IN]  = u8BtnSt;
+    au8Val[BTN_VCD_SIG_ST]  = u8St;
+    au8Val[BTN_VCD_SIG_EVT] = u8Evt;
+
+    /* Nothing to do if no signal is changed */
+    if((pu8Last[0] == au8Val[0]) && (pu8Last[1] == au8Val[1]) && (pu8Last[2] == au8Val[2]))
+    {
+        return;
+    }
+
+    /* Extend the time, the difference is always right within one wrap */
+    u16Tm         = sg_pfVcdGetTm();
+    sg_u32Tm     += (uint16)(u16Tm - sg_u16LastTm);
+    sg_u16LastTm  = u16Tm;
+
+    for(u8Sig = 0; u8Sig < BTN_VCD_SIG_NUM; u8Sig++)
+    {
+        if(pu8Last[u8Sig] == au8Val[u8Sig])
+        {
+            continue;
+        }
+        pu8Last[u8Sig] = au8Val[u8Sig];
+
+        if(BTN_VCD_BUF_NUM == sg_au32Cnt[sg_u8Fill])
+        {   /* Buffer is full, hand it to the writer */
+            Btn_Vcd_Swap();
+        }
+        ptRec = &(sg_aatBuf[sg_u8Fill][sg_au32Cnt[sg_u8Fill]++]);
+        ptRec->u32Tm = sg_u32Tm;
+        ptRec->u8Ch  = u8Ch;
+        ptRec->u8Sig = u8Sig;
+        ptRec->u8Val = au8Val[u8Sig];
+    }
+}
+
+/******************************************************************************
+* Name       : void Btn_Vcd_Close(void)
+* Function   : Flush the buffered changes, stop the writer thread and close the file
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Vcd_Close(void)
+{
+    if(NULL == sg_ptFile)
+    {
+        return;
+    }
+
+    /* Flush the buffer being filled */
+    if(sg_au32Cnt[sg_u8Fill])
+    {
+        Btn_Vcd_Swap();
+    }
+
+    pthread_mutex_lock(&sg_tMutex);
+    sg_u8Stop = 1;
+    pthread_cond_signal(&sg_tReady);
+    pthread_mutex_unlock(&sg_tMutex);
+    pthread_join(sg_tThread, NULL);
+
+    fclose(sg_ptFile);
+    sg_ptFile = NULL;
+}
+
+/******************************************************************************
+* Name       : static uint8 Btn_Vcd_Tok(FILE *ptFile, char *pcTok)
+* Function   : Read the next token of a VCD file
+* Input      : FILE *ptFile    The VCD file
+* Output:    : char *pcTok     The token, BTN_VCD_LINE_LEN characters at most
+* Return     : 1               A token is read
+*              0               End of file
+* description: VCD is a stream of tokens separated by white space, so keywords
+*              such as "$var" may be split over several lines.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Vcd_Tok(FILE *ptFile, char *pcTok)
+{
+    return (uint8)(1 == fscanf(ptFile, "%255s", pcTok));
+}
+
+/******************************************************************************
+* Name       : static uint8 Btn_Vcd_Scale(FILE *ptFile, unsigned long long *pullMul,
+*                                         unsigned long long *pullDiv)
+* Function   : Read the body of "$timescale" and get the ratio of time to ms
+* Input      : FILE *ptFile                  The VCD file, after "$timescale"
+* Output:    : unsigned long long *pullMul   Time in ms = time * Mul / Div
+*              unsigned long long *pullDiv
+* Return     : SUCCESS                       The time scale is got
+*              BTN_ERROR                     The time scale is invalid
+* description: The number and the unit may be one token ("1us") or two ("1 us").
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Vcd_Scale(FILE *ptFile, unsigned long long *pullMul, unsigned long long *pullDiv)
+{
+    static const char              *s_apcUnit[] = {"s", "ms", "us", "ns", "ps", "fs"};
+    static const unsigned long long s_aullDiv[] = {1ULL, 1ULL, 1000ULL, 1000000ULL,
+                                                   1000000000ULL, 1000000000000ULL};
+    char          acTok[BTN_VCD_LINE_LEN], acScale[BTN_VCD_LINE_LEN], acUnit[BTN_VCD_LINE_LEN];
+    unsigned long ulNum = 0;
+    uint8         u8Idx;
+
+    acScale[0] = '\0';
+    while(Btn_Vcd_Tok(ptFile, acTok) && (0 != strcmp(acTok, "$end")))
+    {
+        if(strlen(acScale) + strlen(acTok) < sizeof(acScale))
+        {
+            strcat(acScale, acTok);
+        }
+    }
+
+    if((2 != sscanf(acScale, "%lu%255s", &ulNum, acUnit)) || ((1 != ulNum) && (10 != ulNum) && (100 != ulNum)))
+    {
+        return BTN_ERROR;
+    }
+    for(u8Idx = 0; u8Idx < sizeof(s_apcUnit) / sizeof(s_apcUnit[0]); u8Idx++)
+    {
+        if(0 == strcmp(acUnit, s_apcUnit[u8Idx]))
+        {
+            *pullMul = (0 == u8Idx) ? (ulNum * 1000ULL) : ulNum;
+            *pullDiv = s_aullDiv[u8Idx];
+            return SUCCESS;
+        }
+    }
+    return BTN_ERROR;
+}
+
+/******************************************************************************
+* Name       : uint32 Btn_Vcd_Import(const char *pcPath, T_BTN_TRACE_ITEM *ptItem,
+*                                    uint32 u32Max)
+* Function   : Read the input signals of a VCD file into a replay trace
+* Input      : const char       *pcPath    Path of the VCD file
+*              uint32            u32Max    Max number of items in ptItem
+* Output:    : T_BTN_TRACE_ITEM *ptItem    Input changes in time order
+* Return     : 0~u32Max                    Number of items read
+* description: Scalar signals named "chN_in" (N is 1~255, NOT limited by
+*              MAX_BTN_CH) are imported as channel N, all other signals are
+*              ignored. Btn_SM_Replay.c ignores the channels above MAX_BTN_CH. The time is converted from "$timescale" to ms
+*              (1 ms if there is no "$timescale"). Reading stops when ptItem is
+*              full. 0 is returned if the time scale is NOT supported.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Vcd_Import(const char *pcPath, T_BTN_TRACE_ITEM *ptItem, uint32 u32Max)
+{
+    static char s_aacId[BTN_VCD_IMPORT_CH][BTN_VCD_LINE_LEN];  /* Identifier code of each input */
+    char   acTok[BTN_VCD_LINE_LEN];
+    char   acSize[BTN_VCD_LINE_LEN], acId[BTN_VCD_LINE_LEN], acName[BTN_VCD_LINE_LEN];
+    char   acSuffix[BTN_VCD_LINE_LEN];
+    FILE  *ptFile;
+    unsigned long long ullMul = 1, ullDiv = 1;
+    uint32 u32Num = 0, u32Tm = 0;
+    unsigned int uiCh = 0;
+    uint8  u8Idx;
+
+    if((NULL == pcPath) || (NULL == ptItem))
+    {
+        return 0;
+    }
+    ptFile = fopen(pcPath, "r");
+    if(NULL == ptFile)
+    {
+        return 0;
+    }
+
+    for(u8Idx = 0; u8Idx < BTN_VCD_IMPORT_CH; u8Idx++)
+    {
+        s_aacId[u8Idx][0] = '\0';
+    }
+
+    while((u32Num < u32Max) && Btn_Vcd_Tok(ptFile, acTok))
+    {
+        if(0 == strcmp(acTok, "$var"))
+        {   /* Variable definition "$var type size id name [range] $end" */
+            if(!Btn_Vcd_Tok(ptFile, acName) || !Btn_Vcd_Tok(ptFile, acSize) ||
+               !Btn_Vcd_Tok(ptFile, acId)   || !Btn_Vcd_Tok(ptFile, acName))
+            {
+                break;
+            }
+            /* Only "chN_in" with 1 bit is imported */
+            if((0 == strcmp(acSize, "1")) && (2 == sscanf(acName, "ch%u_%255s", &uiCh, acSuffix)) &&
+               (0 == strcmp(acSuffix, "in")) && (0 != uiCh) && (uiCh <= BTN_VCD_IMPORT_CH))
+            {
+                strcpy(s_aacId[uiCh - 1], acId);
+            }
+            while((0 != strcmp(acName, "$end")) && Btn_Vcd_Tok(ptFile, acName))
+            {   /* Skip the range */
+            }
+        }
+        else if(0 == strcmp(acTok, "$timescale"))
+        {
+            if(SUCCESS != Btn_Vcd_Scale(ptFile, &ullMul, &ullDiv))
+            {   /* Time can NOT be converted to ms */
+                u32Num = 0;
+                break;
+            }
+        }
+        else if((0 == strcmp(acTok, "$comment")) || (0 == strcmp(acTok, "$date")) ||
+                (0 == strcmp(acTok, "$version")) || (0 == strcmp(acTok, "$scope")))
+        {   /* Skip the text of the keyword */
+            while(Btn_Vcd_Tok(ptFile, acTok) && (0 != strcmp(acTok, "$end")))
+            {
+            }
+        }
+        else if('#' == acTok[0])
+        {   /* New time stamp */
+            u32Tm = (uint32)(strtoull(&acTok[1], NULL, 10) * ullMul / ullDiv);
+        }
+        else if(('0' == acTok[0]) || ('1' == acTok[0]))
+        {   /* Scalar change */
+            for(u8Idx = 0; u8Idx < BTN_VCD_IMPORT_CH; u8Idx++)
+            {
+                if(('\0' != s_aacId[u8Idx][0]) && (0 == strcmp(&acTok[1], s_aacId[u8Idx])))
+                {
+                    ptItem[u32Num].u32Tm   = u32Tm;
+                    ptItem[u32Num].u8Ch    = (uint8)(u8Idx + 1);
+                    ptItem[u32Num].u8Level = (uint8)(acTok[0] - '0');
+                    u32Num++;
+                    break;
+                }
+            }
+        }
+        else if(('b' == acTok[0]) || ('B' == acTok[0]) || ('r' == acTok[0]) || ('R' == acTok[0]))
+        {   /* Vector or real change, skip its identifier code */
+            if(!Btn_Vcd_Tok(ptFile, acTok))
+            {
+                break;
+            }
+        }
+        /* Other tokens (x/z values, $dumpvars, $end...) are ignored */
+    }
+
+    fclose(ptFile);
+    return u32Num;
+}
+
+/* end-of-file */
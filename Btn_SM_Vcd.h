@@ -0,0 +1,111 @@
+/******************************************************************************
+* File       : Btn_SM_Vcd.h
+* Function   : Value Change Dump(VCD) export and import of button activity.
+* description: The writer is fed from the trace hook of the button state machine
+*              (__BTN_SM_TRACE). For each channel three signals are dumped:
+*                  * chN_in     wire 1    Raw input of the button
+*                  * chN_st     reg  8    Internal state, including hidden ones such
+*                                         as BTN_PRESS_PRE_ST
+*                  * chN_evt    reg  8    Event output, BTN_NONE_EVT if no event
+*              Only changes are written. The trace hook only compares and appends to
+*              a buffer; full buffers are formatted and written to the file by a
+*              background thread, so the scan is NOT blocked by file I/O.
+*
+*              The importer reads the "chN_in" signals of a VCD file back into a
+*              replay trace for Btn_SM_Replay.c, so a dumped session can be re-run.
+*
+*              HOW TO USE:
+*              Step 1: Call "Btn_Vcd_Open()" after init of the module.
+*              Step 2: Call "Btn_Trace_Set(Btn_Vcd_Trace)".
+*              Step 3: Process the channels as usual.
+*              Step 4: Call "Btn_Trace_Set(NULL)" and "Btn_Vcd_Close()".
+*
+*              NOTE: This file is for host (POSIX) environment only.
+* Version    : V1.02
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Import by tokens, convert $timescale
+*               3    18/Oct/2026   Ian   V1.02     Import channels 1~255 regardless of MAX_BTN_CH
+******************************************************************************/
+
+#ifndef _BTN_SM_VCD_
+#define _BTN_SM_VCD_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BTN_VCD_BUF_NUM              (8192)      /* Number of changes in one buffer    */
+
+/******************************************************************************
+* Name       : uint8 Btn_Vcd_Open(const char *pcPath, PF_GET_TM pfGetTm)
+* Function   : Create the VCD file and start the writer thread
+* Input      : const char *pcPath     Path of the VCD file
+*              PF_GET_TM   pfGetTm    Function to get general time, same as the one
+*                                     given to the module
+* Output:    : None
+* Return     : BTN_ERROR              Failed to create the file or the thread
+*              SUCCESS                The writer is started
+* description: The 16-bit time is extended to 32 bits, so the dump may be longer
+*              than one wrap of the clock as long as the scan runs at least once
+*              per wrap.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vcd_Open(const char *pcPath, PF_GET_TM pfGetTm);
+
+/******************************************************************************
+* Name       : void Btn_Vcd_Trace(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt)
+* Function   : Trace hook to be set with Btn_Trace_Set() (PF_BTN_TRACE)
+* Input      : Please refer to PF_BTN_TRACE
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Vcd_Trace(uint8 u8Ch, uint8 u8BtnSt, uint8 u8St, uint8 u8Evt);
+
+/******************************************************************************
+* Name       : void Btn_Vcd_Close(void)
+* Function   : Flush the buffered changes, stop the writer thread and close the file
+* Input      : None
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+void Btn_Vcd_Close(void);
+
+/******************************************************************************
+* Name       : uint32 Btn_Vcd_Import(const char *pcPath, T_BTN_TRACE_ITEM *ptItem,
+*                                    uint32 u32Max)
+* Function   : Read the input signals of a VCD file into a replay trace
+* Input      : const char       *pcPath    Path of the VCD file
+*              uint32            u32Max    Max number of items in ptItem
+* Output:    : T_BTN_TRACE_ITEM *ptItem    Input changes in time order
+* Return     : 0~u32Max                    Number of items read
+* description: Scalar signals named "chN_in" (N is 1~255, NOT limited by
+*              MAX_BTN_CH) are imported as channel N, all other signals are
+*              ignored. Btn_SM_Replay.c ignores the channels above MAX_BTN_CH. The time is converted from "$timescale" to ms
+*              (1 ms if there is no "$timescale"). Reading stops when ptItem is
+*              full. 0 is returned if the time scale is NOT supported.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Vcd_Import(const char *pcPath, T_BTN_TRACE_ITEM *ptItem, uint32 u32Max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_VCD_ */
+
+/* end-of-file */
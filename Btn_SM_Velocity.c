@@ -0,0 +1,471 @@
+/******************************************************************************
+* File       : Btn_SM_Velocity.c
+* Function   : Velocity sensing of dual-contact keys (musical keyboards).
+* description: Please refer to Btn_SM_Velocity.h for details.
+* Version    : V1.01
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+*               2    18/Oct/2026   Ian   V1.01     Barriers of the edge queue
+******************************************************************************/
+
+#include "common.h"
+#include "Btn_SM_Config.h"
+#include "Btn_SM_Module.h"
+#include "Btn_SM_Velocity.h"
+
+#ifdef __BTN_SM_VELOCITY
+
+#define BTN_VEL_IDLE_ST              (0)         /* Key is released                     */
+#define BTN_VEL_MOVE_ST              (1)         /* Contact 1 is closed, no note        */
+#define BTN_VEL_ON_ST                (2)         /* Note is on                          */
+#define BTN_VEL_RELEASE_ST           (3)         /* Contact 2 is open, note is still on */
+
+#define BTN_VEL_CONTACT_1            (0)         /* Contact 1 (start of travel)         */
+#define BTN_VEL_CONTACT_2            (1)         /* Contact 2 (end of travel)           */
+
+/*******************************************************************************
+* Structure  : T_BTN_VEL_EDGE
+* Description: Structure of one contact edge in the queue.
+* Memebers   : Type    Member    Range                  Descrption
+*              uint32  u32Tm     0~                     Time stamp of the edge
+*              uint16  u16Contact 0~CONTACT_NUM-1       Index of the contact
+*              uint8   u8Level   BTN_STATE_0/1          The new level
+*******************************************************************************/
+typedef struct _T_BTN_VEL_EDGE_
+{
+    uint32      u32Tm;              /* Time stamp of the edge */
+    uint16      u16Contact;         /* Index of the contact   */
+    uint8       u8Level;            /* New level              */
+}T_BTN_VEL_EDGE;
+
+static const T_BTN_VEL_PARA *sg_ptVelPara = NULL;                      /* Parameters                  */
+static uint32          sg_au32VelRaw[BTN_VEL_WORDS];                   /* Last levels of contacts     */
+static uint32          sg_au32VelLvl[BTN_VEL_WORDS];                   /* Taken levels of contacts    */
+static uint32          sg_au32VelEdgeTm[BTN_VEL_CONTACT_NUM];          /* Time of the last taken edge */
+static uint32          sg_au32VelKeyTm[MAX_BTN_VEL_KEY];               /* Start time of key timing    */
+static uint8           sg_au8VelKeySt[MAX_BTN_VEL_KEY];                /* State of keys               */
+static uint8           sg_u8VelPend = 0;                               /* Some edges are locked       */
+
+static T_BTN_VEL_EDGE  sg_atVelQueue[BTN_VEL_QUEUE_LEN];               /* Queue of edges from ISR     */
+static volatile uint16 sg_u16VelHead = 0;                              /* Written by ISR              */
+static volatile uint16 sg_u16VelTail = 0;                              /* Written by main loop        */
+static uint32          sg_u32VelDrop = 0;                              /* Edges dropped by full queue */
+
+/******************************************************************************
+* Name       : static uint8 Btn_Vel_Curve(uint32 u32Dt)
+* Function   : Map the time between contacts to velocity
+* Input      : uint32 u32Dt     Time between contacts
+* Output:    : None
+* Return     : 0~127            Velocity
+* description: Linear between the curve points.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static uint8 Btn_Vel_Curve(uint32 u32Dt)
+{
+    const uint32 *pu32Dt  = sg_ptVelPara->pu32Dt;
+    const uint8  *pu8Vel  = sg_ptVelPara->pu8Vel;
+    uint8         u8Idx;
+    uint32        u32Span;
+    long          lDiff;
+
+    if(u32Dt <= pu32Dt[0])
+    {   /* Faster than the first point */
+        return pu8Vel[0];
+    }
+    for(u8Idx = 1; u8Idx < sg_ptVelPara->u8Num; u8Idx++)
+    {
+        if(u32Dt <= pu32Dt[u8Idx])
+        {   /* In the segment of (u8Idx - 1, u8Idx) */
+            u32Span = pu32Dt[u8Idx] - pu32Dt[u8Idx - 1];
+            lDiff   = (long)pu8Vel[u8Idx] - (long)pu8Vel[u8Idx - 1];
+            return (uint8)((long)pu8Vel[u8Idx - 1]
+                         + lDiff * (long)(u32Dt - pu32Dt[u8Idx - 1]) / (long)(u32Span ? u32Span : 1));
+        }
+    }
+    /* Slower than the last point */
+    return pu8Vel[sg_ptVelPara->u8Num - 1];
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vel_Note(uint8 u8KeyIdx, uint8 u8Evt, uint32 u32Dt,
+*                                       uint32 u32Tm)
+* Function   : Output one note event
+* Input      : uint8  u8KeyIdx   0~MAX_BTN_VEL_KEY-1   Index of the key
+*              uint8  u8Evt      BTN_VEL_NOTE_XXX_EVT  The event
+*              uint32 u32Dt      0~                    Time between contacts
+*              uint32 u32Tm      0~                    Time of the event
+* Output:    : None
+* Return     : None
+* description: None.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vel_Note(uint8 u8KeyIdx, uint8 u8Evt, uint32 u32Dt, uint32 u32Tm)
+{
+    T_BTN_VEL_EVT tEvt;
+
+    tEvt.u32Tm = u32Tm;
+    tEvt.u8Key = (uint8)(u8KeyIdx + 1);
+    tEvt.u8Evt = u8Evt;
+    tEvt.u8Vel = Btn_Vel_Curve(u32Dt);
+    sg_ptVelPara->pfEvt(&tEvt);
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vel_Key(uint8 u8KeyIdx, uint8 u8Contact, uint8 u8Level,
+*                                      uint32 u32Tm)
+* Function   : Run the key state machine on one taken contact edge
+* Input      : uint8  u8KeyIdx   0~MAX_BTN_VEL_KEY-1   Index of the key
+*              uint8  u8Contact  BTN_VEL_CONTACT_1/2   The contact
+*              uint8  u8Level    BTN_STATE_0/1         The new level, "1" is closed
+*              uint32 u32Tm      0~                    Time of the edge
+* Output:    : None
+* Return     : None
+* description: Please refer to the events of a key in Btn_SM_Velocity.h.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vel_Key(uint8 u8KeyIdx, uint8 u8Contact, uint8 u8Level, uint32 u32Tm)
+{
+    uint8 u8St = sg_au8VelKeySt[u8KeyIdx];
+
+    if(BTN_VEL_CONTACT_1 == u8Contact)
+    {
+        if(u8Level)
+        {   /* Contact 1 closes: key starts to move */
+            if(BTN_VEL_IDLE_ST == u8St)
+            {
+                sg_au32VelKeyTm[u8KeyIdx] = u32Tm;
+                sg_au8VelKeySt[u8KeyIdx]  = BTN_VEL_MOVE_ST;
+            }
+        }
+        else
+        {   /* Contact 1 opens: key is back */
+            if(BTN_VEL_RELEASE_ST == u8St)
+            {
+                Btn_Vel_Note(u8KeyIdx, BTN_VEL_NOTE_OFF_EVT, u32Tm - sg_au32VelKeyTm[u8KeyIdx], u32Tm);
+            }
+            else if(BTN_VEL_ON_ST == u8St)
+            {   /* Opening of contact 2 is missed */
+                Btn_Vel_Note(u8KeyIdx, BTN_VEL_NOTE_OFF_EVT, 0, u32Tm);
+            }
+            sg_au8VelKeySt[u8KeyIdx] = BTN_VEL_IDLE_ST;
+        }
+    }
+    else
+    {
+        if(u8Level)
+        {   /* Contact 2 closes: note on */
+            if(BTN_VEL_ON_ST != u8St)
+            {   /* Closing of contact 1 is missed in BTN_VEL_IDLE_ST, the fastest */
+                Btn_Vel_Note(u8KeyIdx, BTN_VEL_NOTE_ON_EVT,
+                             (BTN_VEL_IDLE_ST == u8St) ? 0 : (u32Tm - sg_au32VelKeyTm[u8KeyIdx]), u32Tm);
+                sg_au8VelKeySt[u8KeyIdx] = BTN_VEL_ON_ST;
+            }
+        }
+        else
+        {   /* Contact 2 opens: key starts to release */
+            if(BTN_VEL_ON_ST == u8St)
+            {
+                sg_au32VelKeyTm[u8KeyIdx] = u32Tm;
+                sg_au8VelKeySt[u8KeyIdx]  = BTN_VEL_RELEASE_ST;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vel_Contact(uint16 u16Contact, uint8 u8Level,
+*                                          uint32 u32Tm)
+* Function   : Filter the bounce of one contact edge
+* Input      : uint16 u16Contact  0~CONTACT_NUM-1   Index of the contact
+*              uint8  u8Level     BTN_STATE_0/1     The new level
+*              uint32 u32Tm       0~                Time of the edge
+* Output:    : None
+* Return     : None
+* description: The edge is taken if the lock time of the contact is over.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vel_Contact(uint16 u16Contact, uint8 u8Level, uint32 u32Tm)
+{
+    uint32 u32Bit  = (uint32)1 << (u16Contact & 31);
+    uint16 u16Word = u16Contact >> 5;
+
+    /* Keep the level */
+    sg_au32VelRaw[u16Word] = u8Level ? (sg_au32VelRaw[u16Word] | u32Bit) : (sg_au32VelRaw[u16Word] & ~u32Bit);
+
+    /* Check if the level is already taken */
+    if(((sg_au32VelLvl[u16Word] & u32Bit) != 0) == (u8Level != 0))
+    {   /* Bounce back in lock time */
+        return;
+    }
+
+    /* Check if the contact is locked */
+    if((u32Tm - sg_au32VelEdgeTm[u16Contact]) < sg_ptVelPara->u32LockTm)
+    {   /* Take it at the end of lock time if the level is kept */
+        sg_u8VelPend = 1;
+        return;
+    }
+
+    sg_au32VelLvl[u16Word]         ^= u32Bit;
+    sg_au32VelEdgeTm[u16Contact]    = u32Tm;
+    Btn_Vel_Key((uint8)(u16Contact >> 1), (uint8)(u16Contact & 1), u8Level, u32Tm);
+}
+
+/******************************************************************************
+* Name       : static void Btn_Vel_Settle(uint32 u32Now)
+* Function   : Take the locked edges whose lock time is over
+* Input      : uint32 u32Now     Current time
+* Output:    : None
+* Return     : None
+* description: The edge is taken at the end of the lock time.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+static void Btn_Vel_Settle(uint32 u32Now)
+{
+    uint32 u32Diff, u32EdgeTm;
+    uint16 u16Word, u16Contact;
+    uint8  u8Bit, u8Pend = 0;
+
+    for(u16Word = 0; u16Word < BTN_VEL_WORDS; u16Word++)
+    {
+        u32Diff = sg_au32VelRaw[u16Word] ^ sg_au32VelLvl[u16Word];
+        for(u8Bit = 0; u32Diff; u8Bit++, u32Diff >>= 1)
+        {
+            if(0 == (u32Diff & 1))
+            {
+                continue;
+            }
+            u16Contact = (uint16)((u16Word << 5) + u8Bit);
+            u32EdgeTm  = sg_au32VelEdgeTm[u16Contact] + sg_ptVelPara->u32LockTm;
+            if((u32Now - sg_au32VelEdgeTm[u16Contact]) < sg_ptVelPara->u32LockTm)
+            {   /* Still locked */
+                u8Pend = 1;
+                continue;
+            }
+            sg_au32VelLvl[u16Word]      ^= (uint32)1 << u8Bit;
+            sg_au32VelEdgeTm[u16Contact] = u32EdgeTm;
+            Btn_Vel_Key((uint8)(u16Contact >> 1), (uint8)(u16Contact & 1),
+                        (uint8)((sg_au32VelRaw[u16Word] >> u8Bit) & 1), u32EdgeTm);
+        }
+    }
+    sg_u8VelPend = u8Pend;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Init(const T_BTN_VEL_PARA *ptPara)
+* Function   : Init velocity sensing
+* Input      : const T_BTN_VEL_PARA *ptPara   Parameters, must be kept by caller
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All contacts are set open, all keys are released and the queue is
+*              cleared.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Init(const T_BTN_VEL_PARA *ptPara)
+{
+    uint16 u16Idx;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == ptPara) || (NULL == ptPara->pu32Dt) || (NULL == ptPara->pu8Vel)
+    || (0 == ptPara->u8Num) || (NULL == ptPara->pfEvt))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    sg_ptVelPara = ptPara;
+    for(u16Idx = 0; u16Idx < BTN_VEL_WORDS; u16Idx++)
+    {
+        sg_au32VelRaw[u16Idx] = 0;
+        sg_au32VelLvl[u16Idx] = 0;
+    }
+    for(u16Idx = 0; u16Idx < BTN_VEL_CONTACT_NUM; u16Idx++)
+    {   /* No lock at start */
+        sg_au32VelEdgeTm[u16Idx] = (uint32)0 - ptPara->u32LockTm;
+    }
+    for(u16Idx = 0; u16Idx < MAX_BTN_VEL_KEY; u16Idx++)
+    {
+        sg_au8VelKeySt[u16Idx] = BTN_VEL_IDLE_ST;
+    }
+    sg_u8VelPend  = 0;
+    sg_u16VelHead = 0;
+    sg_u16VelTail = 0;
+    sg_u32VelDrop = 0;
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Edge_Put(uint8 u8Key, uint8 u8Contact, uint8 u8Level,
+*                                     uint32 u32Tm)
+* Function   : Put one contact edge into the queue (from ISR)
+* Input      : uint8  u8Key      1~MAX_BTN_VEL_KEY  The number of key
+*              uint8  u8Contact  1~2                The number of contact
+*              uint8  u8Level    BTN_STATE_0/1      The new level, "1" is closed
+*              uint32 u32Tm      0~                 Time stamp of the edge
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or the queue is full
+*              SUCCESS          The edge is put
+* description: The edge is NOT processed here, so the ISR is short. The edge is
+*              written before the head is published (BTN_BARRIER()), so the
+*              main loop never reads a half written edge.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Edge_Put(uint8 u8Key, uint8 u8Contact, uint8 u8Level, uint32 u32Tm)
+{
+    T_BTN_VEL_EDGE *ptEdge;
+    uint16          u16Next;
+
+    /* Check if the input parameter is invalid */
+    if((0 == u8Key) || (u8Key > MAX_BTN_VEL_KEY) || (0 == u8Contact) || (u8Contact > 2))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    u16Next = (uint16)((sg_u16VelHead + 1) & (BTN_VEL_QUEUE_LEN - 1));
+    if(u16Next == sg_u16VelTail)
+    {   /* The queue is full */
+        sg_u32VelDrop++;
+        return BTN_ERROR;
+    }
+    ptEdge             = &(sg_atVelQueue[sg_u16VelHead]);
+    ptEdge->u32Tm      = u32Tm;
+    ptEdge->u16Contact = (uint16)((u8Key - 1) * 2 + u8Contact - 1);
+    ptEdge->u8Level    = u8Level;
+    BTN_BARRIER();                                 /* Write the edge before the head      */
+    sg_u16VelHead      = u16Next;                  /* Publish the edge after it is written */
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint16 Btn_Vel_Process(uint32 u32Now)
+* Function   : Process the edges in the queue
+* Input      : uint32 u32Now     Current time, for the end of lock times
+* Output:    : None
+* Return     : 0~               Number of processed edges
+* description: Call in main loop. The events are output by pfEvt. The edges put
+*              during the process are left to the next call.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Btn_Vel_Process(uint32 u32Now)
+{
+    const T_BTN_VEL_EDGE *ptEdge;
+    uint16 u16Tail = sg_u16VelTail;
+    uint16 u16Head;
+    uint16 u16Cnt  = 0;
+
+    if(NULL == sg_ptVelPara)
+    {   /* Not init */
+        return 0;
+    }
+
+    u16Head = sg_u16VelHead;
+    BTN_BARRIER();                                 /* Read the edges after the head       */
+    while(u16Tail != u16Head)
+    {
+        ptEdge = &(sg_atVelQueue[u16Tail]);
+        if(sg_u8VelPend)
+        {   /* Take the locked edges before this one */
+            Btn_Vel_Settle(ptEdge->u32Tm);
+        }
+        Btn_Vel_Contact(ptEdge->u16Contact, ptEdge->u8Level, ptEdge->u32Tm);
+        u16Tail       = (uint16)((u16Tail + 1) & (BTN_VEL_QUEUE_LEN - 1));
+        BTN_BARRIER();                             /* Read the edge before it is freed    */
+        sg_u16VelTail = u16Tail;                   /* Free the item */
+        u16Cnt++;
+    }
+    if(sg_u8VelPend)
+    {
+        Btn_Vel_Settle(u32Now);
+    }
+    return u16Cnt;
+}
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Block(const uint32 *pu32Sample, uint16 u16Num,
+*                                  uint32 u32StartTm)
+* Function   : Process a block of sampled contact levels
+* Input      : const uint32 *pu32Sample  Samples, BTN_VEL_WORDS words each
+*              uint16        u16Num      Number of samples
+*              uint32        u32StartTm  Time of the first sample, the time of
+*                                        sample i is (u32StartTm + i)
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The block is processed
+* description: Each sample is compared with the last one, so only the contacts
+*              that changed are processed. The events are output by pfEvt.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Block(const uint32 *pu32Sample, uint16 u16Num, uint32 u32StartTm)
+{
+    uint32 u32Diff, u32Tm;
+    uint16 u16Idx, u16Word;
+    uint8  u8Bit;
+
+    /* Check if the input parameter is invalid */
+    if((NULL == sg_ptVelPara) || ((NULL == pu32Sample) && (0 != u16Num)))
+    {   /* Return error */
+        return BTN_ERROR;
+    }
+
+    for(u16Idx = 0; u16Idx < u16Num; u16Idx++, pu32Sample += BTN_VEL_WORDS)
+    {
+        u32Tm = u32StartTm + u16Idx;
+        if(sg_u8VelPend)
+        {   /* Take the locked edges before this sample */
+            Btn_Vel_Settle(u32Tm);
+        }
+        for(u16Word = 0; u16Word < BTN_VEL_WORDS; u16Word++)
+        {   /* Only the changed contacts */
+            u32Diff = pu32Sample[u16Word] ^ sg_au32VelRaw[u16Word];
+            for(u8Bit = 0; u32Diff; u8Bit++, u32Diff >>= 1)
+            {
+                if(u32Diff & 1)
+                {
+                    Btn_Vel_Contact((uint16)((u16Word << 5) + u8Bit),
+                                    (uint8)((pu32Sample[u16Word] >> u8Bit) & 1), u32Tm);
+                }
+            }
+        }
+    }
+    return SUCCESS;
+}
+
+/******************************************************************************
+* Name       : uint32 Btn_Vel_Drop_Get(void)
+* Function   : Get the number of edges dropped by a full queue
+* Input      : None
+* Output:    : None
+* Return     : 0~               Number of dropped edges
+* description: If it is NOT 0, call Btn_Vel_Process() more often or enlarge
+*              BTN_VEL_QUEUE_LEN.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Vel_Drop_Get(void)
+{
+    return sg_u32VelDrop;
+}
+
+#endif
+
+/* end-of-file */
@@ -0,0 +1,207 @@
+/******************************************************************************
+* File       : Btn_SM_Velocity.h
+* Function   : Velocity sensing of dual-contact keys (musical keyboards).
+* description: Each key has two contacts: contact 1 closes at the start of the
+*              key travel and contact 2 at the end. The time between them gives
+*              the velocity of the key, which is mapped to 1~127 with a lookup
+*              curve. The keys output note-on and note-off events with velocity.
+*
+*              The edges of the contacts are time stamped by the caller, in any
+*              time unit (e.g. 1 unit = 100us), so the velocity is NOT quantized
+*              to the scan period of Btn_SM_Module.c. Two ways to feed edges:
+*                  * Btn_Vel_Edge_Put()   From the edge ISR into a queue, then
+*                                         Btn_Vel_Process() in main loop
+*                  * Btn_Vel_Block()      A block of sampled port words, one word
+*                                         set per sample (e.g. from DMA)
+*
+*              Contact C (1/2) of key K is bit ((K - 1) * 2 + C - 1) of the sample
+*              words, and the level "1" means closed.
+*
+*              Events of a key:
+*                  contact 1 closes            Key starts to move, start timing
+*                  contact 2 closes            BTN_VEL_NOTE_ON_EVT, velocity from
+*                                              the time since contact 1 closed
+*                  contact 1 opens (no note)   Key is back without a note
+*                  contact 2 opens             Key starts to release, start timing
+*                  contact 1 opens (note)      BTN_VEL_NOTE_OFF_EVT, velocity from
+*                                              the time since contact 2 opened
+*                  contact 2 closes again      BTN_VEL_NOTE_ON_EVT again (repeated
+*                  before contact 1 opens      note), velocity from the time since
+*                                              contact 2 opened
+*              If contact 1 is missed, contact 2 gives the fastest velocity.
+*
+*              Bounce of contacts: the first edge is taken at once and the next
+*              edges of the same contact within u32LockTm are ignored. If the level
+*              is different after the lock time, the edge is taken at the end of
+*              the lock time.
+*
+*              HOW TO USE:
+*              Step 1: Call "Btn_Vel_Init()" with the curve and the event function.
+*              Step 2: Call "Btn_Vel_Edge_Put()" in the edge ISR and
+*                      "Btn_Vel_Process()" in main loop, or call "Btn_Vel_Block()"
+*                      for each block of samples.
+*
+*              NOTE: The queue has one producer (ISR) and one consumer (main loop).
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+* History    :  No.  When          Who   Version   What
+*               1    18/Oct/2026   Ian   V1.00     Create
+******************************************************************************/
+
+#ifndef _BTN_SM_VELOCITY_
+#define _BTN_SM_VELOCITY_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __BTN_SM_VELOCITY
+
+#define BTN_VEL_NOTE_ON_EVT          (1)         /* Key is pressed with velocity      */
+#define BTN_VEL_NOTE_OFF_EVT         (2)         /* Key is released with velocity     */
+
+#define BTN_VEL_CONTACT_NUM          (MAX_BTN_VEL_KEY * 2)          /* Number of contacts      */
+#define BTN_VEL_WORDS                ((BTN_VEL_CONTACT_NUM + 31) / 32) /* Words of one sample  */
+
+/*******************************************************************************
+* Structure  : T_BTN_VEL_EVT
+* Description: Structure of one note event.
+* Memebers   : Type    Member    Range              Descrption
+*              uint32  u32Tm     0~                 Time of the edge that makes the event
+*              uint8   u8Key     1~MAX_BTN_VEL_KEY  The number of key
+*              uint8   u8Evt     BTN_VEL_NOTE_ON_EVT / BTN_VEL_NOTE_OFF_EVT
+*              uint8   u8Vel     1~127              Velocity
+*******************************************************************************/
+typedef struct _T_BTN_VEL_EVT_
+{
+    uint32      u32Tm;              /* Time of the event */
+    uint8       u8Key;              /* Key number        */
+    uint8       u8Evt;              /* Note event        */
+    uint8       u8Vel;              /* Velocity          */
+}T_BTN_VEL_EVT;
+
+/******************************************************************************
+* Name       : void (*PF_VEL_EVT)(const T_BTN_VEL_EVT *ptEvt)
+* Function   : Function type to output a note event
+* Input      : const T_BTN_VEL_EVT *ptEvt    The event
+* Output:    : None
+* Return     : None
+* description: Called from Btn_Vel_Process() or Btn_Vel_Block(), in time order
+*              of each key.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+typedef void (*PF_VEL_EVT)(const T_BTN_VEL_EVT *ptEvt);
+
+/*******************************************************************************
+* Structure  : T_BTN_VEL_PARA
+* Description: Structure of velocity sensing parameters.
+* Memebers   : Type          Member     Range    Descrption
+*              const uint32 *pu32Dt     0~       Times between contacts of the curve
+*                                                points, in ascending order
+*              const uint8  *pu8Vel     1~127    Velocity of each curve point
+*              uint8         u8Num      1~255    Number of curve points
+*              uint32        u32LockTm  0~       Lock time of contact bounce
+*              PF_VEL_EVT    pfEvt               Function to output note events
+*              The velocity between two points is linear, and it is the first or
+*              the last point out of the curve.
+*******************************************************************************/
+typedef struct _T_BTN_VEL_PARA_
+{
+    const uint32 *pu32Dt;           /* Times of the curve points      */
+    const uint8  *pu8Vel;           /* Velocities of the curve points */
+    uint8         u8Num;            /* Number of curve points         */
+    uint32        u32LockTm;        /* Lock time of contact bounce    */
+    PF_VEL_EVT    pfEvt;            /* Function to output events      */
+}T_BTN_VEL_PARA;
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Init(const T_BTN_VEL_PARA *ptPara)
+* Function   : Init velocity sensing
+* Input      : const T_BTN_VEL_PARA *ptPara   Parameters, must be kept by caller
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          Init operation is successed
+* description: All contacts are set open, all keys are released and the queue is
+*              cleared.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Init(const T_BTN_VEL_PARA *ptPara);
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Edge_Put(uint8 u8Key, uint8 u8Contact, uint8 u8Level,
+*                                     uint32 u32Tm)
+* Function   : Put one contact edge into the queue (from ISR)
+* Input      : uint8  u8Key      1~MAX_BTN_VEL_KEY  The number of key
+*              uint8  u8Contact  1~2                The number of contact
+*              uint8  u8Level    BTN_STATE_0/1      The new level, "1" is closed
+*              uint32 u32Tm      0~                 Time stamp of the edge
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid or the queue is full
+*              SUCCESS          The edge is put
+* description: The edge is NOT processed here, so the ISR is short.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Edge_Put(uint8 u8Key, uint8 u8Contact, uint8 u8Level, uint32 u32Tm);
+
+/******************************************************************************
+* Name       : uint16 Btn_Vel_Process(uint32 u32Now)
+* Function   : Process the edges in the queue
+* Input      : uint32 u32Now     Current time, for the end of lock times
+* Output:    : None
+* Return     : 0~               Number of processed edges
+* description: Call in main loop. The events are output by pfEvt.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint16 Btn_Vel_Process(uint32 u32Now);
+
+/******************************************************************************
+* Name       : uint8 Btn_Vel_Block(const uint32 *pu32Sample, uint16 u16Num,
+*                                  uint32 u32StartTm)
+* Function   : Process a block of sampled contact levels
+* Input      : const uint32 *pu32Sample  Samples, BTN_VEL_WORDS words each
+*              uint16        u16Num      Number of samples
+*              uint32        u32StartTm  Time of the first sample, the time of
+*                                        sample i is (u32StartTm + i)
+* Output:    : None
+* Return     : BTN_ERROR        Input parameter is invalid
+*              SUCCESS          The block is processed
+* description: Each sample is compared with the last one, so only the contacts
+*              that changed are processed. The events are output by pfEvt.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint8 Btn_Vel_Block(const uint32 *pu32Sample, uint16 u16Num, uint32 u32StartTm);
+
+/******************************************************************************
+* Name       : uint32 Btn_Vel_Drop_Get(void)
+* Function   : Get the number of edges dropped by a full queue
+* Input      : None
+* Output:    : None
+* Return     : 0~               Number of dropped edges
+* description: If it is NOT 0, call Btn_Vel_Process() more often or enlarge
+*              BTN_VEL_QUEUE_LEN.
+* Version    : V1.00
+* Author     : Ian
+* Date       : 18th Oct 2026
+******************************************************************************/
+uint32 Btn_Vel_Drop_Get(void);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _BTN_SM_VELOCITY_ */
+
+/* end-of-file */